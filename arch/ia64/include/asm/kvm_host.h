@@ -366,6 +366,8 @@ struct thash_cb {
 
 struct kvm_vcpu_stat {
 	u32 halt_wakeup;
+	u32 halt_successful_poll;
+	u32 halt_attempted_poll;
 };
 
 struct kvm_vcpu_arch {
@@ -107,6 +107,8 @@ struct kvm_vcpu_stat {
 	u32 dec_exits;
 	u32 ext_intr_exits;
 	u32 halt_wakeup;
+	u32 halt_successful_poll;
+	u32 halt_attempted_poll;
 	u32 dbell_exits;
 	u32 gdbell_exits;
 #ifdef CONFIG_PPC_BOOK3S
@@ -30,6 +30,8 @@
 #include <crypto/ctr.h>
 #include <asm/cpu_device_id.h>
 #include <asm/i387.h>
+#include <asm/xcr.h>
+#include <asm/xsave.h>
 #include <asm/crypto/aes.h>
 #include <asm/crypto/ablk_helper.h>
 #include <crypto/scatterwalk.h>
@@ -53,13 +55,18 @@
 #define HAS_XTS
 #endif
 
+#define GCM_HASH_KEYS_SIZE	(16 * 16)
+
 /* This data is stored at the end of the crypto_tfm struct.
  * It's a type of per "session" data storage location.
  * This needs to be 16 byte aligned.
+ * hash_keys holds the hash key powers used by the AVX code, and
+ * nonce is only used by rfc4106.
  */
 struct aesni_rfc4106_gcm_ctx {
 	u8 hash_subkey[16];
 	struct crypto_aes_ctx aes_key_expanded;
+	u8 hash_keys[GCM_HASH_KEYS_SIZE];
 	u8 nonce[4];
 	struct cryptd_aead *cryptd_tfm;
 };
@@ -143,6 +150,70 @@ asmlinkage void aesni_gcm_dec(void *ctx, u8 *out,
 			u8 *hash_subkey, const u8 *aad, unsigned long aad_len,
 			u8 *auth_tag, unsigned long auth_tag_len);
 
+/*
+ * The AVX GCM code in aesni-intel_avx-x86_64.S works on whole blocks
+ * and keeps the running hash and counter block in memory, so that
+ * the data can be fed to it one scatterlist chunk at a time.
+ */
+struct aesni_gcm_avx_ops {
+	void (*precomp)(u8 *hash_keys, const u8 *hash_subkey);
+	void (*ghash)(const u8 *hash_keys, u8 *hash, const u8 *in,
+		      unsigned long blocks);
+	void (*enc)(const struct crypto_aes_ctx *ctx, const u8 *hash_keys,
+		    u8 *hash, u8 *ctr, u8 *out, const u8 *in,
+		    unsigned long blocks);
+	void (*dec)(const struct crypto_aes_ctx *ctx, const u8 *hash_keys,
+		    u8 *hash, u8 *ctr, u8 *out, const u8 *in,
+		    unsigned long blocks);
+};
+
+/* set at init time if AVX is usable, the SSE code is used otherwise */
+static const struct aesni_gcm_avx_ops *aesni_gcm_avx;
+
+#ifdef CONFIG_AS_AVX
+asmlinkage void aesni_gcm_precomp_avx_gen2(u8 *hash_keys,
+					   const u8 *hash_subkey);
+asmlinkage void aesni_gcm_ghash_avx_gen2(const u8 *hash_keys, u8 *hash,
+					 const u8 *in, unsigned long blocks);
+asmlinkage void aesni_gcm_enc_avx_gen2(const struct crypto_aes_ctx *ctx,
+				       const u8 *hash_keys, u8 *hash, u8 *ctr,
+				       u8 *out, const u8 *in,
+				       unsigned long blocks);
+asmlinkage void aesni_gcm_dec_avx_gen2(const struct crypto_aes_ctx *ctx,
+				       const u8 *hash_keys, u8 *hash, u8 *ctr,
+				       u8 *out, const u8 *in,
+				       unsigned long blocks);
+
+asmlinkage void aesni_gcm_precomp_avx_gen4(u8 *hash_keys,
+					   const u8 *hash_subkey);
+asmlinkage void aesni_gcm_ghash_avx_gen4(const u8 *hash_keys, u8 *hash,
+					 const u8 *in, unsigned long blocks);
+asmlinkage void aesni_gcm_enc_avx_gen4(const struct crypto_aes_ctx *ctx,
+				       const u8 *hash_keys, u8 *hash, u8 *ctr,
+				       u8 *out, const u8 *in,
+				       unsigned long blocks);
+asmlinkage void aesni_gcm_dec_avx_gen4(const struct crypto_aes_ctx *ctx,
+				       const u8 *hash_keys, u8 *hash, u8 *ctr,
+				       u8 *out, const u8 *in,
+				       unsigned long blocks);
+
+/* Sandy Bridge and Ivy Bridge, where PCLMULQDQ is slow */
+static const struct aesni_gcm_avx_ops aesni_gcm_avx_gen2 = {
+	.precomp	= aesni_gcm_precomp_avx_gen2,
+	.ghash		= aesni_gcm_ghash_avx_gen2,
+	.enc		= aesni_gcm_enc_avx_gen2,
+	.dec		= aesni_gcm_dec_avx_gen2,
+};
+
+/* Haswell onwards */
+static const struct aesni_gcm_avx_ops aesni_gcm_avx_gen4 = {
+	.precomp	= aesni_gcm_precomp_avx_gen4,
+	.ghash		= aesni_gcm_ghash_avx_gen4,
+	.enc		= aesni_gcm_enc_avx_gen4,
+	.dec		= aesni_gcm_dec_avx_gen4,
+};
+#endif
+
 static inline struct
 aesni_rfc4106_gcm_ctx *aesni_rfc4106_gcm_ctx_get(struct crypto_aead *tfm)
 {
@@ -420,14 +491,14 @@ static int ablk_xts_init(struct crypto_tfm *tfm)
 #endif
 
 #ifdef CONFIG_X86_64
-static int rfc4106_init(struct crypto_tfm *tfm)
+static int gcmaes_wrapper_init(struct crypto_tfm *tfm, const char *drv_name)
 {
 	struct cryptd_aead *cryptd_tfm;
 	struct aesni_rfc4106_gcm_ctx *ctx = (struct aesni_rfc4106_gcm_ctx *)
 		PTR_ALIGN((u8 *)crypto_tfm_ctx(tfm), AESNI_ALIGN);
 	struct crypto_aead *cryptd_child;
 	struct aesni_rfc4106_gcm_ctx *child_ctx;
-	cryptd_tfm = cryptd_alloc_aead("__driver-gcm-aes-aesni", 0, 0);
+	cryptd_tfm = cryptd_alloc_aead(drv_name, 0, 0);
 	if (IS_ERR(cryptd_tfm))
 		return PTR_ERR(cryptd_tfm);
 
@@ -440,7 +511,12 @@ static int rfc4106_init(struct crypto_tfm *tfm)
 	return 0;
 }
 
-static void rfc4106_exit(struct crypto_tfm *tfm)
+static int rfc4106_init(struct crypto_tfm *tfm)
+{
+	return gcmaes_wrapper_init(tfm, "__driver-gcm-aes-aesni");
+}
+
+static void gcmaes_wrapper_exit(struct crypto_tfm *tfm)
 {
 	struct aesni_rfc4106_gcm_ctx *ctx =
 		(struct aesni_rfc4106_gcm_ctx *)
@@ -537,7 +613,10 @@ static int rfc4106_set_key(struct crypto_aead *parent, const u8 *key,
 	}
 	/*Account for 4 byte nonce at the end.*/
 	key_len -= 4;
-	if (key_len != AES_KEYSIZE_128) {
+	/* the SSE code only handles 128-bit keys, the AVX code all three */
+	if (key_len != AES_KEYSIZE_128 &&
+	    (!aesni_gcm_avx || (key_len != AES_KEYSIZE_192 &&
+				key_len != AES_KEYSIZE_256))) {
 		crypto_tfm_set_flags(tfm, CRYPTO_TFM_RES_BAD_KEY_LEN);
 		return -EINVAL;
 	}
@@ -572,6 +651,11 @@ static int rfc4106_set_key(struct crypto_aead *parent, const u8 *key,
 		goto exit;
 	}
 	ret = rfc4106_set_hash_subkey(ctx->hash_subkey, key, key_len);
+	if (!ret && aesni_gcm_avx) {
+		kernel_fpu_begin();
+		aesni_gcm_avx->precomp(ctx->hash_keys, ctx->hash_subkey);
+		kernel_fpu_end();
+	}
 	memcpy(child_ctx, ctx, sizeof(*ctx));
 exit:
 	kfree(new_key_mem);
@@ -599,7 +683,7 @@ static int rfc4106_set_authsize(struct crypto_aead *parent,
 	return 0;
 }
 
-static int rfc4106_encrypt(struct aead_request *req)
+static int gcmaes_wrapper_encrypt(struct aead_request *req)
 {
 	int ret;
 	struct crypto_aead *tfm = crypto_aead_reqtfm(req);
@@ -620,7 +704,7 @@ static int rfc4106_encrypt(struct aead_request *req)
 	}
 }
 
-static int rfc4106_decrypt(struct aead_request *req)
+static int gcmaes_wrapper_decrypt(struct aead_request *req)
 {
 	int ret;
 	struct crypto_aead *tfm = crypto_aead_reqtfm(req);
@@ -641,6 +725,166 @@ static int rfc4106_decrypt(struct aead_request *req)
 	}
 }
 
+/* Hash @len bytes of @sg, zero padded to a whole number of blocks. */
+static void gcmaes_hash_sg(struct aesni_rfc4106_gcm_ctx *ctx, u8 *hash,
+			   struct scatterlist *sg, unsigned int len)
+{
+	struct scatter_walk walk;
+	u8 buf[AES_BLOCK_SIZE];
+	unsigned int fill = 0;
+
+	if (!len)
+		return;
+
+	scatterwalk_start(&walk, sg);
+	while (len) {
+		unsigned int n = scatterwalk_clamp(&walk, len);
+		u8 *p = scatterwalk_map(&walk);
+		u8 *data = p;
+		unsigned int rem = n;
+
+		/* complete a block started in the previous chunk */
+		if (fill) {
+			unsigned int take = min(rem, AES_BLOCK_SIZE - fill);
+
+			memcpy(buf + fill, data, take);
+			fill += take;
+			data += take;
+			rem -= take;
+			if (fill == AES_BLOCK_SIZE) {
+				aesni_gcm_avx->ghash(ctx->hash_keys, hash, buf, 1);
+				fill = 0;
+			}
+		}
+		if (rem >= AES_BLOCK_SIZE) {
+			aesni_gcm_avx->ghash(ctx->hash_keys, hash, data,
+					     rem / AES_BLOCK_SIZE);
+			data += rem & AES_BLOCK_MASK;
+			rem &= AES_BLOCK_SIZE - 1;
+		}
+		if (rem) {
+			memcpy(buf, data, rem);
+			fill = rem;
+		}
+
+		scatterwalk_unmap(p);
+		scatterwalk_advance(&walk, n);
+		len -= n;
+		scatterwalk_done(&walk, 0, len);
+	}
+
+	if (fill) {
+		memset(buf + fill, 0, AES_BLOCK_SIZE - fill);
+		aesni_gcm_avx->ghash(ctx->hash_keys, hash, buf, 1);
+	}
+}
+
+/*
+ * GCM straight on the scatterlists with the AVX code, for both rfc4106
+ * and plain gcm(aes): whole blocks are encrypted and hashed in place in
+ * the mapped pages, so the data is neither linearised nor walked twice.
+ * Only a block straddling two pages or sg entries, and the final partial
+ * block, go through a bounce buffer.  @j0 is the pre-counter block.
+ * Must be called between kernel_fpu_begin() and kernel_fpu_end().
+ */
+static int gcmaes_crypt_by_sg(bool enc, struct aead_request *req,
+			      const u8 *j0)
+{
+	struct crypto_aead *tfm = crypto_aead_reqtfm(req);
+	struct aesni_rfc4106_gcm_ctx *ctx = aesni_rfc4106_gcm_ctx_get(tfm);
+	struct crypto_aes_ctx *aes_ctx = &ctx->aes_key_expanded;
+	unsigned long auth_tag_len = crypto_aead_authsize(tfm);
+	void (*crypt)(const struct crypto_aes_ctx *ctx, const u8 *hash_keys,
+		      u8 *hash, u8 *ctr, u8 *out, const u8 *in,
+		      unsigned long blocks);
+	unsigned int datalen = req->cryptlen, len;
+	struct scatter_walk src_walk, dst_walk;
+	u8 hash[AES_BLOCK_SIZE], ctr[AES_BLOCK_SIZE];
+	u8 buf[AES_BLOCK_SIZE], tag[AES_BLOCK_SIZE];
+	__be64 *lengths = (__be64 *)buf;
+
+	if (!enc) {
+		if (datalen < auth_tag_len)
+			return -EINVAL;
+		datalen -= auth_tag_len;
+	}
+	crypt = enc ? aesni_gcm_avx->enc : aesni_gcm_avx->dec;
+
+	memset(hash, 0, sizeof(hash));
+	memcpy(ctr, j0, sizeof(ctr));
+
+	gcmaes_hash_sg(ctx, hash, req->assoc, req->assoclen);
+
+	len = datalen;
+	if (len) {
+		scatterwalk_start(&src_walk, req->src);
+		scatterwalk_start(&dst_walk, req->dst);
+	}
+
+	while (len >= AES_BLOCK_SIZE) {
+		unsigned int n = min(scatterwalk_clamp(&src_walk, len),
+				     scatterwalk_clamp(&dst_walk, len));
+
+		n &= AES_BLOCK_MASK;
+		if (n) {
+			u8 *src = scatterwalk_map(&src_walk);
+			u8 *dst = scatterwalk_map(&dst_walk);
+
+			crypt(aes_ctx, ctx->hash_keys, hash, ctr, dst, src,
+			      n / AES_BLOCK_SIZE);
+
+			scatterwalk_unmap(dst);
+			scatterwalk_unmap(src);
+			scatterwalk_advance(&src_walk, n);
+			scatterwalk_advance(&dst_walk, n);
+		} else {
+			n = AES_BLOCK_SIZE;
+			scatterwalk_copychunks(buf, &src_walk, n, 0);
+			crypt(aes_ctx, ctx->hash_keys, hash, ctr, buf, buf, 1);
+			scatterwalk_copychunks(buf, &dst_walk, n, 1);
+		}
+		len -= n;
+		scatterwalk_done(&src_walk, 0, len);
+		scatterwalk_done(&dst_walk, 1, len);
+	}
+
+	if (len) {
+		u8 keystream[AES_BLOCK_SIZE];
+
+		crypto_inc(ctr + 12, 4);
+		aesni_enc(aes_ctx, keystream, ctr);
+
+		memset(buf, 0, sizeof(buf));
+		scatterwalk_copychunks(buf, &src_walk, len, 0);
+		if (!enc)
+			aesni_gcm_avx->ghash(ctx->hash_keys, hash, buf, 1);
+		crypto_xor(buf, keystream, len);
+		if (enc) {
+			memset(buf + len, 0, AES_BLOCK_SIZE - len);
+			aesni_gcm_avx->ghash(ctx->hash_keys, hash, buf, 1);
+		}
+		scatterwalk_copychunks(buf, &dst_walk, len, 1);
+		scatterwalk_done(&src_walk, 0, 0);
+		scatterwalk_done(&dst_walk, 1, 0);
+	}
+
+	lengths[0] = cpu_to_be64((u64)req->assoclen * 8);
+	lengths[1] = cpu_to_be64((u64)datalen * 8);
+	aesni_gcm_avx->ghash(ctx->hash_keys, hash, buf, 1);
+
+	aesni_enc(aes_ctx, tag, j0);
+	crypto_xor(tag, hash, AES_BLOCK_SIZE);
+
+	if (enc) {
+		scatterwalk_map_and_copy(tag, req->dst, datalen,
+					 auth_tag_len, 1);
+		return 0;
+	}
+
+	scatterwalk_map_and_copy(buf, req->src, datalen, auth_tag_len, 0);
+	return memcmp(buf, tag, auth_tag_len) ? -EBADMSG : 0;
+}
+
 static int __driver_rfc4106_encrypt(struct aead_request *req)
 {
 	u8 one_entry_in_sg = 0;
@@ -669,6 +913,9 @@ static int __driver_rfc4106_encrypt(struct aead_request *req)
 		*(iv+4+i) = req->iv[i];
 	*((__be32 *)(iv+12)) = counter;
 
+	if (aesni_gcm_avx)
+		return gcmaes_crypt_by_sg(true, req, iv);
+
 	if ((sg_is_last(req->src)) && (sg_is_last(req->assoc))) {
 		one_entry_in_sg = 1;
 		scatterwalk_start(&src_sg_walk, req->src);
@@ -751,6 +998,9 @@ static int __driver_rfc4106_decrypt(struct aead_request *req)
 		*(iv+4+i) = req->iv[i];
 	*((__be32 *)(iv+12)) = counter;
 
+	if (aesni_gcm_avx)
+		return gcmaes_crypt_by_sg(false, req, iv);
+
 	if ((sg_is_last(req->src)) && (sg_is_last(req->assoc))) {
 		one_entry_in_sg = 1;
 		scatterwalk_start(&src_sg_walk, req->src);
@@ -798,6 +1048,82 @@ static int __driver_rfc4106_decrypt(struct aead_request *req)
 	}
 	return retval;
 }
+
+static int generic_gcmaes_init(struct crypto_tfm *tfm)
+{
+	return gcmaes_wrapper_init(tfm, "__driver-generic-gcm-aes-aesni");
+}
+
+static int generic_gcmaes_set_key(struct crypto_aead *parent, const u8 *key,
+				  unsigned int key_len)
+{
+	struct aesni_rfc4106_gcm_ctx *ctx = aesni_rfc4106_gcm_ctx_get(parent);
+	struct crypto_aead *cryptd_child = cryptd_aead_child(ctx->cryptd_tfm);
+	struct aesni_rfc4106_gcm_ctx *child_ctx =
+				aesni_rfc4106_gcm_ctx_get(cryptd_child);
+	int ret;
+
+	ret = aes_set_key_common(crypto_aead_tfm(parent),
+				 &ctx->aes_key_expanded, key, key_len);
+	if (ret)
+		return ret;
+
+	memset(ctx->hash_subkey, 0, sizeof(ctx->hash_subkey));
+	kernel_fpu_begin();
+	aesni_enc(&ctx->aes_key_expanded, ctx->hash_subkey, ctx->hash_subkey);
+	aesni_gcm_avx->precomp(ctx->hash_keys, ctx->hash_subkey);
+	kernel_fpu_end();
+
+	memcpy(child_ctx, ctx, sizeof(*ctx));
+	return 0;
+}
+
+/* The tag lengths allowed by crypto/gcm.c */
+static int generic_gcmaes_set_authsize(struct crypto_aead *parent,
+				       unsigned int authsize)
+{
+	struct aesni_rfc4106_gcm_ctx *ctx = aesni_rfc4106_gcm_ctx_get(parent);
+	struct crypto_aead *cryptd_child = cryptd_aead_child(ctx->cryptd_tfm);
+
+	switch (authsize) {
+	case 4:
+	case 8:
+	case 12:
+	case 13:
+	case 14:
+	case 15:
+	case 16:
+		break;
+	default:
+		return -EINVAL;
+	}
+	crypto_aead_crt(parent)->authsize = authsize;
+	crypto_aead_crt(cryptd_child)->authsize = authsize;
+	return 0;
+}
+
+/* As in crypto/gcm.c, the IV is 16 bytes of which the first 12 are used. */
+static void generic_gcmaes_j0(u8 *j0, const u8 *iv)
+{
+	memcpy(j0, iv, 12);
+	*(__be32 *)(j0 + 12) = cpu_to_be32(1);
+}
+
+static int __driver_generic_gcmaes_encrypt(struct aead_request *req)
+{
+	u8 j0[AES_BLOCK_SIZE];
+
+	generic_gcmaes_j0(j0, req->iv);
+	return gcmaes_crypt_by_sg(true, req, j0);
+}
+
+static int __driver_generic_gcmaes_decrypt(struct aead_request *req)
+{
+	u8 j0[AES_BLOCK_SIZE];
+
+	generic_gcmaes_j0(j0, req->iv);
+	return gcmaes_crypt_by_sg(false, req, j0);
+}
 #endif
 
 static struct crypto_alg aesni_algs[] = { {
@@ -995,13 +1321,13 @@ static struct crypto_alg aesni_algs[] = { {
 	.cra_type		= &crypto_nivaead_type,
 	.cra_module		= THIS_MODULE,
 	.cra_init		= rfc4106_init,
-	.cra_exit		= rfc4106_exit,
+	.cra_exit		= gcmaes_wrapper_exit,
 	.cra_u = {
 		.aead = {
 			.setkey		= rfc4106_set_key,
 			.setauthsize	= rfc4106_set_authsize,
-			.encrypt	= rfc4106_encrypt,
-			.decrypt	= rfc4106_decrypt,
+			.encrypt	= gcmaes_wrapper_encrypt,
+			.decrypt	= gcmaes_wrapper_decrypt,
 			.geniv		= "seqiv",
 			.ivsize		= 8,
 			.maxauthsize	= 16,
@@ -1109,6 +1435,50 @@ static struct crypto_alg aesni_algs[] = { {
 #endif
 } };
 
+#ifdef CONFIG_X86_64
+/* Only registered when the AVX GCM code is usable, see aesni_init() */
+static struct crypto_alg aesni_gcm_avx_algs[] = { {
+	.cra_name		= "__generic-gcm-aes-aesni",
+	.cra_driver_name	= "__driver-generic-gcm-aes-aesni",
+	.cra_priority		= 0,
+	.cra_flags		= CRYPTO_ALG_TYPE_AEAD,
+	.cra_blocksize		= 1,
+	.cra_ctxsize		= sizeof(struct aesni_rfc4106_gcm_ctx) +
+				  AESNI_ALIGN,
+	.cra_alignmask		= 0,
+	.cra_type		= &crypto_aead_type,
+	.cra_module		= THIS_MODULE,
+	.cra_u = {
+		.aead = {
+			.encrypt	= __driver_generic_gcmaes_encrypt,
+			.decrypt	= __driver_generic_gcmaes_decrypt,
+		},
+	},
+}, {
+	.cra_name		= "gcm(aes)",
+	.cra_driver_name	= "generic-gcm-aesni",
+	.cra_priority		= 400,
+	.cra_flags		= CRYPTO_ALG_TYPE_AEAD | CRYPTO_ALG_ASYNC,
+	.cra_blocksize		= 1,
+	.cra_ctxsize		= sizeof(struct aesni_rfc4106_gcm_ctx) +
+				  AESNI_ALIGN,
+	.cra_alignmask		= 0,
+	.cra_type		= &crypto_aead_type,
+	.cra_module		= THIS_MODULE,
+	.cra_init		= generic_gcmaes_init,
+	.cra_exit		= gcmaes_wrapper_exit,
+	.cra_u = {
+		.aead = {
+			.setkey		= generic_gcmaes_set_key,
+			.setauthsize	= generic_gcmaes_set_authsize,
+			.encrypt	= gcmaes_wrapper_encrypt,
+			.decrypt	= gcmaes_wrapper_decrypt,
+			.ivsize		= 16,
+			.maxauthsize	= 16,
+		},
+	},
+} };
+#endif
 
 static const struct x86_cpu_id aesni_cpu_id[] = {
 	X86_FEATURE_MATCH(X86_FEATURE_AES),
@@ -1116,6 +1486,42 @@ static const struct x86_cpu_id aesni_cpu_id[] = {
 };
 MODULE_DEVICE_TABLE(x86cpu, aesni_cpu_id);
 
+#if defined(CONFIG_X86_64) && defined(CONFIG_AS_AVX)
+static bool __init avx_usable(void)
+{
+	u64 xcr0;
+
+	if (!cpu_has_avx || !cpu_has_osxsave || !cpu_has_pclmulqdq)
+		return false;
+
+	xcr0 = xgetbv(XCR_XFEATURE_ENABLED_MASK);
+	if ((xcr0 & (XSTATE_SSE | XSTATE_YMM)) != (XSTATE_SSE | XSTATE_YMM)) {
+		pr_info("AVX detected but unusable.\n");
+
+		return false;
+	}
+
+	return true;
+}
+
+static void __init aesni_gcm_avx_init(void)
+{
+	if (!avx_usable())
+		return;
+
+	/* AVX2 stands for a Haswell or later, with a fast PCLMULQDQ */
+	if (cpu_has_avx2) {
+		aesni_gcm_avx = &aesni_gcm_avx_gen4;
+		pr_info("AES-GCM using AVX gen4 optimization\n");
+	} else {
+		aesni_gcm_avx = &aesni_gcm_avx_gen2;
+		pr_info("AES-GCM using AVX gen2 optimization\n");
+	}
+}
+#else
+static inline void aesni_gcm_avx_init(void) { }
+#endif
+
 static int __init aesni_init(void)
 {
 	int err, i;
@@ -1127,14 +1533,42 @@ static int __init aesni_init(void)
 	if (err)
 		return err;
 
+	aesni_gcm_avx_init();
+
 	for (i = 0; i < ARRAY_SIZE(aesni_algs); i++)
 		INIT_LIST_HEAD(&aesni_algs[i].cra_list);
 
-	return crypto_register_algs(aesni_algs, ARRAY_SIZE(aesni_algs));
+	err = crypto_register_algs(aesni_algs, ARRAY_SIZE(aesni_algs));
+	if (err)
+		goto fpu_exit;
+
+#ifdef CONFIG_X86_64
+	if (aesni_gcm_avx) {
+		err = crypto_register_algs(aesni_gcm_avx_algs,
+					   ARRAY_SIZE(aesni_gcm_avx_algs));
+		if (err)
+			goto unregister_algs;
+	}
+#endif
+
+	return 0;
+
+#ifdef CONFIG_X86_64
+unregister_algs:
+	crypto_unregister_algs(aesni_algs, ARRAY_SIZE(aesni_algs));
+#endif
+fpu_exit:
+	crypto_fpu_exit();
+	return err;
 }
 
 static void __exit aesni_exit(void)
 {
+#ifdef CONFIG_X86_64
+	if (aesni_gcm_avx)
+		crypto_unregister_algs(aesni_gcm_avx_algs,
+				       ARRAY_SIZE(aesni_gcm_avx_algs));
+#endif
 	crypto_unregister_algs(aesni_algs, ARRAY_SIZE(aesni_algs));
 
 	crypto_fpu_exit();
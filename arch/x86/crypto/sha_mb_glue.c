@@ -0,0 +1,543 @@
+/*
+ * Cryptographic API.
+ *
+ * Glue code for the multi-buffer SHA1 and SHA256 implementations using
+ * AVX2.  Independent requests queued through mcryptd are spread over
+ * the eight lanes of sha1_x8_avx2() / sha256_x8_avx2(), which hash one
+ * run of whole blocks per lane at a time.  The lane manager below is
+ * shared by both: each request is a small state machine producing such
+ * runs from its scatterlist, its partial block buffer and finally its
+ * padding, so lanes can be refilled independently as runs complete.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ */
+
+#define pr_fmt(fmt)	KBUILD_MODNAME ": " fmt
+
+#include <crypto/internal/hash.h>
+#include <crypto/mcryptd.h>
+#include <crypto/sha.h>
+#include <linux/bitops.h>
+#include <linux/init.h>
+#include <linux/module.h>
+#include <linux/types.h>
+#include <asm/i387.h>
+#include <asm/unaligned.h>
+#include <asm/xcr.h>
+#include <asm/xsave.h>
+
+#define SHA_MB_LANES		8
+#define SHA_MB_ALL_FREE		((1UL << SHA_MB_LANES) - 1)
+#define SHA_MB_BLOCK_SIZE	64
+#define SHA_MB_MAX_WORDS	(SHA256_DIGEST_SIZE / 4)
+
+/* requests queued per CPU before -EBUSY */
+#define SHA_MB_MAX_CPU_QLEN	256
+
+/*
+ * Argument block of the x8 transforms: the digests are stored
+ * transposed, one row per state word with one column per lane.
+ */
+struct sha_mb_args {
+	u32 digest[SHA_MB_MAX_WORDS][SHA_MB_LANES];
+	const u8 *data[SHA_MB_LANES];
+};
+
+#ifdef CONFIG_AS_AVX2
+asmlinkage void sha1_x8_avx2(struct sha_mb_args *args, u64 blocks);
+asmlinkage void sha256_x8_avx2(struct sha_mb_args *args, u64 blocks);
+#else
+/* the assembler can't build the transforms, avx2_usable() says no */
+#define sha1_x8_avx2	NULL
+#define sha256_x8_avx2	NULL
+#endif
+
+struct sha_mb_alg {
+	struct mcryptd_queue queue;
+	const struct mcryptd_ops *ops;
+	void (*transform)(struct sha_mb_args *args, u64 blocks);
+	unsigned int words;
+	const u32 *iv;
+	struct ahash_alg ahash;
+};
+
+struct sha_mb_mgr {
+	struct sha_mb_args args;
+	struct ahash_request *lane[SHA_MB_LANES];
+	u64 blocks[SHA_MB_LANES];	/* left in the current run */
+	unsigned long free;		/* bitmap of unused lanes */
+	struct sha_mb_alg *alg;
+};
+
+/* the exported state */
+struct sha_mb_state {
+	u32 state[SHA_MB_MAX_WORDS];
+	u64 count;
+	u8 buf[SHA_MB_BLOCK_SIZE];
+};
+
+enum {
+	SHA_MB_UPDATE,
+	SHA_MB_FINAL,
+	SHA_MB_FINUP,
+};
+
+struct sha_mb_req_ctx {
+	struct sha_mb_state s;
+	unsigned int op;
+	bool walking;
+	bool padded;
+	struct crypto_hash_walk walk;
+	const u8 *data;			/* what is left of the walk entry */
+	unsigned int len;
+	u8 pad[2 * SHA_MB_BLOCK_SIZE];
+};
+
+static inline struct sha_mb_alg *sha_mb_alg(struct crypto_ahash *tfm)
+{
+	return container_of(__crypto_ahash_alg(crypto_ahash_tfm(tfm)->__crt_alg),
+			    struct sha_mb_alg, ahash);
+}
+
+/*
+ * Produce the next run of whole blocks for @req, at *@data.  Returns
+ * the number of blocks, or zero once the request is finished, in which
+ * case the digest has been written out if it was a final operation.
+ * The previous run must have been hashed into @req's state by then, as
+ * it may live in the walk entry or buffer being replaced.
+ */
+static unsigned int sha_mb_next_job(struct ahash_request *req,
+				    const u8 **data)
+{
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+	struct sha_mb_state *s = &rctx->s;
+	unsigned int partial, padlen, n, i;
+
+	while (rctx->walking) {
+		partial = s->count % SHA_MB_BLOCK_SIZE;
+
+		if (!rctx->len) {
+			n = crypto_hash_walk_done(&rctx->walk, 0);
+			if (!n) {
+				rctx->walking = false;
+				break;
+			}
+			rctx->data = rctx->walk.data;
+			rctx->len = n;
+			continue;
+		}
+
+		if (partial || rctx->len < SHA_MB_BLOCK_SIZE) {
+			n = min(rctx->len, SHA_MB_BLOCK_SIZE - partial);
+			memcpy(s->buf + partial, rctx->data, n);
+			s->count += n;
+			rctx->data += n;
+			rctx->len -= n;
+			if (partial + n < SHA_MB_BLOCK_SIZE)
+				continue;
+			*data = s->buf;
+			return 1;
+		}
+
+		n = rctx->len / SHA_MB_BLOCK_SIZE;
+		*data = rctx->data;
+		rctx->data += n * SHA_MB_BLOCK_SIZE;
+		rctx->len -= n * SHA_MB_BLOCK_SIZE;
+		s->count += n * SHA_MB_BLOCK_SIZE;
+		return n;
+	}
+
+	if (rctx->op == SHA_MB_UPDATE)
+		return 0;
+
+	if (!rctx->padded) {
+		/* Pad out to 56 mod 64 and append the length in bits */
+		partial = s->count % SHA_MB_BLOCK_SIZE;
+		padlen = partial < 56 ? SHA_MB_BLOCK_SIZE :
+					2 * SHA_MB_BLOCK_SIZE;
+
+		memcpy(rctx->pad, s->buf, partial);
+		rctx->pad[partial] = 0x80;
+		memset(rctx->pad + partial + 1, 0, padlen - partial - 9);
+		put_unaligned_be64(s->count << 3, rctx->pad + padlen - 8);
+		rctx->padded = true;
+
+		*data = rctx->pad;
+		return padlen / SHA_MB_BLOCK_SIZE;
+	}
+
+	for (i = 0; i < crypto_ahash_digestsize(crypto_ahash_reqtfm(req)) / 4;
+	     i++)
+		put_unaligned_be32(s->state[i], req->result + 4 * i);
+
+	/* Wipe context */
+	memset(s, 0, sizeof(*s));
+	memset(rctx->pad, 0, sizeof(rctx->pad));
+
+	return 0;
+}
+
+/*
+ * Hash as many blocks as the shortest run in the lanes, then refill or
+ * release the lanes whose run is complete.
+ */
+static void sha_mb_run(struct sha_mb_mgr *mgr, struct list_head *done)
+{
+	unsigned long busy = ~mgr->free & SHA_MB_ALL_FREE;
+	unsigned int lane, i, min_lane = 0, words = mgr->alg->words;
+	struct ahash_request *req;
+	struct sha_mb_req_ctx *rctx;
+	u64 min = U64_MAX, blocks;
+	const u8 *data;
+
+	for_each_set_bit(lane, &busy, SHA_MB_LANES) {
+		if (mgr->blocks[lane] < min) {
+			min = mgr->blocks[lane];
+			min_lane = lane;
+		}
+	}
+
+	/* unused lanes hash the shortest run along, into a digest nobody reads */
+	for_each_set_bit(lane, &mgr->free, SHA_MB_LANES)
+		mgr->args.data[lane] = mgr->args.data[min_lane];
+
+	kernel_fpu_begin();
+	mgr->alg->transform(&mgr->args, min);
+	kernel_fpu_end();
+
+	for_each_set_bit(lane, &busy, SHA_MB_LANES) {
+		mgr->blocks[lane] -= min;
+		if (mgr->blocks[lane])
+			continue;
+
+		req = mgr->lane[lane];
+		rctx = ahash_request_ctx(req);
+		for (i = 0; i < words; i++)
+			rctx->s.state[i] = mgr->args.digest[i][lane];
+
+		blocks = sha_mb_next_job(req, &data);
+		if (blocks) {
+			mgr->args.data[lane] = data;
+			mgr->blocks[lane] = blocks;
+			continue;
+		}
+
+		mgr->lane[lane] = NULL;
+		mgr->free |= 1UL << lane;
+		list_add_tail(&req->base.list, done);
+	}
+}
+
+static bool sha_mb_submit(void *mgr_ptr, struct crypto_async_request *areq,
+			  struct list_head *done)
+{
+	struct sha_mb_mgr *mgr = mgr_ptr;
+	struct ahash_request *req = ahash_request_cast(areq);
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+	unsigned int lane, i, n;
+	const u8 *data;
+	u64 blocks;
+
+	rctx->walking = false;
+	rctx->padded = false;
+	if (rctx->op != SHA_MB_FINAL) {
+		n = crypto_ahash_walk_first(req, &rctx->walk);
+		if (n) {
+			rctx->walking = true;
+			rctx->data = rctx->walk.data;
+			rctx->len = n;
+		}
+	}
+
+	blocks = sha_mb_next_job(req, &data);
+	if (!blocks) {
+		list_add_tail(&areq->list, done);
+		return mgr->free != SHA_MB_ALL_FREE;
+	}
+
+	lane = __ffs(mgr->free);
+	mgr->free &= ~(1UL << lane);
+	for (i = 0; i < mgr->alg->words; i++)
+		mgr->args.digest[i][lane] = rctx->s.state[i];
+	mgr->args.data[lane] = data;
+	mgr->blocks[lane] = blocks;
+	mgr->lane[lane] = req;
+
+	while (!mgr->free)
+		sha_mb_run(mgr, done);
+
+	return mgr->free != SHA_MB_ALL_FREE;
+}
+
+static bool sha_mb_flush(void *mgr_ptr, struct list_head *done)
+{
+	struct sha_mb_mgr *mgr = mgr_ptr;
+
+	if (mgr->free == SHA_MB_ALL_FREE)
+		return false;
+
+	sha_mb_run(mgr, done);
+
+	return mgr->free != SHA_MB_ALL_FREE;
+}
+
+static int sha_mb_init(struct ahash_request *req)
+{
+	struct sha_mb_alg *alg = sha_mb_alg(crypto_ahash_reqtfm(req));
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+
+	memcpy(rctx->s.state, alg->iv, alg->words * sizeof(u32));
+	rctx->s.count = 0;
+
+	return 0;
+}
+
+static int sha_mb_enqueue(struct ahash_request *req, unsigned int op)
+{
+	struct sha_mb_alg *alg = sha_mb_alg(crypto_ahash_reqtfm(req));
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+
+	rctx->op = op;
+
+	return mcryptd_enqueue_request(&alg->queue, &req->base);
+}
+
+static int sha_mb_update(struct ahash_request *req)
+{
+	return sha_mb_enqueue(req, SHA_MB_UPDATE);
+}
+
+static int sha_mb_final(struct ahash_request *req)
+{
+	return sha_mb_enqueue(req, SHA_MB_FINAL);
+}
+
+static int sha_mb_finup(struct ahash_request *req)
+{
+	return sha_mb_enqueue(req, SHA_MB_FINUP);
+}
+
+static int sha_mb_digest(struct ahash_request *req)
+{
+	sha_mb_init(req);
+
+	return sha_mb_finup(req);
+}
+
+static int sha_mb_export(struct ahash_request *req, void *out)
+{
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+
+	memcpy(out, &rctx->s, sizeof(rctx->s));
+
+	return 0;
+}
+
+static int sha_mb_import(struct ahash_request *req, const void *in)
+{
+	struct sha_mb_req_ctx *rctx = ahash_request_ctx(req);
+
+	memcpy(&rctx->s, in, sizeof(rctx->s));
+
+	return 0;
+}
+
+static int sha_mb_cra_init(struct crypto_tfm *tfm)
+{
+	crypto_ahash_set_reqsize(__crypto_ahash_cast(tfm),
+				 sizeof(struct sha_mb_req_ctx));
+
+	return 0;
+}
+
+static const u32 sha1_mb_iv[] = {
+	SHA1_H0, SHA1_H1, SHA1_H2, SHA1_H3, SHA1_H4,
+};
+
+static const u32 sha256_mb_iv[] = {
+	SHA256_H0, SHA256_H1, SHA256_H2, SHA256_H3,
+	SHA256_H4, SHA256_H5, SHA256_H6, SHA256_H7,
+};
+
+static struct sha_mb_alg sha1_mb_alg;
+static struct sha_mb_alg sha256_mb_alg;
+
+static void sha1_mb_init_mgr(void *mgr_ptr)
+{
+	struct sha_mb_mgr *mgr = mgr_ptr;
+
+	memset(mgr, 0, sizeof(*mgr));
+	mgr->free = SHA_MB_ALL_FREE;
+	mgr->alg = &sha1_mb_alg;
+}
+
+static void sha256_mb_init_mgr(void *mgr_ptr)
+{
+	struct sha_mb_mgr *mgr = mgr_ptr;
+
+	memset(mgr, 0, sizeof(*mgr));
+	mgr->free = SHA_MB_ALL_FREE;
+	mgr->alg = &sha256_mb_alg;
+}
+
+static const struct mcryptd_ops sha1_mb_ops = {
+	.init_mgr	=	sha1_mb_init_mgr,
+	.submit		=	sha_mb_submit,
+	.flush		=	sha_mb_flush,
+};
+
+static const struct mcryptd_ops sha256_mb_ops = {
+	.init_mgr	=	sha256_mb_init_mgr,
+	.submit		=	sha_mb_submit,
+	.flush		=	sha_mb_flush,
+};
+
+/*
+ * Batching pays off for many concurrent requests, but a lone request
+ * waits for the flush, so these must never be picked for a plain "sha1"
+ * or "sha256".  They are registered under internal names, and only users
+ * that submit in parallel get them, by asking for the driver name.
+ */
+static struct sha_mb_alg sha1_mb_alg = {
+	.ops		=	&sha1_mb_ops,
+	.transform	=	sha1_x8_avx2,
+	.words		=	SHA1_DIGEST_SIZE / 4,
+	.iv		=	sha1_mb_iv,
+	.ahash		=	{
+		.init		=	sha_mb_init,
+		.update		=	sha_mb_update,
+		.final		=	sha_mb_final,
+		.finup		=	sha_mb_finup,
+		.digest		=	sha_mb_digest,
+		.export		=	sha_mb_export,
+		.import		=	sha_mb_import,
+		.halg		=	{
+			.digestsize	=	SHA1_DIGEST_SIZE,
+			.statesize	=	sizeof(struct sha_mb_state),
+			.base		=	{
+				.cra_name	=	"__sha1-mb",
+				.cra_driver_name =	"sha1-mb",
+				.cra_priority	=	50,
+				.cra_flags	=	CRYPTO_ALG_TYPE_AHASH |
+							CRYPTO_ALG_ASYNC,
+				.cra_blocksize	=	SHA1_BLOCK_SIZE,
+				.cra_init	=	sha_mb_cra_init,
+				.cra_module	=	THIS_MODULE,
+			}
+		}
+	}
+};
+
+static struct sha_mb_alg sha256_mb_alg = {
+	.ops		=	&sha256_mb_ops,
+	.transform	=	sha256_x8_avx2,
+	.words		=	SHA256_DIGEST_SIZE / 4,
+	.iv		=	sha256_mb_iv,
+	.ahash		=	{
+		.init		=	sha_mb_init,
+		.update		=	sha_mb_update,
+		.final		=	sha_mb_final,
+		.finup		=	sha_mb_finup,
+		.digest		=	sha_mb_digest,
+		.export		=	sha_mb_export,
+		.import		=	sha_mb_import,
+		.halg		=	{
+			.digestsize	=	SHA256_DIGEST_SIZE,
+			.statesize	=	sizeof(struct sha_mb_state),
+			.base		=	{
+				.cra_name	=	"__sha256-mb",
+				.cra_driver_name =	"sha256-mb",
+				.cra_priority	=	50,
+				.cra_flags	=	CRYPTO_ALG_TYPE_AHASH |
+							CRYPTO_ALG_ASYNC,
+				.cra_blocksize	=	SHA256_BLOCK_SIZE,
+				.cra_init	=	sha_mb_cra_init,
+				.cra_module	=	THIS_MODULE,
+			}
+		}
+	}
+};
+
+static struct sha_mb_alg *sha_mb_algs[] = {
+	&sha1_mb_alg,
+	&sha256_mb_alg,
+};
+
+static bool __init avx2_usable(void)
+{
+	u64 xcr0;
+
+	if (!IS_ENABLED(CONFIG_AS_AVX2) || !cpu_has_avx2 || !cpu_has_osxsave)
+		return false;
+
+	xcr0 = xgetbv(XCR_XFEATURE_ENABLED_MASK);
+	if ((xcr0 & (XSTATE_SSE | XSTATE_YMM)) != (XSTATE_SSE | XSTATE_YMM)) {
+		pr_info("AVX2 detected but unusable.\n");
+
+		return false;
+	}
+
+	return true;
+}
+
+static void sha_mb_unregister(int n)
+{
+	while (n--) {
+		crypto_unregister_ahash(&sha_mb_algs[n]->ahash);
+		mcryptd_fini_queue(&sha_mb_algs[n]->queue);
+	}
+}
+
+static int __init sha_mb_mod_init(void)
+{
+	struct sha_mb_alg *alg;
+	int i, ret;
+
+	if (!avx2_usable()) {
+		pr_info("AVX2 is not available/usable.\n");
+
+		return -ENODEV;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(sha_mb_algs); i++) {
+		alg = sha_mb_algs[i];
+
+		/* flush partially filled lanes after one tick at the most */
+		ret = mcryptd_init_queue(&alg->queue, alg->ops,
+					 sizeof(struct sha_mb_mgr),
+					 SHA_MB_MAX_CPU_QLEN,
+					 msecs_to_jiffies(1));
+		if (ret)
+			goto err;
+
+		ret = crypto_register_ahash(&alg->ahash);
+		if (ret) {
+			mcryptd_fini_queue(&alg->queue);
+			goto err;
+		}
+	}
+
+	return 0;
+
+err:
+	sha_mb_unregister(i);
+	return ret;
+}
+
+static void __exit sha_mb_mod_fini(void)
+{
+	sha_mb_unregister(ARRAY_SIZE(sha_mb_algs));
+}
+
+module_init(sha_mb_mod_init);
+module_exit(sha_mb_mod_fini);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("SHA1 and SHA256 Secure Hash Algorithm, multi-buffer AVX2 accelerated");
+
+MODULE_ALIAS("sha1");
+MODULE_ALIAS("sha256");
@@ -249,6 +249,9 @@ struct kvm_mmu_page {
 #endif
 
 	int write_flooding_count;
+
+	/* kvm->arch.mmu_valid_gen when created, obsolete if it differs */
+	unsigned long mmu_valid_gen;
 };
 
 struct kvm_pio_request {
@@ -518,6 +521,8 @@ struct kvm_arch {
 	 * Hash table of struct kvm_mmu_page.
 	 */
 	struct list_head active_mmu_pages;
+	/* Bumped to make all shadow pages obsolete at once. */
+	unsigned long mmu_valid_gen;
 	struct list_head assigned_dev_head;
 	struct iommu_domain *iommu_domain;
 	int iommu_flags;
@@ -572,6 +577,7 @@ struct kvm_vm_stat {
 
 struct kvm_vcpu_stat {
 	u32 pf_fixed;
+	u32 pf_fast;
 	u32 pf_guest;
 	u32 tlb_flush;
 	u32 invlpg;
@@ -584,6 +590,8 @@ struct kvm_vcpu_stat {
 	u32 nmi_window_exits;
 	u32 halt_exits;
 	u32 halt_wakeup;
+	u32 halt_successful_poll;
+	u32 halt_attempted_poll;
 	u32 request_irq_exits;
 	u32 irq_exits;
 	u32 host_state_reload;
@@ -726,11 +734,13 @@ void kvm_mmu_set_mask_ptes(u64 user_mask, u64 accessed_mask,
 		u64 dirty_mask, u64 nx_mask, u64 x_mask);
 
 int kvm_mmu_reset_context(struct kvm_vcpu *vcpu);
-void kvm_mmu_slot_remove_write_access(struct kvm *kvm, int slot);
+bool kvm_mmu_lock_break(struct kvm *kvm, bool *flush);
+unsigned int kvm_mmu_slot_remove_write_access(struct kvm *kvm, int slot);
 void kvm_mmu_write_protect_pt_masked(struct kvm *kvm,
 				     struct kvm_memory_slot *slot,
 				     gfn_t gfn_offset, unsigned long mask);
 void kvm_mmu_zap_all(struct kvm *kvm);
+void kvm_mmu_invalidate_zap_all_pages(struct kvm *kvm);
 unsigned int kvm_mmu_calculate_mmu_pages(struct kvm *kvm);
 void kvm_mmu_change_mmu_pages(struct kvm *kvm, unsigned int kvm_nr_mmu_pages);
 
@@ -358,10 +358,8 @@ do {						\
 	xor_speed(&xor_block_sse);		\
 } while (0)
 
-/* We force the use of the SSE xor block because it can write around L2.
-   We may also be able to load into the L1 only depending on how the cpu
-   deals with a load to a line that is being prefetched.  */
-#define XOR_SELECT_TEMPLATE(FASTEST) \
-	AVX_SELECT(&xor_block_sse)
+/* No template is forced: whether writing around the caches pays off
+   depends on the memory system, so calibrate_xor_blocks() measures them
+   all streaming through an area sized like the md stripe cache.  */
 
 #endif /* _ASM_X86_XOR_64_H */
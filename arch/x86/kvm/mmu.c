@@ -1483,6 +1483,7 @@ static struct kvm_mmu_page *kvm_mmu_alloc_page(struct kvm_vcpu *vcpu,
 		sp->gfns = mmu_memory_cache_alloc(&vcpu->arch.mmu_page_cache);
 	set_page_private(virt_to_page(sp->spt), (unsigned long)sp);
 	list_add(&sp->link, &vcpu->kvm->arch.active_mmu_pages);
+	sp->mmu_valid_gen = vcpu->kvm->arch.mmu_valid_gen;
 	bitmap_zero(sp->slot_bitmap, KVM_MEM_SLOTS_NUM);
 	sp->parent_ptes = 0;
 	mmu_page_add_parent_pte(vcpu, sp, parent_pte);
@@ -1620,6 +1621,11 @@ static int kvm_mmu_prepare_zap_page(struct kvm *kvm, struct kvm_mmu_page *sp,
 static void kvm_mmu_commit_zap_page(struct kvm *kvm,
 				    struct list_head *invalid_list);
 
+static bool is_obsolete_sp(struct kvm *kvm, struct kvm_mmu_page *sp)
+{
+	return unlikely(sp->mmu_valid_gen != kvm->arch.mmu_valid_gen);
+}
+
 #define for_each_gfn_sp(kvm, sp, gfn, pos)				\
   hlist_for_each_entry(sp, pos,						\
    &(kvm)->arch.mmu_page_hash[kvm_page_table_hashfn(gfn)], hash_link)	\
@@ -1840,6 +1846,10 @@ static struct kvm_mmu_page *kvm_mmu_get_page(struct kvm_vcpu *vcpu,
 		role.quadrant = quadrant;
 	}
 	for_each_gfn_sp(vcpu->kvm, sp, gfn, node) {
+		/* Being zapped, see kvm_mmu_invalidate_zap_all_pages(). */
+		if (is_obsolete_sp(vcpu->kvm, sp))
+			continue;
+
 		if (!need_sync && sp->unsync)
 			need_sync = true;
 
@@ -2057,7 +2067,13 @@ static int kvm_mmu_prepare_zap_page(struct kvm *kvm, struct kvm_mmu_page *sp,
 		kvm_mod_used_mmu_pages(kvm, -1);
 	} else {
 		list_move(&sp->link, &kvm->arch.active_mmu_pages);
-		kvm_reload_remote_mmus(kvm);
+
+		/*
+		 * Obsolete roots are already being reloaded by all vcpus,
+		 * don't send them another request for each one.
+		 */
+		if (!sp->role.invalid && !is_obsolete_sp(kvm, sp))
+			kvm_reload_remote_mmus(kvm);
 	}
 
 	sp->role.invalid = 1;
@@ -2688,14 +2704,34 @@ exit:
 static bool page_fault_can_be_fast(struct kvm_vcpu *vcpu, u32 error_code)
 {
 	/*
-	 * #PF can be fast only if the shadow page table is present and it
-	 * is caused by write-protect, that means we just need change the
-	 * W bit of the spte which can be done out of mmu-lock.
+	 * #PF can be fast if the spte already allows the access, i.e. the
+	 * fault is spurious, or if it is caused by write-protect, that means
+	 * we just need change the W bit of the spte which can be done out of
+	 * mmu-lock.  Reserved bit faults are mmio and go elsewhere.
 	 */
-	if (!(error_code & PFERR_PRESENT_MASK) ||
-	      !(error_code & PFERR_WRITE_MASK))
+	if (error_code & PFERR_RSVD_MASK)
+		return false;
+
+	return true;
+}
+
+/*
+ * Whether the access that caused the fault is allowed by the last
+ * level spte.  Direct sptes are always user accessible, so only write
+ * and fetch need to be checked.
+ */
+static bool spte_allows_access(u64 spte, u32 error_code)
+{
+	if ((error_code & PFERR_WRITE_MASK) && !is_writable_pte(spte))
 		return false;
 
+	if (error_code & PFERR_FETCH_MASK) {
+		if (shadow_x_mask && !(spte & shadow_x_mask))
+			return false;
+		if (spte & shadow_nx_mask)
+			return false;
+	}
+
 	return true;
 }
 
@@ -2741,10 +2777,11 @@ static bool fast_page_fault(struct kvm_vcpu *vcpu, gva_t gva, int level,
 
 	/*
 	 * If the mapping has been changed, let the vcpu fault on the
-	 * same address again.
+	 * same address again.  A not-present fault on a not-present spte
+	 * needs the real page fault path to map it.
 	 */
 	if (!is_rmap_spte(spte)) {
-		ret = true;
+		ret = !!(error_code & PFERR_PRESENT_MASK);
 		goto exit;
 	}
 
@@ -2752,12 +2789,15 @@ static bool fast_page_fault(struct kvm_vcpu *vcpu, gva_t gva, int level,
 		goto exit;
 
 	/*
-	 * Check if it is a spurious fault caused by TLB lazily flushed.
+	 * Check if it is a spurious fault caused by TLB lazily flushed,
+	 * or by another vcpu mapping the page after we faulted on it,
+	 * which is common when many vcpus touch the same memory at once,
+	 * e.g. at boot.
 	 *
 	 * Need not check the access of upper level table entries since
 	 * they are always ACC_ALL.
 	 */
-	 if (is_writable_pte(spte)) {
+	if (spte_allows_access(spte, error_code)) {
 		ret = true;
 		goto exit;
 	}
@@ -2766,7 +2806,8 @@ static bool fast_page_fault(struct kvm_vcpu *vcpu, gva_t gva, int level,
 	 * Currently, to simplify the code, only the spte write-protected
 	 * by dirty-log can be fast fixed.
 	 */
-	if (!spte_is_locklessly_modifiable(spte))
+	if (!(error_code & PFERR_WRITE_MASK) ||
+	      !spte_is_locklessly_modifiable(spte))
 		goto exit;
 
 	/*
@@ -2776,6 +2817,8 @@ static bool fast_page_fault(struct kvm_vcpu *vcpu, gva_t gva, int level,
 	 */
 	ret = fast_pf_fix_direct_spte(vcpu, iterator.sptep, spte);
 exit:
+	if (ret)
+		++vcpu->stat.pf_fast;
 	trace_fast_page_fault(vcpu, gva, error_code, iterator.sptep,
 			      spte, ret);
 	walk_shadow_page_lockless_end(vcpu);
@@ -4046,28 +4089,72 @@ int kvm_mmu_setup(struct kvm_vcpu *vcpu)
 	return init_kvm_mmu(vcpu);
 }
 
-void kvm_mmu_slot_remove_write_access(struct kvm *kvm, int slot)
+/**
+ * kvm_mmu_lock_break - let others have mmu_lock for a moment
+ * @kvm: kvm instance
+ * @flush: whether sptes were write-protected since the last TLB flush
+ *
+ * For long walks under mmu_lock.  If a vcpu is waiting for the lock or
+ * we should reschedule, flush the TLBs if needed, since nobody may find
+ * a read-only spte that is still writable in some TLB, and drop the
+ * lock.  Returns true if it was dropped.
+ */
+bool kvm_mmu_lock_break(struct kvm *kvm, bool *flush)
 {
-	struct kvm_mmu_page *sp;
+	if (!need_resched() && !spin_needbreak(&kvm->mmu_lock))
+		return false;
+
+	if (*flush) {
+		kvm_flush_remote_tlbs(kvm);
+		*flush = false;
+	}
+	cond_resched_lock(&kvm->mmu_lock);
+	return true;
+}
+
+/*
+ * Write protect all pages of the slot, walking its rmaps rather than
+ * all shadow pages of the VM.  Large sptes are dropped.  Called with
+ * mmu_lock held, which is dropped now and then; returns how often.
+ */
+unsigned int kvm_mmu_slot_remove_write_access(struct kvm *kvm, int slot)
+{
+	struct kvm_memory_slot *memslot;
+	struct kvm_lpage_info *linfo;
+	unsigned long *rmapp;
+	unsigned long index, last_index;
+	unsigned int breaks = 0;
+	gfn_t last_gfn;
 	bool flush = false;
+	int i;
 
-	list_for_each_entry(sp, &kvm->arch.active_mmu_pages, link) {
-		int i;
-		u64 *pt;
+	memslot = id_to_memslot(kvm->memslots, slot);
+	if (!memslot->npages)
+		return 0;
+	last_gfn = memslot->base_gfn + memslot->npages - 1;
 
-		if (!test_bit(slot, sp->slot_bitmap))
-			continue;
+	for (i = PT_PAGE_TABLE_LEVEL;
+	     i < PT_PAGE_TABLE_LEVEL + KVM_NR_PAGE_SIZES; ++i) {
+		last_index = gfn_to_index(last_gfn, memslot->base_gfn, i);
+
+		for (index = 0; index <= last_index; ++index) {
+			if (i == PT_PAGE_TABLE_LEVEL) {
+				rmapp = &memslot->rmap[index];
+			} else {
+				linfo = memslot->arch.lpage_info[i - 2];
+				rmapp = &linfo[index].rmap_pde;
+			}
 
-		pt = sp->spt;
-		for (i = 0; i < PT64_ENT_PER_PAGE; ++i) {
-			if (!is_shadow_present_pte(pt[i]) ||
-			      !is_last_spte(pt[i], sp->role.level))
-				continue;
+			if (*rmapp)
+				flush |= __rmap_write_protect(kvm, rmapp, i,
+							      false);
 
-			spte_write_protect(kvm, &pt[i], &flush, false);
+			if (kvm_mmu_lock_break(kvm, &flush))
+				breaks++;
 		}
 	}
 	kvm_flush_remote_tlbs(kvm);
+	return breaks;
 }
 
 void kvm_mmu_zap_all(struct kvm *kvm)
@@ -4085,6 +4172,87 @@ restart:
 	spin_unlock(&kvm->mmu_lock);
 }
 
+#define BATCH_ZAP_PAGES	10
+
+static void kvm_zap_obsolete_pages(struct kvm *kvm)
+{
+	struct kvm_mmu_page *sp, *node;
+	LIST_HEAD(invalid_list);
+	unsigned int batch = 0, zapped = 0, breaks = 0;
+	ktime_t start = ktime_get();
+
+restart:
+	list_for_each_entry_safe_reverse(sp, node,
+	      &kvm->arch.active_mmu_pages, link) {
+		int ret;
+
+		/*
+		 * New pages are added at the head of the list, so all
+		 * obsolete pages are at the tail.
+		 */
+		if (!is_obsolete_sp(kvm, sp))
+			break;
+
+		/*
+		 * Invalid roots were zapped already and stay on the list
+		 * until their last vcpu drops them.
+		 */
+		if (sp->role.invalid)
+			continue;
+
+		/*
+		 * The pages on invalid_list can be kept over dropping the
+		 * lock: they are unreachable from the new roots, and no vcpu
+		 * can still use the old ones or their TLB entries, see
+		 * kvm_mmu_invalidate_zap_all_pages().
+		 */
+		if (batch >= BATCH_ZAP_PAGES &&
+		      cond_resched_lock(&kvm->mmu_lock)) {
+			batch = 0;
+			breaks++;
+			goto restart;
+		}
+
+		ret = kvm_mmu_prepare_zap_page(kvm, sp, &invalid_list);
+		batch += ret;
+		zapped += ret;
+
+		if (ret)
+			goto restart;
+	}
+
+	kvm_mmu_commit_zap_page(kvm, &invalid_list);
+	trace_kvm_mmu_zap_obsolete_pages(kvm, zapped, breaks,
+				ktime_to_ns(ktime_sub(ktime_get(), start)));
+}
+
+/**
+ * kvm_mmu_invalidate_zap_all_pages - zap all shadow pages, fast
+ * @kvm: kvm instance
+ *
+ * Rather than zapping every shadow page before anybody can continue,
+ * make them all obsolete at once by bumping the generation number.
+ * The vcpus then build new page tables right away, while the obsolete
+ * pages are freed in batches, dropping mmu_lock in between.
+ */
+void kvm_mmu_invalidate_zap_all_pages(struct kvm *kvm)
+{
+	spin_lock(&kvm->mmu_lock);
+	trace_kvm_mmu_invalidate_zap_all_pages(kvm);
+	kvm->arch.mmu_valid_gen++;
+
+	/*
+	 * Make all vcpus reload their roots and flush their TLBs before
+	 * they enter the guest again, so that none of them uses an obsolete
+	 * page from now on.  Must be done before mmu_lock is dropped, or a
+	 * vcpu could use a zapped page without a TLB flush.
+	 */
+	kvm_reload_remote_mmus(kvm);
+
+	kvm_zap_obsolete_pages(kvm);
+	spin_unlock(&kvm->mmu_lock);
+}
+
 static void kvm_mmu_remove_some_alloc_mmu_pages(struct kvm *kvm,
 						struct list_head *invalid_list)
 {
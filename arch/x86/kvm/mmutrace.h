@@ -201,6 +201,50 @@ DEFINE_EVENT(kvm_mmu_page_class, kvm_mmu_delay_free_pages,
 	TP_ARGS(sp)
 );
 
+TRACE_EVENT(
+	kvm_mmu_invalidate_zap_all_pages,
+	TP_PROTO(struct kvm *kvm),
+	TP_ARGS(kvm),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, mmu_valid_gen)
+		__field(unsigned int, mmu_used_pages)
+	),
+
+	TP_fast_assign(
+		__entry->mmu_valid_gen = kvm->arch.mmu_valid_gen;
+		__entry->mmu_used_pages = kvm->arch.n_used_mmu_pages;
+	),
+
+	TP_printk("kvm-mmu-valid-gen %lx used_pages %x",
+		  __entry->mmu_valid_gen, __entry->mmu_used_pages)
+);
+
+TRACE_EVENT(
+	kvm_mmu_zap_obsolete_pages,
+	TP_PROTO(struct kvm *kvm, unsigned int zapped, unsigned int breaks,
+		 u64 ns),
+	TP_ARGS(kvm, zapped, breaks, ns),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, mmu_valid_gen)
+		__field(unsigned int, zapped)
+		__field(unsigned int, breaks)
+		__field(u64, ns)
+	),
+
+	TP_fast_assign(
+		__entry->mmu_valid_gen = kvm->arch.mmu_valid_gen;
+		__entry->zapped = zapped;
+		__entry->breaks = breaks;
+		__entry->ns = ns;
+	),
+
+	TP_printk("kvm-mmu-valid-gen %lx zapped %u in %llu ns, "
+		  "mmu_lock dropped %u times", __entry->mmu_valid_gen,
+		  __entry->zapped, __entry->ns, __entry->breaks)
+);
+
 TRACE_EVENT(
 	mark_mmio_spte,
 	TP_PROTO(u64 *sptep, gfn_t gfn, unsigned access),
@@ -244,7 +288,8 @@ TRACE_EVENT(
 );
 
 #define __spte_satisfied(__spte)				\
-	(__entry->retry && is_writable_pte(__entry->__spte))
+	(__entry->retry && (!(__entry->error_code & PFERR_WRITE_MASK) ||	\
+			    is_writable_pte(__entry->__spte)))
 
 TRACE_EVENT(
 	fast_page_fault,
@@ -843,6 +843,38 @@ TRACE_EVENT(
 		  __entry->write ? "Write" : "Read",
 		  __entry->gpa_match ? "GPA" : "GVA")
 );
+
+/*
+ * Tracepoint for write protecting a memslot for dirty logging, either
+ * the pages found dirty by KVM_GET_DIRTY_LOG or, when logging is
+ * enabled, all of them.
+ */
+TRACE_EVENT(kvm_dirty_log_protect,
+	TP_PROTO(int slot, unsigned long npages, unsigned long nr_protect,
+		 u64 ns, unsigned int breaks),
+	TP_ARGS(slot, npages, nr_protect, ns, breaks),
+
+	TP_STRUCT__entry(
+		__field(	int,		slot		)
+		__field(	unsigned long,	npages		)
+		__field(	unsigned long,	nr_protect	)
+		__field(	u64,		ns		)
+		__field(	unsigned int,	breaks		)
+	),
+
+	TP_fast_assign(
+		__entry->slot		= slot;
+		__entry->npages		= npages;
+		__entry->nr_protect	= nr_protect;
+		__entry->ns		= ns;
+		__entry->breaks		= breaks;
+	),
+
+	TP_printk("slot %d: %lu of %lu pages in %llu ns, mmu_lock dropped %u times",
+		  __entry->slot, __entry->nr_protect, __entry->npages,
+		  __entry->ns, __entry->breaks)
+);
+
 #endif /* _TRACE_KVM_H */
 
 #undef TRACE_INCLUDE_PATH
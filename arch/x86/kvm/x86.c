@@ -122,6 +122,7 @@ static DEFINE_PER_CPU(struct kvm_shared_msrs, shared_msrs);
 
 struct kvm_stats_debugfs_item debugfs_entries[] = {
 	{ "pf_fixed", VCPU_STAT(pf_fixed) },
+	{ "pf_fast", VCPU_STAT(pf_fast) },
 	{ "pf_guest", VCPU_STAT(pf_guest) },
 	{ "tlb_flush", VCPU_STAT(tlb_flush) },
 	{ "invlpg", VCPU_STAT(invlpg) },
@@ -133,6 +134,8 @@ struct kvm_stats_debugfs_item debugfs_entries[] = {
 	{ "nmi_window", VCPU_STAT(nmi_window_exits) },
 	{ "halt_exits", VCPU_STAT(halt_exits) },
 	{ "halt_wakeup", VCPU_STAT(halt_wakeup) },
+	{ "halt_successful_poll", VCPU_STAT(halt_successful_poll) },
+	{ "halt_attempted_poll", VCPU_STAT(halt_attempted_poll) },
 	{ "hypercalls", VCPU_STAT(hypercalls) },
 	{ "request_irq", VCPU_STAT(request_irq_exits) },
 	{ "irq_exits", VCPU_STAT(irq_exits) },
@@ -3113,6 +3116,10 @@ static int kvm_vm_ioctl_reinject(struct kvm *kvm,
  * entry.  This is not a problem because the page will be reported dirty at
  * step 4 using the snapshot taken before and step 3 ensures that successive
  * writes will be logged for the next call.
+ *
+ * Only the pages found dirty are write protected again.  For big slots the
+ * walk still takes long, so mmu_lock is dropped now and then, doing step 3
+ * for the pages protected so far first.
  */
 int kvm_vm_ioctl_get_dirty_log(struct kvm *kvm, struct kvm_dirty_log *log)
 {
@@ -3121,7 +3128,10 @@ int kvm_vm_ioctl_get_dirty_log(struct kvm *kvm, struct kvm_dirty_log *log)
 	unsigned long n, i;
 	unsigned long *dirty_bitmap;
 	unsigned long *dirty_bitmap_buffer;
-	bool is_dirty = false;
+	unsigned long nr_dirty = 0;
+	unsigned int breaks = 0;
+	bool flush = false;
+	ktime_t start;
 
 	mutex_lock(&kvm->slots_lock);
 
@@ -3141,28 +3151,37 @@ int kvm_vm_ioctl_get_dirty_log(struct kvm *kvm, struct kvm_dirty_log *log)
 	dirty_bitmap_buffer = dirty_bitmap + n / sizeof(long);
 	memset(dirty_bitmap_buffer, 0, n);
 
+	start = ktime_get();
 	spin_lock(&kvm->mmu_lock);
 
 	for (i = 0; i < n / sizeof(long); i++) {
 		unsigned long mask;
 		gfn_t offset;
 
-		if (!dirty_bitmap[i])
-			continue;
+		if (dirty_bitmap[i]) {
+			flush = true;
 
-		is_dirty = true;
+			mask = xchg(&dirty_bitmap[i], 0);
+			dirty_bitmap_buffer[i] = mask;
+			nr_dirty += hweight_long(mask);
 
-		mask = xchg(&dirty_bitmap[i], 0);
-		dirty_bitmap_buffer[i] = mask;
+			offset = i * BITS_PER_LONG;
+			kvm_mmu_write_protect_pt_masked(kvm, memslot, offset,
+							mask);
+		}
 
-		offset = i * BITS_PER_LONG;
-		kvm_mmu_write_protect_pt_masked(kvm, memslot, offset, mask);
+		if (kvm_mmu_lock_break(kvm, &flush))
+			breaks++;
 	}
-	if (is_dirty)
+	if (flush)
 		kvm_flush_remote_tlbs(kvm);
 
 	spin_unlock(&kvm->mmu_lock);
 
+	trace_kvm_dirty_log_protect(log->slot, memslot->npages, nr_dirty,
+				    ktime_to_ns(ktime_sub(ktime_get(), start)),
+				    breaks);
+
 	r = -EFAULT;
 	if (copy_to_user(log->dirty_bitmap, dirty_bitmap_buffer, n))
 		goto out;
@@ -6443,14 +6462,25 @@ void kvm_arch_commit_memory_region(struct kvm *kvm,
 	spin_lock(&kvm->mmu_lock);
 	if (nr_mmu_pages)
 		kvm_mmu_change_mmu_pages(kvm, nr_mmu_pages);
-	kvm_mmu_slot_remove_write_access(kvm, mem->slot);
+	/*
+	 * Write protect all pages for dirty logging.  Large page mappings
+	 * are dropped and not created again while logging is on.
+	 */
+	if (npages && (mem->flags & KVM_MEM_LOG_DIRTY_PAGES)) {
+		ktime_t start = ktime_get();
+		unsigned int breaks;
+
+		breaks = kvm_mmu_slot_remove_write_access(kvm, mem->slot);
+		trace_kvm_dirty_log_protect(mem->slot, npages, npages,
+				ktime_to_ns(ktime_sub(ktime_get(), start)),
+				breaks);
+	}
 	spin_unlock(&kvm->mmu_lock);
 }
 
 void kvm_arch_flush_shadow(struct kvm *kvm)
 {
-	kvm_mmu_zap_all(kvm);
-	kvm_reload_remote_mmus(kvm);
+	kvm_mmu_invalidate_zap_all_pages(kvm);
 }
 
 int kvm_arch_vcpu_runnable(struct kvm_vcpu *vcpu)
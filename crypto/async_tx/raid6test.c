@@ -24,6 +24,7 @@
 #include <linux/mm.h>
 #include <linux/random.h>
 #include <linux/module.h>
+#include <linux/raid/pq.h>
 
 #undef pr
 #define pr(fmt, args...) pr_info("raid6test: " fmt, ##args)
@@ -157,6 +158,52 @@ static int test_disks(int i, int j, int disks)
 	return erra || errb;
 }
 
+/* Simulate a read-modify-write of data block i: XOR its old contents out
+ * of P/Q, replace it, XOR the new contents in, then validate the syndrome
+ */
+static int test_rmw(int i, int disks)
+{
+	struct page *blocks[NDISKS];
+	struct dma_async_tx_descriptor *tx;
+	struct async_submit_ctl submit;
+	struct completion cmp;
+	enum sum_check_flags result = ~0;
+	int j, pass;
+
+	for (pass = 0; pass < 2; pass++) {
+		for (j = 0; j < disks; j++)
+			blocks[j] = (j == i || j >= disks-2) ? data[j] : NULL;
+
+		init_async_submit(&submit, ASYNC_TX_PQ_XOR_DST, NULL, NULL,
+				  NULL, addr_conv);
+		tx = async_gen_syndrome(blocks, 0, disks, PAGE_SIZE, &submit);
+		async_tx_quiesce(&tx);
+
+		if (pass)
+			break;
+		for (j = 0; j < PAGE_SIZE/sizeof(u32); j++) {
+			u32 *p = page_address(data[i]);
+
+			p[j] = random32();
+		}
+	}
+
+	init_completion(&cmp);
+	init_async_submit(&submit, ASYNC_TX_ACK, NULL, callback, &cmp, addr_conv);
+	tx = async_syndrome_val(dataptrs, 0, disks, PAGE_SIZE, &result, spare,
+				&submit);
+	async_tx_issue_pending(tx);
+
+	if (wait_for_completion_timeout(&cmp, msecs_to_jiffies(3000)) == 0) {
+		pr("%s: timeout! (faila: %d disks: %d)\n", __func__, i, disks);
+		return 1;
+	}
+
+	pr("%s(%d): %s\n", __func__, i, result == 0 ? "OK" : "ERR");
+
+	return result != 0;
+}
+
 static int test(int disks, int *tests)
 {
 	struct dma_async_tx_descriptor *tx;
@@ -193,6 +240,12 @@ static int test(int disks, int *tests)
 			err += test_disks(i, j, disks);
 		}
 
+	if (raid6_call.xor_syndrome)
+		for (i = 0; i < disks-2; i++) {
+			(*tests)++;
+			err += test_rmw(i, disks);
+		}
+
 	return err;
 }
 
@@ -0,0 +1,436 @@
+/*
+ * ChaCha20-Poly1305 AEAD, RFC7539
+ *
+ * The ChaCha20 keystream block with counter 0 provides the one-time
+ * Poly1305 key; the payload is encrypted from counter 1 on, and the tag
+ * authenticates the padded associated data, the padded ciphertext and
+ * the lengths of both.
+ *
+ * rfc7539esp is the variant of RFC 7634 for IPsec: the last four bytes
+ * of the key are a salt that is prepended to the 64-bit explicit IV to
+ * form the nonce, so that seqiv can generate the IVs.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <crypto/internal/aead.h>
+#include <crypto/internal/hash.h>
+#include <crypto/scatterwalk.h>
+#include <crypto/chacha20.h>
+#include <crypto/poly1305.h>
+#include <linux/err.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/slab.h>
+
+#define CHACHAPOLY_IV_SIZE	12
+
+struct chachapoly_instance_ctx {
+	struct crypto_spawn chacha;
+	struct crypto_shash_spawn poly;
+	unsigned int saltlen;
+};
+
+struct chachapoly_ctx {
+	struct crypto_blkcipher *chacha;
+	struct crypto_shash *poly;
+	/* key bytes we use for the ChaCha20 IV */
+	unsigned int saltlen;
+	u8 salt[];
+};
+
+struct chachapoly_req_ctx {
+	/* the key we generate for Poly1305 using Chacha20 */
+	u8 key[POLY1305_KEY_SIZE];
+	/* calculated Poly1305 tag */
+	u8 tag[POLY1305_DIGEST_SIZE];
+	/* initial block counter and nonce for ChaCha20 */
+	u8 iv[CHACHA20_IV_SIZE];
+	/* lengths of the associated data and the ciphertext */
+	__le64 lengths[2];
+	struct scatterlist sg[1];
+	/* must be last, followed by the Poly1305 descriptor context */
+	struct shash_desc desc;
+};
+
+static const u8 chachapoly_pad[POLY1305_BLOCK_SIZE];
+
+static void chachapoly_iv(struct aead_request *req, u32 icb)
+{
+	struct chachapoly_ctx *ctx = crypto_aead_ctx(crypto_aead_reqtfm(req));
+	struct chachapoly_req_ctx *rctx = aead_request_ctx(req);
+	__le32 leicb = cpu_to_le32(icb);
+	u8 *iv = rctx->iv;
+
+	memcpy(iv, &leicb, sizeof(leicb));
+	iv += sizeof(leicb);
+	memcpy(iv, ctx->salt, ctx->saltlen);
+	iv += ctx->saltlen;
+	memcpy(iv, req->iv, CHACHA20_IV_SIZE - sizeof(leicb) - ctx->saltlen);
+}
+
+static int chachapoly_chacha(struct aead_request *req, u32 icb,
+			     struct scatterlist *dst, struct scatterlist *src,
+			     unsigned int len)
+{
+	struct chachapoly_ctx *ctx = crypto_aead_ctx(crypto_aead_reqtfm(req));
+	struct chachapoly_req_ctx *rctx = aead_request_ctx(req);
+	struct blkcipher_desc desc = {
+		.tfm = ctx->chacha,
+		.info = rctx->iv,
+		.flags = req->base.flags & CRYPTO_TFM_REQ_MAY_SLEEP,
+	};
+
+	chachapoly_iv(req, icb);
+
+	return crypto_blkcipher_encrypt_iv(&desc, dst, src, len);
+}
+
+static int poly_update_sg(struct shash_desc *desc, struct scatterlist *sg,
+			  unsigned int len)
+{
+	struct scatter_walk walk;
+	int err = 0;
+
+	if (!len)
+		return 0;
+
+	scatterwalk_start(&walk, sg);
+	while (len && !err) {
+		unsigned int n = scatterwalk_clamp(&walk, len);
+		u8 *p = scatterwalk_map(&walk);
+
+		err = crypto_shash_update(desc, p, n);
+
+		scatterwalk_unmap(p);
+		scatterwalk_advance(&walk, n);
+		len -= n;
+		scatterwalk_done(&walk, 0, len);
+	}
+
+	return err;
+}
+
+static int poly_update_padded(struct shash_desc *desc, struct scatterlist *sg,
+			      unsigned int len)
+{
+	unsigned int padlen = -len % POLY1305_BLOCK_SIZE;
+
+	return poly_update_sg(desc, sg, len) ?:
+	       crypto_shash_update(desc, chachapoly_pad, padlen);
+}
+
+/* Poly1305 over the associated data and the ciphertext in @crypt */
+static int chachapoly_tag(struct aead_request *req, struct scatterlist *crypt,
+			  unsigned int len)
+{
+	struct chachapoly_ctx *ctx = crypto_aead_ctx(crypto_aead_reqtfm(req));
+	struct chachapoly_req_ctx *rctx = aead_request_ctx(req);
+	struct shash_desc *desc = &rctx->desc;
+	int err;
+
+	/* the one-time key is the keystream block with counter 0 */
+	memset(rctx->key, 0, sizeof(rctx->key));
+	sg_init_one(rctx->sg, rctx->key, sizeof(rctx->key));
+	err = chachapoly_chacha(req, 0, rctx->sg, rctx->sg, sizeof(rctx->key));
+	if (err)
+		return err;
+
+	desc->tfm = ctx->poly;
+	desc->flags = req->base.flags & CRYPTO_TFM_REQ_MAY_SLEEP;
+
+	rctx->lengths[0] = cpu_to_le64(req->assoclen);
+	rctx->lengths[1] = cpu_to_le64(len);
+
+	return crypto_shash_init(desc) ?:
+	       crypto_shash_update(desc, rctx->key, sizeof(rctx->key)) ?:
+	       poly_update_padded(desc, req->assoc, req->assoclen) ?:
+	       poly_update_padded(desc, crypt, len) ?:
+	       crypto_shash_finup(desc, (u8 *)rctx->lengths,
+				  sizeof(rctx->lengths), rctx->tag);
+}
+
+static int chachapoly_encrypt(struct aead_request *req)
+{
+	struct chachapoly_req_ctx *rctx = aead_request_ctx(req);
+	int err;
+
+	err = chachapoly_chacha(req, 1, req->dst, req->src, req->cryptlen);
+	if (err)
+		return err;
+
+	err = chachapoly_tag(req, req->dst, req->cryptlen);
+	if (err)
+		return err;
+
+	scatterwalk_map_and_copy(rctx->tag, req->dst, req->cryptlen,
+				 sizeof(rctx->tag), 1);
+	return 0;
+}
+
+static int chachapoly_decrypt(struct aead_request *req)
+{
+	struct chachapoly_req_ctx *rctx = aead_request_ctx(req);
+	u8 tag[POLY1305_DIGEST_SIZE];
+	unsigned int len;
+	int err;
+
+	if (req->cryptlen < POLY1305_DIGEST_SIZE)
+		return -EINVAL;
+	len = req->cryptlen - POLY1305_DIGEST_SIZE;
+
+	err = chachapoly_tag(req, req->src, len);
+	if (err)
+		return err;
+
+	scatterwalk_map_and_copy(tag, req->src, len, sizeof(tag), 0);
+	if (memcmp(tag, rctx->tag, sizeof(tag)))
+		return -EBADMSG;
+
+	return chachapoly_chacha(req, 1, req->dst, req->src, len);
+}
+
+static int chachapoly_setkey(struct crypto_aead *aead, const u8 *key,
+			     unsigned int keylen)
+{
+	struct chachapoly_ctx *ctx = crypto_aead_ctx(aead);
+	int err;
+
+	if (keylen != ctx->saltlen + CHACHA20_KEY_SIZE)
+		return -EINVAL;
+
+	keylen -= ctx->saltlen;
+	memcpy(ctx->salt, key + keylen, ctx->saltlen);
+
+	crypto_blkcipher_clear_flags(ctx->chacha, CRYPTO_TFM_REQ_MASK);
+	crypto_blkcipher_set_flags(ctx->chacha, crypto_aead_get_flags(aead) &
+						CRYPTO_TFM_REQ_MASK);
+	err = crypto_blkcipher_setkey(ctx->chacha, key, keylen);
+	crypto_aead_set_flags(aead, crypto_blkcipher_get_flags(ctx->chacha) &
+				    CRYPTO_TFM_RES_MASK);
+
+	return err;
+}
+
+static int chachapoly_setauthsize(struct crypto_aead *tfm,
+				  unsigned int authsize)
+{
+	if (authsize != POLY1305_DIGEST_SIZE)
+		return -EINVAL;
+
+	return 0;
+}
+
+static int chachapoly_init(struct crypto_tfm *tfm)
+{
+	struct crypto_instance *inst = (void *)tfm->__crt_alg;
+	struct chachapoly_instance_ctx *ictx = crypto_instance_ctx(inst);
+	struct chachapoly_ctx *ctx = crypto_tfm_ctx(tfm);
+	struct crypto_blkcipher *chacha;
+	struct crypto_shash *poly;
+
+	poly = crypto_spawn_shash(&ictx->poly);
+	if (IS_ERR(poly))
+		return PTR_ERR(poly);
+
+	chacha = crypto_spawn_blkcipher(&ictx->chacha);
+	if (IS_ERR(chacha)) {
+		crypto_free_shash(poly);
+		return PTR_ERR(chacha);
+	}
+
+	ctx->chacha = chacha;
+	ctx->poly = poly;
+	ctx->saltlen = ictx->saltlen;
+
+	tfm->crt_aead.reqsize = sizeof(struct chachapoly_req_ctx) +
+				crypto_shash_descsize(poly);
+
+	return 0;
+}
+
+static void chachapoly_exit(struct crypto_tfm *tfm)
+{
+	struct chachapoly_ctx *ctx = crypto_tfm_ctx(tfm);
+
+	crypto_free_shash(ctx->poly);
+	crypto_free_blkcipher(ctx->chacha);
+}
+
+static struct crypto_instance *chachapoly_alloc(struct rtattr **tb,
+						const char *name,
+						unsigned int ivsize)
+{
+	struct crypto_attr_type *algt;
+	struct crypto_instance *inst;
+	struct chachapoly_instance_ctx *ictx;
+	struct crypto_alg *chacha;
+	struct shash_alg *poly;
+	int err;
+
+	algt = crypto_get_attr_type(tb);
+	if (IS_ERR(algt))
+		return ERR_CAST(algt);
+
+	if ((algt->type ^ CRYPTO_ALG_TYPE_AEAD) & algt->mask)
+		return ERR_PTR(-EINVAL);
+
+	/* a synchronous blkcipher, as the request is processed in place */
+	chacha = crypto_attr_alg(tb[1], CRYPTO_ALG_TYPE_BLKCIPHER,
+				 CRYPTO_ALG_TYPE_MASK);
+	if (IS_ERR(chacha))
+		return ERR_CAST(chacha);
+
+	poly = shash_attr_alg(tb[2], 0, 0);
+	err = PTR_ERR(poly);
+	if (IS_ERR(poly))
+		goto out_put_chacha;
+
+	err = -EINVAL;
+	if (poly->digestsize != POLY1305_DIGEST_SIZE)
+		goto out_put_poly;
+	/* Need 16-byte IV size, including Initial Block Counter value */
+	if (chacha->cra_blkcipher.ivsize != CHACHA20_IV_SIZE)
+		goto out_put_poly;
+	/* Not a stream cipher? */
+	if (chacha->cra_blocksize != 1)
+		goto out_put_poly;
+
+	err = -ENOMEM;
+	inst = kzalloc(sizeof(*inst) + sizeof(*ictx), GFP_KERNEL);
+	if (!inst)
+		goto out_put_poly;
+
+	ictx = crypto_instance_ctx(inst);
+	ictx->saltlen = CHACHAPOLY_IV_SIZE - ivsize;
+
+	err = crypto_init_spawn(&ictx->chacha, chacha, inst,
+				CRYPTO_ALG_TYPE_MASK);
+	if (err)
+		goto out_free_inst;
+
+	err = crypto_init_shash_spawn(&ictx->poly, poly, inst);
+	if (err)
+		goto out_drop_chacha;
+
+	err = -ENAMETOOLONG;
+	if (snprintf(inst->alg.cra_name, CRYPTO_MAX_ALG_NAME,
+		     "%s(%s,%s)", name, chacha->cra_name,
+		     poly->base.cra_name) >= CRYPTO_MAX_ALG_NAME ||
+	    snprintf(inst->alg.cra_driver_name, CRYPTO_MAX_ALG_NAME,
+		     "%s(%s,%s)", name, chacha->cra_driver_name,
+		     poly->base.cra_driver_name) >= CRYPTO_MAX_ALG_NAME)
+		goto out_drop_poly;
+
+	inst->alg.cra_flags = CRYPTO_ALG_TYPE_AEAD;
+	inst->alg.cra_priority = (chacha->cra_priority +
+				  poly->base.cra_priority) / 2;
+	inst->alg.cra_blocksize = 1;
+	inst->alg.cra_alignmask = chacha->cra_alignmask |
+				  poly->base.cra_alignmask;
+
+	inst->alg.cra_aead.ivsize = ivsize;
+	inst->alg.cra_aead.maxauthsize = POLY1305_DIGEST_SIZE;
+
+	inst->alg.cra_ctxsize = sizeof(struct chachapoly_ctx) + ictx->saltlen;
+
+	inst->alg.cra_init = chachapoly_init;
+	inst->alg.cra_exit = chachapoly_exit;
+
+	inst->alg.cra_aead.setkey = chachapoly_setkey;
+	inst->alg.cra_aead.setauthsize = chachapoly_setauthsize;
+	inst->alg.cra_aead.encrypt = chachapoly_encrypt;
+	inst->alg.cra_aead.decrypt = chachapoly_decrypt;
+
+	if (ictx->saltlen) {
+		inst->alg.cra_type = &crypto_nivaead_type;
+		inst->alg.cra_aead.geniv = "seqiv";
+	} else {
+		inst->alg.cra_type = &crypto_aead_type;
+	}
+
+out:
+	crypto_mod_put(&poly->base);
+	crypto_mod_put(chacha);
+	return inst;
+
+out_drop_poly:
+	crypto_drop_shash(&ictx->poly);
+out_drop_chacha:
+	crypto_drop_spawn(&ictx->chacha);
+out_free_inst:
+	kfree(inst);
+out_put_poly:
+	inst = ERR_PTR(err);
+	goto out;
+
+out_put_chacha:
+	crypto_mod_put(chacha);
+	return ERR_PTR(err);
+}
+
+static struct crypto_instance *rfc7539_alloc(struct rtattr **tb)
+{
+	return chachapoly_alloc(tb, "rfc7539", CHACHAPOLY_IV_SIZE);
+}
+
+static struct crypto_instance *rfc7539esp_alloc(struct rtattr **tb)
+{
+	return chachapoly_alloc(tb, "rfc7539esp", 8);
+}
+
+static void chachapoly_free(struct crypto_instance *inst)
+{
+	struct chachapoly_instance_ctx *ctx = crypto_instance_ctx(inst);
+
+	crypto_drop_spawn(&ctx->chacha);
+	crypto_drop_shash(&ctx->poly);
+	kfree(inst);
+}
+
+static struct crypto_template rfc7539_tmpl = {
+	.name = "rfc7539",
+	.alloc = rfc7539_alloc,
+	.free = chachapoly_free,
+	.module = THIS_MODULE,
+};
+
+static struct crypto_template rfc7539esp_tmpl = {
+	.name = "rfc7539esp",
+	.alloc = rfc7539esp_alloc,
+	.free = chachapoly_free,
+	.module = THIS_MODULE,
+};
+
+static int __init chacha20poly1305_module_init(void)
+{
+	int err;
+
+	err = crypto_register_template(&rfc7539_tmpl);
+	if (err)
+		return err;
+
+	err = crypto_register_template(&rfc7539esp_tmpl);
+	if (err)
+		crypto_unregister_template(&rfc7539_tmpl);
+
+	return err;
+}
+
+static void __exit chacha20poly1305_module_exit(void)
+{
+	crypto_unregister_template(&rfc7539esp_tmpl);
+	crypto_unregister_template(&rfc7539_tmpl);
+}
+
+module_init(chacha20poly1305_module_init);
+module_exit(chacha20poly1305_module_exit);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("ChaCha20-Poly1305 AEAD");
+MODULE_ALIAS("rfc7539");
+MODULE_ALIAS("rfc7539esp");
@@ -0,0 +1,198 @@
+/*
+ * Software multi-buffer async crypto daemon.
+ *
+ * cryptd runs one request at a time per CPU.  Algorithms that can work
+ * on several independent requests in parallel SIMD lanes instead want
+ * to see as many requests as possible at once: mcryptd keeps the same
+ * per-cpu queue and worker as cryptd, but hands every dequeued request
+ * to the algorithm's lane manager, which only runs its lanes once they
+ * are all filled.  When the queue runs dry with lanes still partially
+ * filled, a flush is scheduled after a short delay so that requests do
+ * not wait indefinitely for company.
+ *
+ * Based on cryptd.c.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ */
+
+#include <crypto/algapi.h>
+#include <crypto/crypto_wq.h>
+#include <crypto/mcryptd.h>
+#include <linux/err.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/list.h>
+#include <linux/module.h>
+#include <linux/percpu.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+
+/* requests handed to the lanes before the worker yields */
+#define MCRYPTD_BATCH	32
+
+static void mcryptd_queue_worker(struct work_struct *work);
+static void mcryptd_flusher(struct work_struct *work);
+
+int mcryptd_init_queue(struct mcryptd_queue *queue,
+		       const struct mcryptd_ops *ops, size_t mgr_size,
+		       unsigned int max_cpu_qlen, unsigned long flush_delay)
+{
+	int cpu;
+	struct mcryptd_cpu_queue *cpu_queue;
+
+	queue->cpu_queue = alloc_percpu(struct mcryptd_cpu_queue);
+	if (!queue->cpu_queue)
+		return -ENOMEM;
+
+	queue->mgr = __alloc_percpu(mgr_size, L1_CACHE_BYTES);
+	if (!queue->mgr) {
+		free_percpu(queue->cpu_queue);
+		return -ENOMEM;
+	}
+
+	queue->ops = ops;
+	queue->flush_delay = flush_delay ?: 1;
+
+	for_each_possible_cpu(cpu) {
+		cpu_queue = per_cpu_ptr(queue->cpu_queue, cpu);
+		crypto_init_queue(&cpu_queue->queue, max_cpu_qlen);
+		INIT_WORK(&cpu_queue->work, mcryptd_queue_worker);
+		INIT_DELAYED_WORK(&cpu_queue->flush, mcryptd_flusher);
+		mutex_init(&cpu_queue->lock);
+		cpu_queue->busy = false;
+		cpu_queue->mqueue = queue;
+		cpu_queue->mgr = per_cpu_ptr(queue->mgr, cpu);
+		ops->init_mgr(cpu_queue->mgr);
+	}
+	return 0;
+}
+EXPORT_SYMBOL_GPL(mcryptd_init_queue);
+
+void mcryptd_fini_queue(struct mcryptd_queue *queue)
+{
+	int cpu;
+	struct mcryptd_cpu_queue *cpu_queue;
+
+	for_each_possible_cpu(cpu) {
+		cpu_queue = per_cpu_ptr(queue->cpu_queue, cpu);
+		cancel_delayed_work_sync(&cpu_queue->flush);
+		BUG_ON(cpu_queue->queue.qlen);
+		BUG_ON(cpu_queue->busy);
+	}
+	free_percpu(queue->mgr);
+	free_percpu(queue->cpu_queue);
+}
+EXPORT_SYMBOL_GPL(mcryptd_fini_queue);
+
+int mcryptd_enqueue_request(struct mcryptd_queue *queue,
+			    struct crypto_async_request *request)
+{
+	int cpu, err;
+	struct mcryptd_cpu_queue *cpu_queue;
+
+	cpu = get_cpu();
+	cpu_queue = this_cpu_ptr(queue->cpu_queue);
+	err = crypto_enqueue_request(&cpu_queue->queue, request);
+	queue_work_on(cpu, kcrypto_wq, &cpu_queue->work);
+	put_cpu();
+
+	return err;
+}
+EXPORT_SYMBOL_GPL(mcryptd_enqueue_request);
+
+static void mcryptd_complete(struct list_head *done)
+{
+	struct crypto_async_request *req, *n;
+
+	list_for_each_entry_safe(req, n, done, list) {
+		list_del(&req->list);
+		local_bh_disable();
+		req->complete(req, 0);
+		local_bh_enable();
+	}
+}
+
+/*
+ * Called in workqueue context: feed the queued requests to the lanes,
+ * and reschedule itself if there are more of them than one batch.
+ * Otherwise make sure that whatever is left in the lanes gets flushed.
+ */
+static void mcryptd_queue_worker(struct work_struct *work)
+{
+	struct mcryptd_cpu_queue *cpu_queue;
+	struct mcryptd_queue *queue;
+	struct crypto_async_request *req, *backlog;
+	LIST_HEAD(done);
+	int i;
+
+	cpu_queue = container_of(work, struct mcryptd_cpu_queue, work);
+	queue = cpu_queue->mqueue;
+
+	for (i = 0; i < MCRYPTD_BATCH; i++) {
+		/*
+		 * Only handle one request at a time to avoid hogging
+		 * the queue lock while the lanes run.
+		 */
+		local_bh_disable();
+		preempt_disable();
+		backlog = crypto_get_backlog(&cpu_queue->queue);
+		req = crypto_dequeue_request(&cpu_queue->queue);
+		preempt_enable();
+		local_bh_enable();
+
+		if (!req)
+			break;
+
+		if (backlog)
+			backlog->complete(backlog, -EINPROGRESS);
+
+		mutex_lock(&cpu_queue->lock);
+		cpu_queue->busy = queue->ops->submit(cpu_queue->mgr, req,
+						     &done);
+		mutex_unlock(&cpu_queue->lock);
+
+		mcryptd_complete(&done);
+	}
+
+	if (cpu_queue->queue.qlen)
+		queue_work(kcrypto_wq, &cpu_queue->work);
+	else if (cpu_queue->busy)
+		queue_delayed_work(kcrypto_wq, &cpu_queue->flush,
+				   queue->flush_delay);
+}
+
+/*
+ * Called when lanes have been left partially filled for flush_delay:
+ * run them as they are until they are empty, unless new requests turn
+ * up in the meantime, in which case the queue worker takes over.
+ */
+static void mcryptd_flusher(struct work_struct *work)
+{
+	struct mcryptd_cpu_queue *cpu_queue;
+	struct mcryptd_queue *queue;
+	LIST_HEAD(done);
+
+	cpu_queue = container_of(to_delayed_work(work),
+				 struct mcryptd_cpu_queue, flush);
+	queue = cpu_queue->mqueue;
+
+	for (;;) {
+		mutex_lock(&cpu_queue->lock);
+		if (!cpu_queue->busy || cpu_queue->queue.qlen) {
+			mutex_unlock(&cpu_queue->lock);
+			break;
+		}
+		cpu_queue->busy = queue->ops->flush(cpu_queue->mgr, &done);
+		mutex_unlock(&cpu_queue->lock);
+
+		mcryptd_complete(&done);
+		cond_resched();
+	}
+}
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("Software async multibuffer crypto daemon");
@@ -33,6 +33,8 @@
 #include <linux/jiffies.h>
 #include <linux/timex.h>
 #include <linux/interrupt.h>
+#include <linux/random.h>
+#include <linux/slab.h>
 #include "tcrypt.h"
 #include "internal.h"
 
@@ -64,7 +66,8 @@ static char *check[] = {
 	"cast6", "arc4", "michael_mic", "deflate", "crc32c", "tea", "xtea",
 	"khazad", "wp512", "wp384", "wp256", "tnepres", "xeta",  "fcrypt",
 	"camellia", "seed", "salsa20", "rmd128", "rmd160", "rmd256", "rmd320",
-	"lzo", "cts", "zlib", NULL
+	"lzo", "cts", "zlib", "lz4", "lz4hc", "crc32", "crct10dif", "chacha20",
+	"poly1305", NULL
 };
 
 static int test_cipher_jiffies(struct blkcipher_desc *desc, int enc,
@@ -423,8 +426,6 @@ static void test_hash_speed(const char *algo, unsigned int sec,
 	int i;
 	int ret;
 
-	printk(KERN_INFO "\ntesting speed of %s\n", algo);
-
 	tfm = crypto_alloc_hash(algo, 0, CRYPTO_ALG_ASYNC);
 
 	if (IS_ERR(tfm)) {
@@ -433,6 +434,9 @@ static void test_hash_speed(const char *algo, unsigned int sec,
 		return;
 	}
 
+	printk(KERN_INFO "\ntesting speed of %s (%s)\n", algo,
+	       crypto_tfm_alg_driver_name(crypto_hash_tfm(tfm)));
+
 	desc.tfm = tfm;
 	desc.flags = 0;
 
@@ -719,6 +723,203 @@ out:
 	crypto_free_ahash(tfm);
 }
 
+/* requests kept in flight by the multi-buffer hash speed test */
+#define MB_WIDTH	8
+
+struct test_mb_ahash_data {
+	struct scatterlist sg[TVMEMSIZE];
+	char result[64];
+	struct ahash_request *req;
+	struct tcrypt_result tresult;
+};
+
+/* start a digest on every request, then wait for all of them */
+static int test_mb_ahash_batch(struct test_mb_ahash_data *data)
+{
+	int i, ret, err = 0;
+
+	for (i = 0; i < MB_WIDTH; i++) {
+		ret = crypto_ahash_digest(data[i].req);
+		if (ret != -EINPROGRESS && ret != -EBUSY) {
+			data[i].tresult.err = ret;
+			complete(&data[i].tresult.completion);
+		}
+	}
+
+	for (i = 0; i < MB_WIDTH; i++) {
+		wait_for_completion(&data[i].tresult.completion);
+		if (data[i].tresult.err)
+			err = data[i].tresult.err;
+		INIT_COMPLETION(data[i].tresult.completion);
+	}
+
+	return err;
+}
+
+static int test_mb_ahash_jiffies(struct test_mb_ahash_data *data, int blen,
+				 int sec)
+{
+	unsigned long start, end;
+	int bcount;
+	int ret;
+
+	for (start = jiffies, end = start + sec * HZ, bcount = 0;
+	     time_before(jiffies, end); bcount += MB_WIDTH) {
+		ret = test_mb_ahash_batch(data);
+		if (ret)
+			return ret;
+	}
+
+	pr_cont("%6u opers/sec, %9lu bytes/sec, ",
+		bcount / sec, ((long)bcount * blen) / sec);
+
+	return 0;
+}
+
+static int test_mb_ahash_cycles(struct test_mb_ahash_data *data, int blen)
+{
+	unsigned long cycles = 0;
+	int ret, i;
+
+	/* Warm-up run. */
+	for (i = 0; i < 4; i++) {
+		ret = test_mb_ahash_batch(data);
+		if (ret)
+			return ret;
+	}
+
+	/* The real thing. */
+	for (i = 0; i < 8; i++) {
+		cycles_t start, end;
+
+		start = get_cycles();
+
+		ret = test_mb_ahash_batch(data);
+		if (ret)
+			return ret;
+
+		end = get_cycles();
+
+		cycles += end - start;
+	}
+
+	pr_cont("%6lu cycles/operation, %4lu cycles/byte, ",
+		cycles / (8 * MB_WIDTH), cycles / (8 * MB_WIDTH * blen));
+
+	return 0;
+}
+
+/*
+ * Throughput with MB_WIDTH independent digests in flight at once, which
+ * is what multi-buffer implementations are built for, followed by the
+ * latency of a digest on its own, which such implementations trade for
+ * it.
+ */
+static void test_mb_ahash_speed(const char *algo, unsigned int sec,
+				struct hash_speed *speed)
+{
+	struct test_mb_ahash_data *data;
+	struct crypto_ahash *tfm;
+	unsigned long cycles;
+	int i, j, ret;
+
+	data = kzalloc(sizeof(*data) * MB_WIDTH, GFP_KERNEL);
+	if (!data)
+		return;
+
+	tfm = crypto_alloc_ahash(algo, 0, 0);
+	if (IS_ERR(tfm)) {
+		pr_err("failed to load transform for %s: %ld\n",
+		       algo, PTR_ERR(tfm));
+		goto free_data;
+	}
+
+	printk(KERN_INFO "\ntesting speed of multibuffer %s (%s)\n", algo,
+	       crypto_tfm_alg_driver_name(crypto_ahash_tfm(tfm)));
+
+	if (crypto_ahash_digestsize(tfm) > sizeof(data[0].result)) {
+		pr_err("digestsize(%u) > outputbuffer(%zu)\n",
+		       crypto_ahash_digestsize(tfm), sizeof(data[0].result));
+		goto out;
+	}
+
+	for (i = 0; i < MB_WIDTH; i++) {
+		init_completion(&data[i].tresult.completion);
+		test_hash_sg_init(data[i].sg);
+
+		data[i].req = ahash_request_alloc(tfm, GFP_KERNEL);
+		if (!data[i].req) {
+			pr_err("ahash request allocation failure\n");
+			goto out_free_req;
+		}
+
+		ahash_request_set_callback(data[i].req,
+					   CRYPTO_TFM_REQ_MAY_BACKLOG,
+					   tcrypt_complete, &data[i].tresult);
+	}
+
+	for (i = 0; speed[i].blen != 0; i++) {
+		/* only whole digests are batched */
+		if (speed[i].blen != speed[i].plen)
+			continue;
+
+		if (speed[i].blen > TVMEMSIZE * PAGE_SIZE) {
+			pr_err("template (%u) too big for tvmem (%lu)\n",
+			       speed[i].blen, TVMEMSIZE * PAGE_SIZE);
+			break;
+		}
+
+		pr_info("test%3u (%5u byte blocks,%3u in flight): ",
+			i, speed[i].blen, MB_WIDTH);
+
+		for (j = 0; j < MB_WIDTH; j++)
+			ahash_request_set_crypt(data[j].req, data[j].sg,
+						data[j].result, speed[i].blen);
+
+		if (sec)
+			ret = test_mb_ahash_jiffies(data, speed[i].blen, sec);
+		else
+			ret = test_mb_ahash_cycles(data, speed[i].blen);
+
+		if (ret) {
+			pr_err("hashing failed ret=%d\n", ret);
+			break;
+		}
+
+		/* a lone request has nobody to share the lanes with */
+		cycles = 0;
+		for (j = 0; j < 8; j++) {
+			cycles_t start, end;
+
+			start = get_cycles();
+
+			ret = do_one_ahash_op(data[0].req,
+					      crypto_ahash_digest(data[0].req));
+			if (ret)
+				break;
+
+			end = get_cycles();
+
+			cycles += end - start;
+		}
+
+		if (ret) {
+			pr_err("hashing failed ret=%d\n", ret);
+			break;
+		}
+
+		pr_cont("%8lu cycles latency\n", cycles / 8);
+	}
+
+out_free_req:
+	for (i = 0; i < MB_WIDTH; i++)
+		ahash_request_free(data[i].req);
+out:
+	crypto_free_ahash(tfm);
+free_data:
+	kfree(data);
+}
+
 static inline int do_one_acipher_op(struct ablkcipher_request *req, int ret)
 {
 	if (ret == -EINPROGRESS || ret == -EBUSY) {
@@ -932,6 +1133,429 @@ out:
 	crypto_free_ablkcipher(tfm);
 }
 
+static inline int do_one_aead_op(struct aead_request *req, int ret)
+{
+	if (ret == -EINPROGRESS || ret == -EBUSY) {
+		struct tcrypt_result *tr = req->base.data;
+
+		ret = wait_for_completion_interruptible(&tr->completion);
+		if (!ret)
+			ret = tr->err;
+		INIT_COMPLETION(tr->completion);
+	}
+
+	return ret;
+}
+
+static int test_aead_jiffies(struct aead_request *req, int enc,
+			     int blen, int sec)
+{
+	unsigned long start, end;
+	int bcount;
+	int ret;
+
+	for (start = jiffies, end = start + sec * HZ, bcount = 0;
+	     time_before(jiffies, end); bcount++) {
+		if (enc)
+			ret = do_one_aead_op(req, crypto_aead_encrypt(req));
+		else
+			ret = do_one_aead_op(req, crypto_aead_decrypt(req));
+
+		if (ret)
+			return ret;
+	}
+
+	pr_cont("%d operations in %d seconds (%ld bytes)\n",
+		bcount, sec, (long)bcount * blen);
+	return 0;
+}
+
+static int test_aead_cycles(struct aead_request *req, int enc, int blen)
+{
+	unsigned long cycles = 0;
+	int ret = 0;
+	int i;
+
+	/* Warm-up run. */
+	for (i = 0; i < 4; i++) {
+		if (enc)
+			ret = do_one_aead_op(req, crypto_aead_encrypt(req));
+		else
+			ret = do_one_aead_op(req, crypto_aead_decrypt(req));
+
+		if (ret)
+			goto out;
+	}
+
+	/* The real thing. */
+	for (i = 0; i < 8; i++) {
+		cycles_t start, end;
+
+		start = get_cycles();
+		if (enc)
+			ret = do_one_aead_op(req, crypto_aead_encrypt(req));
+		else
+			ret = do_one_aead_op(req, crypto_aead_decrypt(req));
+		end = get_cycles();
+
+		if (ret)
+			goto out;
+
+		cycles += end - start;
+	}
+
+out:
+	if (ret == 0)
+		pr_cont("1 operation in %lu cycles (%d bytes)\n",
+			(cycles + 4) / 8, blen);
+
+	return ret;
+}
+
+/*
+ * The plaintext is in the tvmem pages, and the ciphertext goes to a
+ * separate buffer: decryption is timed from there, after one encryption,
+ * so that every run sees a valid tag.
+ */
+static void test_aead_speed(const char *algo, int enc, unsigned int sec,
+			    unsigned int aad_size, unsigned int authsize,
+			    u8 *keysize)
+{
+	unsigned int ret, i, j, k, iv_len;
+	struct tcrypt_result tresult;
+	const char *key;
+	char iv[128];
+	struct aead_request *req;
+	struct crypto_aead *tfm;
+	struct scatterlist asg, dsg;
+	u8 *assoc, *xbuf;
+	const char *e;
+	u32 *b_size;
+
+	if (enc == ENCRYPT)
+		e = "encryption";
+	else
+		e = "decryption";
+
+	pr_info("\ntesting speed of %s %s\n", algo, e);
+
+	init_completion(&tresult.completion);
+
+	assoc = kmalloc(aad_size, GFP_KERNEL);
+	xbuf = kmalloc(TVMEMSIZE * PAGE_SIZE, GFP_KERNEL);
+	if (!assoc || !xbuf)
+		goto out_free_buf;
+	memset(assoc, 0xff, aad_size);
+	sg_init_one(&asg, assoc, aad_size);
+
+	tfm = crypto_alloc_aead(algo, 0, 0);
+
+	if (IS_ERR(tfm)) {
+		pr_err("failed to load transform for %s: %ld\n", algo,
+		       PTR_ERR(tfm));
+		goto out_free_buf;
+	}
+
+	ret = crypto_aead_setauthsize(tfm, authsize);
+	if (ret) {
+		pr_err("setauthsize() failed for %s: %d\n", algo, ret);
+		goto out;
+	}
+
+	req = aead_request_alloc(tfm, GFP_KERNEL);
+	if (!req) {
+		pr_err("tcrypt: aead: Failed to allocate request for %s\n",
+		       algo);
+		goto out;
+	}
+
+	aead_request_set_callback(req, CRYPTO_TFM_REQ_MAY_BACKLOG,
+				  tcrypt_complete, &tresult);
+
+	i = 0;
+	do {
+		b_size = block_sizes;
+
+		do {
+			struct scatterlist sg[TVMEMSIZE];
+
+			if ((*keysize + *b_size + authsize) >
+			    TVMEMSIZE * PAGE_SIZE) {
+				pr_err("template (%u) too big for "
+				       "tvmem (%lu)\n", *keysize + *b_size,
+				       TVMEMSIZE * PAGE_SIZE);
+				goto out_free_req;
+			}
+
+			pr_info("test %u (%d bit key, %d byte blocks): ", i,
+				*keysize * 8, *b_size);
+
+			memset(tvmem[0], 0xff, PAGE_SIZE);
+
+			/* set key, plain text and IV */
+			key = tvmem[0];
+
+			crypto_aead_clear_flags(tfm, ~0);
+
+			ret = crypto_aead_setkey(tfm, key, *keysize);
+			if (ret) {
+				pr_err("setkey() failed flags=%x\n",
+					crypto_aead_get_flags(tfm));
+				goto out_free_req;
+			}
+
+			sg_init_table(sg, TVMEMSIZE);
+
+			k = *keysize + *b_size + authsize;
+			if (k > PAGE_SIZE) {
+				sg_set_buf(sg, tvmem[0] + *keysize,
+				   PAGE_SIZE - *keysize);
+				k -= PAGE_SIZE;
+				j = 1;
+				while (k > PAGE_SIZE) {
+					sg_set_buf(sg + j, tvmem[j], PAGE_SIZE);
+					memset(tvmem[j], 0xff, PAGE_SIZE);
+					j++;
+					k -= PAGE_SIZE;
+				}
+				sg_set_buf(sg + j, tvmem[j], k);
+				memset(tvmem[j], 0xff, k);
+			} else {
+				sg_set_buf(sg, tvmem[0] + *keysize,
+					   *b_size + authsize);
+			}
+			sg_init_one(&dsg, xbuf, *b_size + authsize);
+
+			iv_len = crypto_aead_ivsize(tfm);
+			if (iv_len)
+				memset(&iv, 0xff, iv_len);
+
+			aead_request_set_assoc(req, &asg, aad_size);
+			aead_request_set_crypt(req, sg, &dsg, *b_size, iv);
+
+			if (enc == DECRYPT) {
+				ret = do_one_aead_op(req,
+						     crypto_aead_encrypt(req));
+				if (ret) {
+					pr_err("encryption failed: %d\n", ret);
+					break;
+				}
+				aead_request_set_crypt(req, &dsg, sg,
+						       *b_size + authsize, iv);
+			}
+
+			if (sec)
+				ret = test_aead_jiffies(req, enc, *b_size,
+							sec);
+			else
+				ret = test_aead_cycles(req, enc, *b_size);
+
+			if (ret) {
+				pr_err("%s() failed flags=%x\n", e,
+					crypto_aead_get_flags(tfm));
+				break;
+			}
+			b_size++;
+			i++;
+		} while (*b_size);
+		keysize++;
+	} while (*keysize);
+
+out_free_req:
+	aead_request_free(req);
+out:
+	crypto_free_aead(tfm);
+out_free_buf:
+	kfree(xbuf);
+	kfree(assoc);
+}
+
+/*
+ * Used by test_comp_speed(): page sized inputs ranging from trivially
+ * compressible to incompressible, resembling what zram and the
+ * filesystems feed their compressors.
+ */
+enum comp_speed_input {
+	COMP_INPUT_ZERO,
+	COMP_INPUT_TEXT,
+	COMP_INPUT_STRUCT,
+	COMP_INPUT_RANDOM,
+	COMP_INPUT_MAX
+};
+
+static const char *comp_speed_input_names[] = {
+	"zero", "text", "struct", "random"
+};
+
+static void test_comp_fill(char *buf, enum comp_speed_input input)
+{
+	static const char text[] =
+		"The quick brown fox jumps over the lazy dog; ";
+	u32 *words = (u32 *)buf;
+	int i;
+
+	switch (input) {
+	case COMP_INPUT_ZERO:
+		memset(buf, 0, PAGE_SIZE);
+		break;
+	case COMP_INPUT_TEXT:
+		for (i = 0; i < PAGE_SIZE; i++)
+			buf[i] = text[(i + i / 97) % (sizeof(text) - 1)];
+		break;
+	case COMP_INPUT_STRUCT:
+		/* array of small records: counters, flags and pointers */
+		for (i = 0; i < PAGE_SIZE / sizeof(u32); i += 4) {
+			words[i] = i;
+			words[i + 1] = 0;
+			words[i + 2] = 0xffff8800 + (i & 0x30);
+			words[i + 3] = i % 12 ? 1 : 0x80000000;
+		}
+		break;
+	default:
+		get_random_bytes(buf, PAGE_SIZE);
+		break;
+	}
+}
+
+static int test_comp_op(struct crypto_comp *tfm, int comp, const char *src,
+			unsigned int slen, char *dst, unsigned int *dlen)
+{
+	*dlen = 2 * PAGE_SIZE;
+	if (comp)
+		return crypto_comp_compress(tfm, src, slen, dst, dlen);
+	return crypto_comp_decompress(tfm, src, slen, dst, dlen);
+}
+
+static int test_comp_jiffies(struct crypto_comp *tfm, int comp,
+			     const char *src, unsigned int slen, char *dst,
+			     int sec)
+{
+	unsigned long start, end;
+	unsigned int dlen;
+	int bcount;
+	int ret;
+
+	for (start = jiffies, end = start + sec * HZ, bcount = 0;
+	     time_before(jiffies, end); bcount++) {
+		ret = test_comp_op(tfm, comp, src, slen, dst, &dlen);
+		if (ret)
+			return ret;
+	}
+
+	printk("%6d opers/sec, %9lu bytes/sec\n",
+	       bcount / sec, ((long)bcount * PAGE_SIZE) / sec);
+	return 0;
+}
+
+static int test_comp_cycles(struct crypto_comp *tfm, int comp,
+			    const char *src, unsigned int slen, char *dst)
+{
+	unsigned long cycles = 0;
+	unsigned int dlen;
+	int ret = 0;
+	int i;
+
+	local_bh_disable();
+	local_irq_disable();
+
+	/* Warm-up run. */
+	for (i = 0; i < 4; i++) {
+		ret = test_comp_op(tfm, comp, src, slen, dst, &dlen);
+		if (ret)
+			goto out;
+	}
+
+	/* The real thing. */
+	for (i = 0; i < 8; i++) {
+		cycles_t start, end;
+
+		start = get_cycles();
+		ret = test_comp_op(tfm, comp, src, slen, dst, &dlen);
+		end = get_cycles();
+
+		if (ret)
+			goto out;
+
+		cycles += end - start;
+	}
+
+out:
+	local_irq_enable();
+	local_bh_enable();
+
+	if (ret == 0)
+		printk("%6lu cycles/operation, %4lu cycles/byte\n",
+		       (cycles + 4) / 8, (cycles + 4) / (8 * PAGE_SIZE));
+
+	return ret;
+}
+
+static void test_comp_speed(const char *algo, unsigned int sec)
+{
+	struct crypto_comp *tfm;
+	char *src, *cbuf, *dbuf;
+	unsigned int clen, dlen;
+	int i, ret;
+
+	printk(KERN_INFO "\ntesting speed of %s compression\n", algo);
+
+	tfm = crypto_alloc_comp(algo, 0, 0);
+	if (IS_ERR(tfm)) {
+		printk(KERN_ERR "failed to load transform for %s: %ld\n", algo,
+		       PTR_ERR(tfm));
+		return;
+	}
+
+	src = tvmem[0];
+	cbuf = kmalloc(2 * PAGE_SIZE, GFP_KERNEL);
+	dbuf = kmalloc(2 * PAGE_SIZE, GFP_KERNEL);
+	if (!cbuf || !dbuf)
+		goto out;
+
+	for (i = 0; i < COMP_INPUT_MAX; i++) {
+		test_comp_fill(src, i);
+
+		ret = test_comp_op(tfm, 1, src, PAGE_SIZE, cbuf, &clen);
+		if (ret) {
+			printk(KERN_ERR "%s: compression failed ret=%d\n",
+			       comp_speed_input_names[i], ret);
+			continue;
+		}
+		ret = test_comp_op(tfm, 0, cbuf, clen, dbuf, &dlen);
+		if (ret || dlen != PAGE_SIZE || memcmp(src, dbuf, PAGE_SIZE)) {
+			printk(KERN_ERR "%s: round trip failed ret=%d\n",
+			       comp_speed_input_names[i], ret);
+			continue;
+		}
+
+		printk(KERN_INFO "%-6s: %4lu -> %4u bytes (%3lu%%)\n",
+		       comp_speed_input_names[i], PAGE_SIZE, clen,
+		       clen * 100 / PAGE_SIZE);
+
+		printk(KERN_INFO "%-6s:   compress ", comp_speed_input_names[i]);
+		if (sec)
+			ret = test_comp_jiffies(tfm, 1, src, PAGE_SIZE, dbuf,
+						sec);
+		else
+			ret = test_comp_cycles(tfm, 1, src, PAGE_SIZE, dbuf);
+		if (ret)
+			break;
+
+		printk(KERN_INFO "%-6s: decompress ", comp_speed_input_names[i]);
+		if (sec)
+			ret = test_comp_jiffies(tfm, 0, cbuf, clen, dbuf, sec);
+		else
+			ret = test_comp_cycles(tfm, 0, cbuf, clen, dbuf);
+		if (ret)
+			break;
+	}
+
+out:
+	kfree(dbuf);
+	kfree(cbuf);
+	crypto_free_comp(tfm);
+}
+
 static void test_available(void)
 {
 	char **name = check;
@@ -1165,6 +1789,30 @@ static int do_test(int m)
 		ret += tcrypt_test("rfc4309(ccm(aes))");
 		break;
 
+	case 46:
+		ret += tcrypt_test("lz4");
+		break;
+
+	case 47:
+		ret += tcrypt_test("lz4hc");
+		break;
+
+	case 48:
+		ret += tcrypt_test("crc32");
+		break;
+
+	case 49:
+		ret += tcrypt_test("crct10dif");
+		break;
+
+	case 50:
+		ret += tcrypt_test("chacha20");
+		break;
+
+	case 51:
+		ret += tcrypt_test("poly1305");
+		break;
+
 	case 100:
 		ret += tcrypt_test("hmac(md5)");
 		break;
@@ -1216,6 +1864,14 @@ static int do_test(int m)
 		ret += tcrypt_test("rfc4106(gcm(aes))");
 		break;
 
+	case 152:
+		ret += tcrypt_test("rfc7539(chacha20,poly1305)");
+		break;
+
+	case 153:
+		ret += tcrypt_test("rfc7539esp(chacha20,poly1305)");
+		break;
+
 	case 200:
 		test_cipher_speed("ecb(aes)", ENCRYPT, sec, NULL, 0,
 				speed_template_16_24_32);
@@ -1359,6 +2015,32 @@ static int do_test(int m)
 				  speed_template_8);
 		break;
 
+	case 211:
+		test_aead_speed("rfc4106(gcm(aes))", ENCRYPT, sec, 8, 16,
+				speed_template_20_28_36);
+		test_aead_speed("rfc4106(gcm(aes))", DECRYPT, sec, 8, 16,
+				speed_template_20_28_36);
+		break;
+
+	case 212:
+		test_aead_speed("gcm(aes)", ENCRYPT, sec, 16, 16,
+				speed_template_16_24_32);
+		test_aead_speed("gcm(aes)", DECRYPT, sec, 16, 16,
+				speed_template_16_24_32);
+		break;
+
+	case 213:
+		test_cipher_speed("chacha20", ENCRYPT, sec, NULL, 0,
+				  speed_template_32);
+		break;
+
+	case 214:
+		test_aead_speed("rfc7539esp(chacha20,poly1305)", ENCRYPT, sec,
+				8, 16, speed_template_36);
+		test_aead_speed("rfc7539esp(chacha20,poly1305)", DECRYPT, sec,
+				8, 16, speed_template_36);
+		break;
+
 	case 300:
 		/* fall through */
 
@@ -1434,6 +2116,36 @@ static int do_test(int m)
 		test_hash_speed("ghash-generic", sec, hash_speed_template_16);
 		if (mode > 300 && mode < 400) break;
 
+	case 319:
+		test_hash_speed("crc32c", sec, generic_hash_speed_template);
+		if (mode > 300 && mode < 400) break;
+
+	case 320:
+		test_hash_speed("crc32", sec, generic_hash_speed_template);
+		if (mode > 300 && mode < 400) break;
+
+	case 321:
+		test_hash_speed("crct10dif", sec, generic_hash_speed_template);
+		if (mode > 300 && mode < 400) break;
+
+	case 322:
+		test_hash_speed("sha256-generic", sec,
+				generic_hash_speed_template);
+		test_hash_speed("sha256-ssse3", sec,
+				generic_hash_speed_template);
+		if (mode > 300 && mode < 400) break;
+
+	case 323:
+		test_hash_speed("sha512-generic", sec,
+				generic_hash_speed_template);
+		test_hash_speed("sha512-ssse3", sec,
+				generic_hash_speed_template);
+		if (mode > 300 && mode < 400) break;
+
+	case 324:
+		test_hash_speed("poly1305", sec, poly1305_speed_template);
+		if (mode > 300 && mode < 400) break;
+
 	case 399:
 		break;
 
@@ -1508,6 +2220,15 @@ static int do_test(int m)
 		test_ahash_speed("rmd320", sec, generic_hash_speed_template);
 		if (mode > 400 && mode < 500) break;
 
+	case 418:
+		test_mb_ahash_speed("sha1-mb", sec, generic_hash_speed_template);
+		if (mode > 400 && mode < 500) break;
+
+	case 419:
+		test_mb_ahash_speed("sha256-mb", sec,
+				    generic_hash_speed_template);
+		if (mode > 400 && mode < 500) break;
+
 	case 499:
 		break;
 
@@ -1639,6 +2360,28 @@ static int do_test(int m)
 				   speed_template_8);
 		break;
 
+	case 600:
+		/* fall through */
+
+	case 601:
+		test_comp_speed("lzo", sec);
+		if (mode > 600 && mode < 700) break;
+
+	case 602:
+		test_comp_speed("lz4", sec);
+		if (mode > 600 && mode < 700) break;
+
+	case 603:
+		test_comp_speed("lz4hc", sec);
+		if (mode > 600 && mode < 700) break;
+
+	case 604:
+		test_comp_speed("deflate", sec);
+		if (mode > 600 && mode < 700) break;
+
+	case 699:
+		break;
+
 	case 1000:
 		test_available();
 		break;
@@ -41,7 +41,7 @@ struct hash_testvec {
 	char *plaintext;
 	char *digest;
 	unsigned char tap[MAX_TAP];
-	unsigned char psize;
+	unsigned short psize;
 	unsigned char np;
 	unsigned char ksize;
 };
@@ -528,7 +528,7 @@ static struct hash_testvec sha224_tv_template[] = {
 /*
  * SHA256 test vectors from from NIST
  */
-#define SHA256_TEST_VECTORS	2
+#define SHA256_TEST_VECTORS	3
 
 static struct hash_testvec sha256_tv_template[] = {
 	{
@@ -547,6 +547,22 @@ static struct hash_testvec sha256_tv_template[] = {
 			  "\xf6\xec\xed\xd4\x19\xdb\x06\xc1",
 		.np	= 2,
 		.tap	= { 28, 28 }
+	}, {
+		.plaintext = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz",
+		.psize	= 520,
+		.digest	= "\xa9\x93\x39\xc6\xd1\xc1\xc0\xb0"
+			  "\x55\xda\x93\x14\xf6\xd9\x98\x45"
+			  "\x27\xfb\x5f\x68\x59\xf9\x10\x85"
+			  "\x8d\x5d\x5e\x86\xb6\xa7\x82\x40",
 	},
 };
 
@@ -602,7 +618,7 @@ static struct hash_testvec sha384_tv_template[] = {
 /*
  * SHA512 test vectors from from NIST and kerneli
  */
-#define SHA512_TEST_VECTORS	4
+#define SHA512_TEST_VECTORS	5
 
 static struct hash_testvec sha512_tv_template[] = {
 	{
@@ -653,6 +669,26 @@ static struct hash_testvec sha512_tv_template[] = {
 			  "\xed\xb4\x19\x87\x23\x28\x50\xc9",
 		.np	= 4,
 		.tap	= { 26, 26, 26, 26 }
+	}, {
+		.plaintext = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+			     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz",
+		.psize	= 520,
+		.digest	= "\x04\x49\x9d\x4d\x7e\xe9\xf8\x0c"
+			  "\xbf\xe8\xa9\x20\xf6\x23\x6e\xcc"
+			  "\xfa\x11\x22\xd4\x17\x10\xb3\xfb"
+			  "\x43\xc4\xdd\x05\x2b\x3b\x58\xf6"
+			  "\x36\x46\x8d\x74\x6a\x41\xeb\xc0"
+			  "\x76\x2f\x73\xee\x03\x31\x30\x8f"
+			  "\xf4\xfa\x48\x3d\x79\x96\x4e\xda"
+			  "\x2f\xa7\xae\x84\x46\x1b\x1b\x5a",
 	},
 };
 
@@ -12028,6 +12064,214 @@ static struct aead_testvec aes_ccm_rfc4309_dec_tv_template[] = {
 	},
 };
 
+/*
+ * ChaCha20-Poly1305 AEAD test vectors from RFC7539
+ */
+#define RFC7539_ENC_TEST_VECTORS 1
+#define RFC7539_DEC_TEST_VECTORS 1
+#define RFC7539ESP_ENC_TEST_VECTORS 1
+#define RFC7539ESP_DEC_TEST_VECTORS 1
+
+static struct aead_testvec rfc7539_enc_tv_template[] = {
+	{ /* RFC7539 2.8.2 */
+		.key	= "\x80\x81\x82\x83\x84\x85\x86\x87"
+			  "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+			  "\x90\x91\x92\x93\x94\x95\x96\x97"
+			  "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f",
+		.klen	= 32,
+		.iv	= "\x07\x00\x00\x00\x40\x41\x42\x43"
+			  "\x44\x45\x46\x47",
+		.assoc	= "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+			  "\xc4\xc5\xc6\xc7",
+		.alen	= 12,
+		.input	= "\x4c\x61\x64\x69\x65\x73\x20\x61"
+			  "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+			  "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+			  "\x74\x68\x65\x20\x63\x6c\x61\x73"
+			  "\x73\x20\x6f\x66\x20\x27\x39\x39"
+			  "\x3a\x20\x49\x66\x20\x49\x20\x63"
+			  "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+			  "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+			  "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+			  "\x74\x69\x70\x20\x66\x6f\x72\x20"
+			  "\x74\x68\x65\x20\x66\x75\x74\x75"
+			  "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+			  "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+			  "\x75\x6c\x64\x20\x62\x65\x20\x69"
+			  "\x74\x2e",
+		.ilen	= 114,
+		.result	= "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+			  "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+			  "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+			  "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+			  "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+			  "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+			  "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+			  "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+			  "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+			  "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+			  "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+			  "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+			  "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+			  "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+			  "\x61\x16\x1a\xe1\x0b\x59\x4f\x09"
+			  "\xe2\x6a\x7e\x90\x2e\xcb\xd0\x60"
+			  "\x06\x91",
+		.rlen	= 130,
+	},
+};
+
+static struct aead_testvec rfc7539_dec_tv_template[] = {
+	{ /* RFC7539 2.8.2 */
+		.key	= "\x80\x81\x82\x83\x84\x85\x86\x87"
+			  "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+			  "\x90\x91\x92\x93\x94\x95\x96\x97"
+			  "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f",
+		.klen	= 32,
+		.iv	= "\x07\x00\x00\x00\x40\x41\x42\x43"
+			  "\x44\x45\x46\x47",
+		.assoc	= "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+			  "\xc4\xc5\xc6\xc7",
+		.alen	= 12,
+		.input	= "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+			  "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+			  "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+			  "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+			  "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+			  "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+			  "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+			  "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+			  "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+			  "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+			  "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+			  "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+			  "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+			  "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+			  "\x61\x16\x1a\xe1\x0b\x59\x4f\x09"
+			  "\xe2\x6a\x7e\x90\x2e\xcb\xd0\x60"
+			  "\x06\x91",
+		.ilen	= 130,
+		.result	= "\x4c\x61\x64\x69\x65\x73\x20\x61"
+			  "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+			  "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+			  "\x74\x68\x65\x20\x63\x6c\x61\x73"
+			  "\x73\x20\x6f\x66\x20\x27\x39\x39"
+			  "\x3a\x20\x49\x66\x20\x49\x20\x63"
+			  "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+			  "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+			  "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+			  "\x74\x69\x70\x20\x66\x6f\x72\x20"
+			  "\x74\x68\x65\x20\x66\x75\x74\x75"
+			  "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+			  "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+			  "\x75\x6c\x64\x20\x62\x65\x20\x69"
+			  "\x74\x2e",
+		.rlen	= 114,
+	},
+};
+
+/*
+ * The same with the first four bytes of the nonce passed as a salt after
+ * the key, as ESP does (RFC7634).
+ */
+static struct aead_testvec rfc7539esp_enc_tv_template[] = {
+	{ /* RFC7539 2.8.2 */
+		.key	= "\x80\x81\x82\x83\x84\x85\x86\x87"
+			  "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+			  "\x90\x91\x92\x93\x94\x95\x96\x97"
+			  "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f"
+			  "\x07\x00\x00\x00",
+		.klen	= 36,
+		.iv	= "\x40\x41\x42\x43\x44\x45\x46\x47",
+		.assoc	= "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+			  "\xc4\xc5\xc6\xc7",
+		.alen	= 12,
+		.input	= "\x4c\x61\x64\x69\x65\x73\x20\x61"
+			  "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+			  "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+			  "\x74\x68\x65\x20\x63\x6c\x61\x73"
+			  "\x73\x20\x6f\x66\x20\x27\x39\x39"
+			  "\x3a\x20\x49\x66\x20\x49\x20\x63"
+			  "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+			  "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+			  "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+			  "\x74\x69\x70\x20\x66\x6f\x72\x20"
+			  "\x74\x68\x65\x20\x66\x75\x74\x75"
+			  "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+			  "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+			  "\x75\x6c\x64\x20\x62\x65\x20\x69"
+			  "\x74\x2e",
+		.ilen	= 114,
+		.result	= "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+			  "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+			  "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+			  "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+			  "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+			  "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+			  "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+			  "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+			  "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+			  "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+			  "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+			  "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+			  "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+			  "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+			  "\x61\x16\x1a\xe1\x0b\x59\x4f\x09"
+			  "\xe2\x6a\x7e\x90\x2e\xcb\xd0\x60"
+			  "\x06\x91",
+		.rlen	= 130,
+	},
+};
+
+static struct aead_testvec rfc7539esp_dec_tv_template[] = {
+	{ /* RFC7539 2.8.2 */
+		.key	= "\x80\x81\x82\x83\x84\x85\x86\x87"
+			  "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+			  "\x90\x91\x92\x93\x94\x95\x96\x97"
+			  "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f"
+			  "\x07\x00\x00\x00",
+		.klen	= 36,
+		.iv	= "\x40\x41\x42\x43\x44\x45\x46\x47",
+		.assoc	= "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+			  "\xc4\xc5\xc6\xc7",
+		.alen	= 12,
+		.input	= "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+			  "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+			  "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+			  "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+			  "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+			  "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+			  "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+			  "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+			  "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+			  "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+			  "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+			  "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+			  "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+			  "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+			  "\x61\x16\x1a\xe1\x0b\x59\x4f\x09"
+			  "\xe2\x6a\x7e\x90\x2e\xcb\xd0\x60"
+			  "\x06\x91",
+		.ilen	= 130,
+		.result	= "\x4c\x61\x64\x69\x65\x73\x20\x61"
+			  "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+			  "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+			  "\x74\x68\x65\x20\x63\x6c\x61\x73"
+			  "\x73\x20\x6f\x66\x20\x27\x39\x39"
+			  "\x3a\x20\x49\x66\x20\x49\x20\x63"
+			  "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+			  "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+			  "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+			  "\x74\x69\x70\x20\x66\x6f\x72\x20"
+			  "\x74\x68\x65\x20\x66\x75\x74\x75"
+			  "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+			  "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+			  "\x75\x6c\x64\x20\x62\x65\x20\x69"
+			  "\x74\x2e",
+		.rlen	= 114,
+	},
+};
+
 /*
  * ANSI X9.31 Continuous Pseudo-Random Number Generator (AES mode)
  * test vectors, taken from Appendix B.2.9 and B.2.10:
@@ -15806,6 +16050,451 @@ static struct cipher_testvec salsa20_stream_enc_tv_template[] = {
 	},
 };
 
+/*
+ * ChaCha20 test vectors from RFC7539 A.2.  The IV is the 32-bit block
+ * counter followed by the 96-bit nonce, both little endian.
+ */
+#define CHACHA20_ENC_TEST_VECTORS 4
+static struct cipher_testvec chacha20_enc_tv_template[] = {
+	{ /* RFC7539 A.2. Test Vector #1 */
+		.key	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+		.klen	= 32,
+		.iv	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+		.input	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+		.ilen	= 64,
+		.result	= "\x76\xb8\xe0\xad\xa0\xf1\x3d\x90"
+			  "\x40\x5d\x6a\xe5\x53\x86\xbd\x28"
+			  "\xbd\xd2\x19\xb8\xa0\x8d\xed\x1a"
+			  "\xa8\x36\xef\xcc\x8b\x77\x0d\xc7"
+			  "\xda\x41\x59\x7c\x51\x57\x48\x8d"
+			  "\x77\x24\xe0\x3f\xb8\xd8\x4a\x37"
+			  "\x6a\x43\xb8\xf4\x15\x18\xa1\x1c"
+			  "\xc3\x87\xb6\x69\xb2\xee\x65\x86",
+		.rlen	= 64,
+	}, { /* RFC7539 A.2. Test Vector #2 */
+		.key	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x01",
+		.klen	= 32,
+		.iv	= "\x01\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x02",
+		.input	= "\x41\x6e\x79\x20\x73\x75\x62\x6d"
+			  "\x69\x73\x73\x69\x6f\x6e\x20\x74"
+			  "\x6f\x20\x74\x68\x65\x20\x49\x45"
+			  "\x54\x46\x20\x69\x6e\x74\x65\x6e"
+			  "\x64\x65\x64\x20\x62\x79\x20\x74"
+			  "\x68\x65\x20\x43\x6f\x6e\x74\x72"
+			  "\x69\x62\x75\x74\x6f\x72\x20\x66"
+			  "\x6f\x72\x20\x70\x75\x62\x6c\x69"
+			  "\x63\x61\x74\x69\x6f\x6e\x20\x61"
+			  "\x73\x20\x61\x6c\x6c\x20\x6f\x72"
+			  "\x20\x70\x61\x72\x74\x20\x6f\x66"
+			  "\x20\x61\x6e\x20\x49\x45\x54\x46"
+			  "\x20\x49\x6e\x74\x65\x72\x6e\x65"
+			  "\x74\x2d\x44\x72\x61\x66\x74\x20"
+			  "\x6f\x72\x20\x52\x46\x43\x20\x61"
+			  "\x6e\x64\x20\x61\x6e\x79\x20\x73"
+			  "\x74\x61\x74\x65\x6d\x65\x6e\x74"
+			  "\x20\x6d\x61\x64\x65\x20\x77\x69"
+			  "\x74\x68\x69\x6e\x20\x74\x68\x65"
+			  "\x20\x63\x6f\x6e\x74\x65\x78\x74"
+			  "\x20\x6f\x66\x20\x61\x6e\x20\x49"
+			  "\x45\x54\x46\x20\x61\x63\x74\x69"
+			  "\x76\x69\x74\x79\x20\x69\x73\x20"
+			  "\x63\x6f\x6e\x73\x69\x64\x65\x72"
+			  "\x65\x64\x20\x61\x6e\x20\x22\x49"
+			  "\x45\x54\x46\x20\x43\x6f\x6e\x74"
+			  "\x72\x69\x62\x75\x74\x69\x6f\x6e"
+			  "\x22\x2e\x20\x53\x75\x63\x68\x20"
+			  "\x73\x74\x61\x74\x65\x6d\x65\x6e"
+			  "\x74\x73\x20\x69\x6e\x63\x6c\x75"
+			  "\x64\x65\x20\x6f\x72\x61\x6c\x20"
+			  "\x73\x74\x61\x74\x65\x6d\x65\x6e"
+			  "\x74\x73\x20\x69\x6e\x20\x49\x45"
+			  "\x54\x46\x20\x73\x65\x73\x73\x69"
+			  "\x6f\x6e\x73\x2c\x20\x61\x73\x20"
+			  "\x77\x65\x6c\x6c\x20\x61\x73\x20"
+			  "\x77\x72\x69\x74\x74\x65\x6e\x20"
+			  "\x61\x6e\x64\x20\x65\x6c\x65\x63"
+			  "\x74\x72\x6f\x6e\x69\x63\x20\x63"
+			  "\x6f\x6d\x6d\x75\x6e\x69\x63\x61"
+			  "\x74\x69\x6f\x6e\x73\x20\x6d\x61"
+			  "\x64\x65\x20\x61\x74\x20\x61\x6e"
+			  "\x79\x20\x74\x69\x6d\x65\x20\x6f"
+			  "\x72\x20\x70\x6c\x61\x63\x65\x2c"
+			  "\x20\x77\x68\x69\x63\x68\x20\x61"
+			  "\x72\x65\x20\x61\x64\x64\x72\x65"
+			  "\x73\x73\x65\x64\x20\x74\x6f",
+		.ilen	= 375,
+		.result	= "\xa3\xfb\xf0\x7d\xf3\xfa\x2f\xde"
+			  "\x4f\x37\x6c\xa2\x3e\x82\x73\x70"
+			  "\x41\x60\x5d\x9f\x4f\x4f\x57\xbd"
+			  "\x8c\xff\x2c\x1d\x4b\x79\x55\xec"
+			  "\x2a\x97\x94\x8b\xd3\x72\x29\x15"
+			  "\xc8\xf3\xd3\x37\xf7\xd3\x70\x05"
+			  "\x0e\x9e\x96\xd6\x47\xb7\xc3\x9f"
+			  "\x56\xe0\x31\xca\x5e\xb6\x25\x0d"
+			  "\x40\x42\xe0\x27\x85\xec\xec\xfa"
+			  "\x4b\x4b\xb5\xe8\xea\xd0\x44\x0e"
+			  "\x20\xb6\xe8\xdb\x09\xd8\x81\xa7"
+			  "\xc6\x13\x2f\x42\x0e\x52\x79\x50"
+			  "\x42\xbd\xfa\x77\x73\xd8\xa9\x05"
+			  "\x14\x47\xb3\x29\x1c\xe1\x41\x1c"
+			  "\x68\x04\x65\x55\x2a\xa6\xc4\x05"
+			  "\xb7\x76\x4d\x5e\x87\xbe\xa8\x5a"
+			  "\xd0\x0f\x84\x49\xed\x8f\x72\xd0"
+			  "\xd6\x62\xab\x05\x26\x91\xca\x66"
+			  "\x42\x4b\xc8\x6d\x2d\xf8\x0e\xa4"
+			  "\x1f\x43\xab\xf9\x37\xd3\x25\x9d"
+			  "\xc4\xb2\xd0\xdf\xb4\x8a\x6c\x91"
+			  "\x39\xdd\xd7\xf7\x69\x66\xe9\x28"
+			  "\xe6\x35\x55\x3b\xa7\x6c\x5c\x87"
+			  "\x9d\x7b\x35\xd4\x9e\xb2\xe6\x2b"
+			  "\x08\x71\xcd\xac\x63\x89\x39\xe2"
+			  "\x5e\x8a\x1e\x0e\xf9\xd5\x28\x0f"
+			  "\xa8\xca\x32\x8b\x35\x1c\x3c\x76"
+			  "\x59\x89\xcb\xcf\x3d\xaa\x8b\x6c"
+			  "\xcc\x3a\xaf\x9f\x39\x79\xc9\x2b"
+			  "\x37\x20\xfc\x88\xdc\x95\xed\x84"
+			  "\xa1\xbe\x05\x9c\x64\x99\xb9\xfd"
+			  "\xa2\x36\xe7\xe8\x18\xb0\x4b\x0b"
+			  "\xc3\x9c\x1e\x87\x6b\x19\x3b\xfe"
+			  "\x55\x69\x75\x3f\x88\x12\x8c\xc0"
+			  "\x8a\xaa\x9b\x63\xd1\xa1\x6f\x80"
+			  "\xef\x25\x54\xd7\x18\x9c\x41\x1f"
+			  "\x58\x69\xca\x52\xc5\xb8\x3f\xa3"
+			  "\x6f\xf2\x16\xb9\xc1\xd3\x00\x62"
+			  "\xbe\xbc\xfd\x2d\xc5\xbc\xe0\x91"
+			  "\x19\x34\xfd\xa7\x9a\x86\xf6\xe6"
+			  "\x98\xce\xd7\x59\xc3\xff\x9b\x64"
+			  "\x77\x33\x8f\x3d\xa4\xf9\xcd\x85"
+			  "\x14\xea\x99\x82\xcc\xaf\xb3\x41"
+			  "\xb2\x38\x4d\xd9\x02\xf3\xd1\xab"
+			  "\x7a\xc6\x1d\xd2\x9c\x6f\x21\xba"
+			  "\x5b\x86\x2f\x37\x30\xe3\x7c\xfd"
+			  "\xc4\xfd\x80\x6c\x22\xf2\x21",
+		.rlen	= 375,
+	}, { /* RFC7539 A.2. Test Vector #3 */
+		.key	= "\x1c\x92\x40\xa5\xeb\x55\xd3\x8a"
+			  "\xf3\x33\x88\x86\x04\xf6\xb5\xf0"
+			  "\x47\x39\x17\xc1\x40\x2b\x80\x09"
+			  "\x9d\xca\x5c\xbc\x20\x70\x75\xc0",
+		.klen	= 32,
+		.iv	= "\x2a\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x02",
+		.input	= "\x27\x54\x77\x61\x73\x20\x62\x72"
+			  "\x69\x6c\x6c\x69\x67\x2c\x20\x61"
+			  "\x6e\x64\x20\x74\x68\x65\x20\x73"
+			  "\x6c\x69\x74\x68\x79\x20\x74\x6f"
+			  "\x76\x65\x73\x0a\x44\x69\x64\x20"
+			  "\x67\x79\x72\x65\x20\x61\x6e\x64"
+			  "\x20\x67\x69\x6d\x62\x6c\x65\x20"
+			  "\x69\x6e\x20\x74\x68\x65\x20\x77"
+			  "\x61\x62\x65\x3a\x0a\x41\x6c\x6c"
+			  "\x20\x6d\x69\x6d\x73\x79\x20\x77"
+			  "\x65\x72\x65\x20\x74\x68\x65\x20"
+			  "\x62\x6f\x72\x6f\x67\x6f\x76\x65"
+			  "\x73\x2c\x0a\x41\x6e\x64\x20\x74"
+			  "\x68\x65\x20\x6d\x6f\x6d\x65\x20"
+			  "\x72\x61\x74\x68\x73\x20\x6f\x75"
+			  "\x74\x67\x72\x61\x62\x65\x2e",
+		.ilen	= 127,
+		.result	= "\x62\xe6\x34\x7f\x95\xed\x87\xa4"
+			  "\x5f\xfa\xe7\x42\x6f\x27\xa1\xdf"
+			  "\x5f\xb6\x91\x10\x04\x4c\x0d\x73"
+			  "\x11\x8e\xff\xa9\x5b\x01\xe5\xcf"
+			  "\x16\x6d\x3d\xf2\xd7\x21\xca\xf9"
+			  "\xb2\x1e\x5f\xb1\x4c\x61\x68\x71"
+			  "\xfd\x84\xc5\x4f\x9d\x65\xb2\x83"
+			  "\x19\x6c\x7f\xe4\xf6\x05\x53\xeb"
+			  "\xf3\x9c\x64\x02\xc4\x22\x34\xe3"
+			  "\x2a\x35\x6b\x3e\x76\x43\x12\xa6"
+			  "\x1a\x55\x32\x05\x57\x16\xea\xd6"
+			  "\x96\x25\x68\xf8\x7d\x3f\x3f\x77"
+			  "\x04\xc6\xa8\xd1\xbc\xd1\xbf\x4d"
+			  "\x50\xd6\x15\x4b\x6d\xa7\x31\xb1"
+			  "\x87\xb5\x8d\xfd\x72\x8a\xfa\x36"
+			  "\x75\x7a\x79\x7a\xc1\x88\xd1",
+		.rlen	= 127,
+	}, { /* Long vector, crossing the SIMD strides */
+		.key	= "\x03\x0a\x11\x18\x1f\x26\x2d\x34"
+			  "\x3b\x42\x49\x50\x57\x5e\x65\x6c"
+			  "\x73\x7a\x81\x88\x8f\x96\x9d\xa4"
+			  "\xab\xb2\xb9\xc0\xc7\xce\xd5\xdc",
+		.klen	= 32,
+		.iv	= "\xfe\x00\x00\x00\x34\x41\x4e\x5b"
+			  "\x68\x75\x82\x8f\x9c\xa9\xb6\xc3",
+		.input	= "\x00\x1f\x3e\x5d\x7c\x9b\xba\xda"
+			  "\xf9\x18\x37\x56\x75\x94\xb4\xd3"
+			  "\xf2\x11\x30\x4f\x6e\x8e\xad\xcc"
+			  "\xeb\x0a\x29\x48\x68\x87\xa6\xc5"
+			  "\xe4\x03\x22\x42\x61\x80\x9f\xbe"
+			  "\xdd\xfc\x1c\x3b\x5a\x79\x98\xb7"
+			  "\xd6\xf6\x15\x34\x53\x72\x91\xb0"
+			  "\xd0\xef\x0e\x2d\x4c\x6b\x8a\xaa"
+			  "\xc9\xe8\x07\x26\x45\x64\x84\xa3"
+			  "\xc2\xe1\x00\x1f\x3e\x5e\x7d\x9c"
+			  "\xbb\xda\xf9\x18\x38\x57\x76\x95"
+			  "\xb4\xd3\xf2\x12\x31\x50\x6f\x8e"
+			  "\xad\xcc\xec\x0b\x2a\x49\x68\x87"
+			  "\xa6\xc6\xe5\x04\x23\x42\x61\x80"
+			  "\xa0\xbf\xde\xfd\x1c\x3b\x5a\x7a"
+			  "\x99\xb8\xd7\xf6\x15\x34\x54\x73"
+			  "\x92\xb1\xd0\xef\x0e\x2e\x4d\x6c"
+			  "\x8b\xaa\xc9\xe8\x08\x27\x46\x65"
+			  "\x84\xa3\xc2\xe2\x01\x20\x3f\x5e"
+			  "\x7d\x9c\xbc\xdb\xfa\x19\x38\x57"
+			  "\x76\x96\xb5\xd4\xf3\x12\x31\x50"
+			  "\x70\x8f\xae\xcd\xec\x0b\x2a\x4a"
+			  "\x69\x88\xa7\xc6\xe5\x04\x24\x43"
+			  "\x62\x81\xa0\xbf\xde\xfe\x1d\x3c"
+			  "\x5b\x7a\x99\xb8\xd8\xf7\x16\x35"
+			  "\x54\x73\x92\xb2\xd1\xf0\x0f\x2e"
+			  "\x4d\x6c\x8c\xab\xca\xe9\x08\x27"
+			  "\x46\x66\x85\xa4\xc3\xe2\x01\x20"
+			  "\x40\x5f\x7e\x9d\xbc\xdb\xfa\x1a"
+			  "\x39\x58\x77\x96\xb5\xd4\xf4\x13"
+			  "\x32\x51\x70\x8f\xae\xce\xed\x0c"
+			  "\x2b\x4a\x69\x88\xa8\xc7\xe6\x05"
+			  "\x24\x43\x62\x82\xa1\xc0\xdf\xfe"
+			  "\x1d\x3c\x5c\x7b\x9a\xb9\xd8\xf7"
+			  "\x16\x36\x55\x74\x93\xb2\xd1\xf0"
+			  "\x10\x2f\x4e\x6d\x8c\xab\xca\xea"
+			  "\x09\x28\x47\x66\x85\xa4\xc4\xe3"
+			  "\x02\x21\x40\x5f\x7e\x9e\xbd\xdc"
+			  "\xfb\x1a\x39\x58\x78\x97\xb6\xd5"
+			  "\xf4\x13\x32\x52\x71\x90\xaf\xce"
+			  "\xed\x0c\x2c\x4b\x6a\x89\xa8\xc7"
+			  "\xe6\x06\x25\x44\x63\x82\xa1\xc0"
+			  "\xe0\xff\x1e\x3d\x5c\x7b\x9a\xba"
+			  "\xd9\xf8\x17\x36\x55\x74\x94\xb3"
+			  "\xd2\xf1\x10\x2f\x4e\x6e\x8d\xac"
+			  "\xcb\xea\x09\x28\x48\x67\x86\xa5"
+			  "\xc4\xe3\x02\x22\x41\x60\x7f\x9e"
+			  "\xbd\xdc\xfc\x1b\x3a\x59\x78\x97"
+			  "\xb6\xd6\xf5\x14\x33\x52\x71\x90"
+			  "\xb0\xcf\xee\x0d\x2c\x4b\x6a\x8a"
+			  "\xa9\xc8\xe7\x06\x25\x44\x64\x83"
+			  "\xa2\xc1\xe0\xff\x1e\x3e\x5d\x7c"
+			  "\x9b\xba\xd9\xf8\x18\x37\x56\x75"
+			  "\x94\xb3\xd2\xf2\x11\x30\x4f\x6e"
+			  "\x8d\xac\xcc\xeb\x0a\x29\x48\x67"
+			  "\x86\xa6\xc5\xe4\x03\x22\x41\x60"
+			  "\x80\x9f\xbe\xdd\xfc\x1b\x3a\x5a"
+			  "\x79\x98\xb7\xd6\xf5\x14\x34\x53"
+			  "\x72\x91\xb0\xcf\xee\x0e\x2d\x4c"
+			  "\x6b\x8a\xa9\xc8\xe8\x07\x26\x45"
+			  "\x64\x83\xa2\xc2\xe1\x00\x1f\x3e"
+			  "\x5d\x7c\x9c\xbb\xda\xf9\x18\x37"
+			  "\x56\x76\x95\xb4\xd3\xf2\x11\x30"
+			  "\x50\x6f\x8e\xad\xcc\xeb\x0a\x2a"
+			  "\x49\x68\x87\xa6\xc5\xe4\x04\x23"
+			  "\x42\x61\x80\x9f\xbe\xde\xfd\x1c"
+			  "\x3b\x5a\x79\x98\xb8\xd7\xf6\x15"
+			  "\x34\x53\x72\x92\xb1\xd0\xef\x0e"
+			  "\x2d\x4c\x6c\x8b\xaa\xc9\xe8\x07"
+			  "\x26\x46\x65\x84\xa3\xc2\xe1\x00"
+			  "\x20\x3f\x5e\x7d\x9c\xbb\xda\xfa"
+			  "\x19\x38\x57\x76\x95\xb4\xd4\xf3"
+			  "\x12\x31\x50\x6f\x8e\xae\xcd\xec"
+			  "\x0b\x2a\x49\x68\x88\xa7\xc6\xe5"
+			  "\x04\x23\x42\x62\x81\xa0\xbf\xde"
+			  "\xfd\x1c\x3c\x5b\x7a\x99\xb8\xd7"
+			  "\xf6\x16\x35\x54\x73\x92\xb1\xd0"
+			  "\xf0\x0f\x2e\x4d\x6c\x8b\xaa\xca"
+			  "\xe9\x08\x27\x46\x65\x84\xa4\xc3"
+			  "\xe2\x01\x20\x3f\x5e\x7e\x9d\xbc"
+			  "\xdb\xfa\x19\x38\x58\x77\x96\xb5"
+			  "\xd4\xf3\x12\x32\x51\x70\x8f\xae"
+			  "\xcd\xec\x0c\x2b\x4a\x69\x88\xa7"
+			  "\xc6\xe6\x05\x24\x43\x62\x81\xa0"
+			  "\xc0\xdf\xfe\x1d\x3c\x5b\x7a\x9a"
+			  "\xb9\xd8\xf7\x16\x35\x54\x74\x93"
+			  "\xb2\xd1\xf0\x0f\x2e\x4e\x6d\x8c"
+			  "\xab\xca\xe9\x08\x28\x47\x66\x85"
+			  "\xa4\xc3\xe2\x02\x21\x40\x5f\x7e"
+			  "\x9d\xbc\xdc\xfb\x1a\x39\x58\x77"
+			  "\x96\xb6\xd5\xf4\x13\x32\x51\x70"
+			  "\x90\xaf\xce\xed\x0c\x2b\x4a\x6a"
+			  "\x89\xa8\xc7\xe6\x05\x24\x44\x63"
+			  "\x82\xa1\xc0\xdf\xfe\x1e\x3d\x5c"
+			  "\x7b\x9a\xb9\xd8\xf8\x17\x36\x55"
+			  "\x74\x93\xb2\xd2\xf1\x10\x2f\x4e"
+			  "\x6d\x8c\xac\xcb\xea\x09\x28\x47"
+			  "\x66\x86\xa5\xc4\xe3\x02\x21\x40"
+			  "\x60\x7f\x9e\xbd\xdc\xfb\x1a\x3a"
+			  "\x59\x78\x97\xb6\xd5\xf4\x14\x33"
+			  "\x52\x71\x90\xaf\xce\xee\x0d\x2c"
+			  "\x4b\x6a\x89\xa8\xc8\xe7\x06\x25"
+			  "\x44\x63\x82\xa2\xc1\xe0\xff\x1e"
+			  "\x3d\x5c\x7c\x9b\xba\xd9\xf8\x17"
+			  "\x36\x56\x75\x94\xb3\xd2\xf1\x10"
+			  "\x30\x4f\x6e\x8d\xac\xcb\xea\x0a"
+			  "\x29\x48\x67\x86\xa5\xc4\xe4\x03"
+			  "\x22\x41\x60\x7f\x9e\xbe\xdd\xfc"
+			  "\x1b\x3a\x59\x78\x98\xb7\xd6\xf5"
+			  "\x14\x33\x52\x72\x91\xb0\xcf\xee"
+			  "\x0d\x2c\x4c\x6b\x8a\xa9\xc8\xe7"
+			  "\x06\x26\x45\x64\x83\xa2\xc1\xe0"
+			  "\x00\x1f\x3e\x5d\x7c\x9b\xba\xda"
+			  "\xf9\x18\x37\x56\x75\x94\xb4\xd3"
+			  "\xf2\x11\x30\x4f\x6e\x8e\xad\xcc"
+			  "\xeb\x0a\x29\x48\x68\x87\xa6\xc5"
+			  "\xe4\x03\x22\x42\x61\x80\x9f\xbe"
+			  "\xdd\xfc\x1c\x3b\x5a\x79\x98\xb7"
+			  "\xd6\xf6\x15\x34\x53\x72\x91\xb0"
+			  "\xd0\xef\x0e\x2d\x4c\x6b\x8a\xaa"
+			  "\xc9\xe8\x07\x26\x45\x64\x84\xa3"
+			  "\xc2\xe1\x00\x1f\x3e\x5e\x7d\x9c"
+			  "\xbb\xda\xf9\x18\x38\x57\x76\x95"
+			  "\xb4\xd3\xf2\x12\x31\x50\x6f\x8e"
+			  "\xad\xcc\xec\x0b\x2a\x49\x68\x87"
+			  "\xa6",
+		.ilen	= 1001,
+		.result	= "\x22\x06\x27\xb8\x82\xe9\x27\x00"
+			  "\x4f\x96\x7c\x2f\x80\x05\x82\x00"
+			  "\xe0\xe5\x5a\x1b\xc1\x6b\xcc\xc8"
+			  "\xea\x22\x43\x9e\x59\x21\xe3\xf8"
+			  "\xb6\x49\x53\x16\x22\xb3\x5e\xb6"
+			  "\x64\x94\xdb\xbb\x49\xe7\x7a\xcd"
+			  "\xec\x3c\x06\xe5\xe9\x36\x02\x04"
+			  "\xb8\x89\xdd\xd9\x06\xfb\x7f\x15"
+			  "\x1d\x3b\x76\x8a\x82\x99\x8b\x1c"
+			  "\x94\xf1\xcd\x6a\x1e\xa7\xcc\x9a"
+			  "\xf7\xa2\x85\xe1\x12\xb8\x12\x8c"
+			  "\x38\x55\x9e\x00\xbc\x49\x80\xb5"
+			  "\x61\x24\x42\xa7\x53\xc0\x3f\xf8"
+			  "\x1c\x20\x5c\xf6\xd6\xb4\xea\x5c"
+			  "\xc6\x27\x98\x33\x0a\x14\x1f\xac"
+			  "\x33\x7a\x49\x5f\xbe\xa1\x2d\x55"
+			  "\x0a\xba\x74\xdb\x60\x76\xc7\x03"
+			  "\xfe\x7a\x0a\x88\xca\x5c\x85\xcd"
+			  "\xad\xce\x94\x01\xaa\x62\xb1\x80"
+			  "\x73\x22\xca\x73\x67\xc1\x61\x78"
+			  "\xf5\x4c\x1c\x16\xdf\x5a\x8d\x15"
+			  "\x5d\x43\xd2\x77\xa5\xc4\xb8\xf0"
+			  "\x8b\x39\x76\xde\xb9\x01\x6d\xf1"
+			  "\x76\xc3\x5c\x66\xd6\x25\x77\xa6"
+			  "\xbf\x82\x02\x6c\x93\x2e\x90\xc5"
+			  "\xb2\x8e\xab\xba\xa2\xfe\xf6\xbc"
+			  "\x18\x26\x0e\xc1\x50\xd9\x33\xd9"
+			  "\x2f\x06\x59\x46\xd5\x93\x78\x77"
+			  "\x76\x4a\x1c\xc8\xa5\x60\xec\x53"
+			  "\xda\x73\x42\x22\x65\x83\x6b\x15"
+			  "\x4c\xc8\x4b\x5a\x01\x77\xeb\x55"
+			  "\xd4\x95\x5d\x07\x33\xfe\xf7\xcc"
+			  "\x8f\xc2\xef\xe9\x76\x76\x24\x14"
+			  "\x02\xe4\x04\x22\xa5\xd1\x0b\xb1"
+			  "\xe4\xbf\xd1\x5e\xf2\x9f\x2b\xb0"
+			  "\x22\xdd\x8e\xe2\x57\x25\xb4\xee"
+			  "\x82\xf1\x37\xd0\xaa\x4b\x89\x73"
+			  "\xd5\xe3\xd5\x17\xb0\xcb\x5b\x01"
+			  "\x80\x21\x7f\x3c\xe6\xf3\xf3\xd0"
+			  "\x22\x16\xe2\x29\x04\x5b\x0f\xd6"
+			  "\x15\x3a\x3f\xf3\x5e\x29\x90\xd6"
+			  "\x92\x61\x05\xe0\x7a\xd2\x9d\xc5"
+			  "\xd4\xce\x09\x32\x01\x6b\x3d\x7a"
+			  "\x59\x19\xb6\xc2\xd6\x34\x8a\x84"
+			  "\x39\x54\x61\x7e\x2b\xca\x2f\xaa"
+			  "\xd3\x7f\x6d\x24\xe0\xbf\xef\xfd"
+			  "\x49\x33\xe0\xce\x25\x70\x97\x79"
+			  "\xd2\x20\x4d\x18\x5a\x4a\x72\x40"
+			  "\xb1\xa8\x43\xf1\xcb\x82\xe1\x5a"
+			  "\x6d\x44\x51\x84\x3a\x3e\xd4\x87"
+			  "\x2c\xe6\x0e\x1f\xc3\xb4\x6a\x98"
+			  "\x79\xc6\xc7\xfd\xf8\xab\x7a\x48"
+			  "\x21\xd3\x2e\xcf\x59\x8b\x87\x1b"
+			  "\x20\xff\xe4\xfd\x50\xe5\x53\x8e"
+			  "\x3c\xf5\xb4\x70\x4d\x19\xec\x92"
+			  "\x22\x87\xf4\x6e\xcf\xb4\x1d\xbb"
+			  "\x37\x6d\xf6\x9e\x5d\x73\x16\xe1"
+			  "\xc8\x2a\x55\xaa\xca\xaa\x27\x03"
+			  "\xbb\x06\x2d\xa0\xd6\x7d\x9c\x9e"
+			  "\xdf\xa8\xdc\x5a\x5f\xe0\x4b\xf2"
+			  "\x9f\xfa\x56\xd3\x59\x5b\x9f\xfc"
+			  "\xe3\x82\x33\x51\xe7\xcf\xf2\x2c"
+			  "\xb8\x06\xd5\x27\xdc\xa5\xbb\x33"
+			  "\xed\xa7\xf6\x57\xb2\xae\xff\xbf"
+			  "\x50\xf9\x4a\xb9\x86\x20\x92\xc3"
+			  "\xab\x7b\x37\x01\x70\x90\x99\x22"
+			  "\xc7\x86\xb6\x6b\x70\xab\xad\x55"
+			  "\x89\xf4\x6c\x1d\xea\x5c\x2e\xa7"
+			  "\x8b\xc3\x6e\x60\xf3\x48\x05\xfa"
+			  "\x48\xde\xd0\xee\x0f\x3a\x9f\x95"
+			  "\x8d\x42\x42\x56\x6d\xf1\x2c\x11"
+			  "\x1e\xc2\x8b\xc7\xd9\x8b\x8c\xba"
+			  "\x39\xaa\xce\x47\xb6\x39\x36\x39"
+			  "\x39\xee\x7e\x03\x91\xd4\x99\x60"
+			  "\x17\xaa\xbd\xa6\x99\xba\x95\xe6"
+			  "\x5b\x7f\x5b\x0a\xcc\xa3\xb1\xda"
+			  "\xb1\x6c\x1a\x88\xe9\x00\x3b\x92"
+			  "\x91\x12\x1e\x79\x0f\xbd\x2d\xa4"
+			  "\xbf\x32\xd6\xb2\x15\x9e\x7b\x77"
+			  "\x84\xb8\x69\xc1\xee\xf6\x86\x4c"
+			  "\xc1\x19\x70\xa4\x32\x4c\x23\xff"
+			  "\xe7\x03\x87\xdf\x09\x57\x51\xdd"
+			  "\xf6\xc1\x07\xe6\x45\x67\x00\x1d"
+			  "\x69\x8a\x5d\x82\x04\xdc\x06\x9e"
+			  "\x04\xf5\xe9\xab\x35\xc5\x4f\x47"
+			  "\x4d\x3c\xed\x13\x01\xc6\x28\xe1"
+			  "\x15\x32\x66\xd3\xd3\xd6\x65\x03"
+			  "\x78\x1a\x88\x4d\x18\xa3\x68\x37"
+			  "\x5f\xb0\x07\xdf\xe4\xc4\x7a\x56"
+			  "\xed\x47\xe4\x3f\x87\x55\xcd\x8f"
+			  "\x38\xf7\xdf\xb5\xbe\xd8\xcf\xf6"
+			  "\xee\x3e\xed\xf8\xf3\x4d\x14\x44"
+			  "\xc3\x2b\xd5\x2f\xa2\xa3\xa7\x43"
+			  "\x76\x98\xba\x35\xd7\xc7\x37\x7d"
+			  "\x27\x92\xe2\xb7\x8c\x78\x6c\x44"
+			  "\xf9\x62\x27\x77\x69\x96\x60\x98"
+			  "\x2c\xc8\xdf\x12\x57\x34\x1b\x5f"
+			  "\x93\x82\x31\xd4\x2a\x80\xa2\xbd"
+			  "\x27\xb8\x37\x14\x8e\x9f\xbc\x8a"
+			  "\x9b\x5c\xca\xe3\x8b\x06\x91\x05"
+			  "\xad\xb5\xbd\x13\x7a\xd3\xd1\x4f"
+			  "\x2b\xd8\x24\xa4\x2d\xbb\x1c\x77"
+			  "\x6c\xd0\x90\xce\xdd\xfc\x58\x32"
+			  "\x4c\xfa\x73\xd1\xce\x3b\x20\xf4"
+			  "\x15\x57\xc2\x42\xf1\xdb\x85\x37"
+			  "\x6a\xe3\x78\xb7\x63\xad\x40\xa2"
+			  "\xdd\xa7\xbc\x9a\x26\x2c\x36\x7d"
+			  "\x3f\x32\x37\x37\x78\x0a\x8d\xc7"
+			  "\xf0\xfa\x25\xfa\x00\x8a\xe4\xb8"
+			  "\x69\xdb\x6c\xf1\xcf\x95\x85\xe3"
+			  "\x74\x26\xbc\xd8\x14\x26\x5d\x63"
+			  "\xad\xa5\xec\xed\x30\xdb\xb7\xa1"
+			  "\xa7\xb2\x8c\x48\xdb\x99\x06\x53"
+			  "\x6b\x1f\xac\x89\x31\x4f\x71\x0f"
+			  "\x0f\xe2\x04\x57\x53\xa0\xca\x81"
+			  "\x6d\xa3\x33\xc3\x4c\xd2\x5b\x10"
+			  "\xb7\xa9\x0c\x33\x29\x6c\xaf\xe8"
+			  "\xfa\xd8\x38\xac\x60\xd1\x44\xaf"
+			  "\x69\xc9\xcc\xbc\x4f\xf9\x54\xda"
+			  "\x18\xeb\x3e\x5b\xa7\x67\x52\x1b"
+			  "\xe9\x5a\xca\x9f\x00\xc5\x58\xaf"
+			  "\xc1\x07\xef\xfc\x41\x6e\xfe\x64"
+			  "\xc6\xef\xb2\xed\x9b\xb9\x60\x46"
+			  "\xb9\x1a\xa0\xb1\x65\x86\x30\xbf"
+			  "\xf7\xb7\xc3\x61\x52\x28\xe4\xe0"
+			  "\xc0",
+		.rlen	= 1001,
+		.np	= 3,
+		.tap	= { 600, 368, 33 },
+	},
+};
+
 /*
  * CTS (Cipher Text Stealing) mode tests
  */
@@ -16247,6 +16936,170 @@ static struct pcomp_testvec zlib_decomp_tv_template[] = {
 	},
 };
 
+/*
+ * LZ4 test vectors (null-terminated strings).
+ */
+#define LZ4_COMP_TEST_VECTORS 2
+#define LZ4_DECOMP_TEST_VECTORS 2
+
+static struct comp_testvec lz4_comp_tv_template[] = {
+	{
+		.inlen	= 70,
+		.outlen	= 45,
+		.input	= "Join us now and share the software "
+			"Join us now and share the software ",
+		.output	= "\xf0\x10\x4a\x6f\x69\x6e\x20\x75"
+			  "\x73\x20\x6e\x6f\x77\x20\x61\x6e"
+			  "\x64\x20\x73\x68\x61\x72\x65\x20"
+			  "\x74\x68\x65\x20\x73\x6f\x66\x74"
+			  "\x77\x0d\x00\x0f\x23\x00\x0b\x50"
+			  "\x77\x61\x72\x65\x20",
+	}, {
+		.inlen	= 170,
+		.outlen	= 132,
+		.input	= "This document describes a compression method based on the LZ4 "
+			"compression algorithm.  This document defines the application of "
+			"the LZ4 algorithm used in the Linux kernel.",
+		.output	= "\xf9\x2e\x54\x68\x69\x73\x20\x64"
+			  "\x6f\x63\x75\x6d\x65\x6e\x74\x20"
+			  "\x64\x65\x73\x63\x72\x69\x62\x65"
+			  "\x73\x20\x61\x20\x63\x6f\x6d\x70"
+			  "\x72\x65\x73\x73\x69\x6f\x6e\x20"
+			  "\x6d\x65\x74\x68\x6f\x64\x20\x62"
+			  "\x61\x73\x65\x64\x20\x6f\x6e\x20"
+			  "\x74\x68\x65\x20\x4c\x5a\x34\x24"
+			  "\x00\xcc\x61\x6c\x67\x6f\x72\x69"
+			  "\x74\x68\x6d\x2e\x20\x20\x56\x00"
+			  "\x51\x66\x69\x6e\x65\x73\x36\x00"
+			  "\x80\x61\x70\x70\x6c\x69\x63\x61"
+			  "\x74\x56\x00\x21\x6f\x66\x13\x00"
+			  "\x00\x49\x00\x05\x3d\x00\x20\x20"
+			  "\x75\x63\x00\x13\x69\x63\x00\xc0"
+			  "\x69\x6e\x75\x78\x20\x6b\x65\x72"
+			  "\x6e\x65\x6c\x2e",
+	},
+};
+
+static struct comp_testvec lz4_decomp_tv_template[] = {
+	{
+		.inlen	= 132,
+		.outlen	= 170,
+		.input	= "\xf9\x2e\x54\x68\x69\x73\x20\x64"
+			  "\x6f\x63\x75\x6d\x65\x6e\x74\x20"
+			  "\x64\x65\x73\x63\x72\x69\x62\x65"
+			  "\x73\x20\x61\x20\x63\x6f\x6d\x70"
+			  "\x72\x65\x73\x73\x69\x6f\x6e\x20"
+			  "\x6d\x65\x74\x68\x6f\x64\x20\x62"
+			  "\x61\x73\x65\x64\x20\x6f\x6e\x20"
+			  "\x74\x68\x65\x20\x4c\x5a\x34\x24"
+			  "\x00\xcc\x61\x6c\x67\x6f\x72\x69"
+			  "\x74\x68\x6d\x2e\x20\x20\x56\x00"
+			  "\x51\x66\x69\x6e\x65\x73\x36\x00"
+			  "\x80\x61\x70\x70\x6c\x69\x63\x61"
+			  "\x74\x56\x00\x21\x6f\x66\x13\x00"
+			  "\x00\x49\x00\x05\x3d\x00\x20\x20"
+			  "\x75\x63\x00\x13\x69\x63\x00\xc0"
+			  "\x69\x6e\x75\x78\x20\x6b\x65\x72"
+			  "\x6e\x65\x6c\x2e",
+		.output	= "This document describes a compression method based on the LZ4 "
+			"compression algorithm.  This document defines the application of "
+			"the LZ4 algorithm used in the Linux kernel.",
+	}, {
+		.inlen	= 45,
+		.outlen	= 70,
+		.input	= "\xf0\x10\x4a\x6f\x69\x6e\x20\x75"
+			  "\x73\x20\x6e\x6f\x77\x20\x61\x6e"
+			  "\x64\x20\x73\x68\x61\x72\x65\x20"
+			  "\x74\x68\x65\x20\x73\x6f\x66\x74"
+			  "\x77\x0d\x00\x0f\x23\x00\x0b\x50"
+			  "\x77\x61\x72\x65\x20",
+		.output	= "Join us now and share the software "
+			"Join us now and share the software ",
+	},
+};
+
+/*
+ * LZ4HC test vectors (null-terminated strings).
+ */
+#define LZ4HC_COMP_TEST_VECTORS 2
+#define LZ4HC_DECOMP_TEST_VECTORS 2
+
+static struct comp_testvec lz4hc_comp_tv_template[] = {
+	{
+		.inlen	= 70,
+		.outlen	= 45,
+		.input	= "Join us now and share the software "
+			"Join us now and share the software ",
+		.output	= "\xf0\x10\x4a\x6f\x69\x6e\x20\x75"
+			  "\x73\x20\x6e\x6f\x77\x20\x61\x6e"
+			  "\x64\x20\x73\x68\x61\x72\x65\x20"
+			  "\x74\x68\x65\x20\x73\x6f\x66\x74"
+			  "\x77\x0d\x00\x0f\x23\x00\x0b\x50"
+			  "\x77\x61\x72\x65\x20",
+	}, {
+		.inlen	= 170,
+		.outlen	= 129,
+		.input	= "This document describes a compression method based on the LZ4 "
+			"compression algorithm.  This document defines the application of "
+			"the LZ4 algorithm used in the Linux kernel.",
+		.output	= "\xf9\x2e\x54\x68\x69\x73\x20\x64"
+			  "\x6f\x63\x75\x6d\x65\x6e\x74\x20"
+			  "\x64\x65\x73\x63\x72\x69\x62\x65"
+			  "\x73\x20\x61\x20\x63\x6f\x6d\x70"
+			  "\x72\x65\x73\x73\x69\x6f\x6e\x20"
+			  "\x6d\x65\x74\x68\x6f\x64\x20\x62"
+			  "\x61\x73\x65\x64\x20\x6f\x6e\x20"
+			  "\x74\x68\x65\x20\x4c\x5a\x34\x24"
+			  "\x00\xcc\x61\x6c\x67\x6f\x72\x69"
+			  "\x74\x68\x6d\x2e\x20\x20\x56\x00"
+			  "\x51\x66\x69\x6e\x65\x73\x36\x00"
+			  "\x80\x61\x70\x70\x6c\x69\x63\x61"
+			  "\x74\x32\x00\x25\x6f\x66\x49\x00"
+			  "\x05\x3d\x00\x20\x20\x75\x63\x00"
+			  "\x13\x69\x63\x00\xc0\x69\x6e\x75"
+			  "\x78\x20\x6b\x65\x72\x6e\x65\x6c"
+			  "\x2e",
+	},
+};
+
+static struct comp_testvec lz4hc_decomp_tv_template[] = {
+	{
+		.inlen	= 129,
+		.outlen	= 170,
+		.input	= "\xf9\x2e\x54\x68\x69\x73\x20\x64"
+			  "\x6f\x63\x75\x6d\x65\x6e\x74\x20"
+			  "\x64\x65\x73\x63\x72\x69\x62\x65"
+			  "\x73\x20\x61\x20\x63\x6f\x6d\x70"
+			  "\x72\x65\x73\x73\x69\x6f\x6e\x20"
+			  "\x6d\x65\x74\x68\x6f\x64\x20\x62"
+			  "\x61\x73\x65\x64\x20\x6f\x6e\x20"
+			  "\x74\x68\x65\x20\x4c\x5a\x34\x24"
+			  "\x00\xcc\x61\x6c\x67\x6f\x72\x69"
+			  "\x74\x68\x6d\x2e\x20\x20\x56\x00"
+			  "\x51\x66\x69\x6e\x65\x73\x36\x00"
+			  "\x80\x61\x70\x70\x6c\x69\x63\x61"
+			  "\x74\x32\x00\x25\x6f\x66\x49\x00"
+			  "\x05\x3d\x00\x20\x20\x75\x63\x00"
+			  "\x13\x69\x63\x00\xc0\x69\x6e\x75"
+			  "\x78\x20\x6b\x65\x72\x6e\x65\x6c"
+			  "\x2e",
+		.output	= "This document describes a compression method based on the LZ4 "
+			"compression algorithm.  This document defines the application of "
+			"the LZ4 algorithm used in the Linux kernel.",
+	}, {
+		.inlen	= 45,
+		.outlen	= 70,
+		.input	= "\xf0\x10\x4a\x6f\x69\x6e\x20\x75"
+			  "\x73\x20\x6e\x6f\x77\x20\x61\x6e"
+			  "\x64\x20\x73\x68\x61\x72\x65\x20"
+			  "\x74\x68\x65\x20\x73\x6f\x66\x74"
+			  "\x77\x0d\x00\x0f\x23\x00\x0b\x50"
+			  "\x77\x61\x72\x65\x20",
+		.output	= "Join us now and share the software "
+			"Join us now and share the software ",
+	},
+};
+
 /*
  * LZO test vectors (null-terminated strings).
  */
@@ -16379,10 +17232,474 @@ static struct hash_testvec michael_mic_tv_template[] = {
 	}
 };
 
+/*
+ * Poly1305 test vectors from RFC7539 A.3.  The one-time key is prepended
+ * to the message, as there is no setkey().
+ */
+#define POLY1305_TEST_VECTORS 5
+
+static struct hash_testvec poly1305_tv_template[] = {
+	{ /* Test Vector #1 */
+		.plaintext = "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+		.psize	= 96,
+		.digest	= "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+	}, { /* RFC7539 2.5.2 */
+		.plaintext = "\x85\xd6\xbe\x78\x57\x55\x6d\x33"
+			  "\x7f\x44\x52\xfe\x42\xd5\x06\xa8"
+			  "\x01\x03\x80\x8a\xfb\x0d\xb2\xfd"
+			  "\x4a\xbf\xf6\xaf\x41\x49\xf5\x1b"
+			  "\x43\x72\x79\x70\x74\x6f\x67\x72"
+			  "\x61\x70\x68\x69\x63\x20\x46\x6f"
+			  "\x72\x75\x6d\x20\x52\x65\x73\x65"
+			  "\x61\x72\x63\x68\x20\x47\x72\x6f"
+			  "\x75\x70",
+		.psize	= 66,
+		.digest	= "\xa8\x06\x1d\xc1\x30\x51\x36\xc6"
+			  "\xc2\x2b\x8b\xaf\x0c\x01\x27\xa9",
+	}, { /* Test Vector #2, key from A.3 #3 */
+		.plaintext = "\x36\xe5\xf6\xb5\xc5\xe0\x60\x70"
+			  "\xf0\xef\xca\x96\x22\x7a\x86\x3e"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x41\x6e\x79\x20\x73\x75\x62\x6d"
+			  "\x69\x73\x73\x69\x6f\x6e\x20\x74"
+			  "\x6f\x20\x74\x68\x65\x20\x49\x45"
+			  "\x54\x46\x20\x69\x6e\x74\x65\x6e"
+			  "\x64\x65\x64\x20\x62\x79\x20\x74"
+			  "\x68\x65\x20\x43\x6f\x6e\x74\x72"
+			  "\x69\x62\x75\x74\x6f\x72\x20\x66"
+			  "\x6f\x72\x20\x70\x75\x62\x6c\x69"
+			  "\x63\x61\x74\x69\x6f\x6e\x20\x61"
+			  "\x73\x20\x61\x6c\x6c\x20\x6f\x72"
+			  "\x20\x70\x61\x72\x74\x20\x6f\x66"
+			  "\x20\x61\x6e\x20\x49\x45\x54\x46"
+			  "\x20\x49\x6e\x74\x65\x72\x6e\x65"
+			  "\x74\x2d\x44\x72\x61\x66\x74\x20"
+			  "\x6f\x72\x20\x52\x46\x43\x20\x61"
+			  "\x6e\x64\x20\x61\x6e\x79\x20\x73"
+			  "\x74\x61\x74\x65\x6d\x65\x6e\x74"
+			  "\x20\x6d\x61\x64\x65\x20\x77\x69"
+			  "\x74\x68\x69\x6e\x20\x74\x68\x65"
+			  "\x20\x63\x6f\x6e\x74\x65\x78\x74"
+			  "\x20\x6f\x66\x20\x61\x6e\x20\x49"
+			  "\x45\x54\x46\x20\x61\x63\x74\x69"
+			  "\x76\x69\x74\x79\x20\x69\x73\x20"
+			  "\x63\x6f\x6e\x73\x69\x64\x65\x72"
+			  "\x65\x64\x20\x61\x6e\x20\x22\x49"
+			  "\x45\x54\x46\x20\x43\x6f\x6e\x74"
+			  "\x72\x69\x62\x75\x74\x69\x6f\x6e"
+			  "\x22\x2e\x20\x53\x75\x63\x68\x20"
+			  "\x73\x74\x61\x74\x65\x6d\x65\x6e"
+			  "\x74\x73\x20\x69\x6e\x63\x6c\x75"
+			  "\x64\x65\x20\x6f\x72\x61\x6c\x20"
+			  "\x73\x74\x61\x74\x65\x6d\x65\x6e"
+			  "\x74\x73\x20\x69\x6e\x20\x49\x45"
+			  "\x54\x46\x20\x73\x65\x73\x73\x69"
+			  "\x6f\x6e\x73\x2c\x20\x61\x73\x20"
+			  "\x77\x65\x6c\x6c\x20\x61\x73\x20"
+			  "\x77\x72\x69\x74\x74\x65\x6e\x20"
+			  "\x61\x6e\x64\x20\x65\x6c\x65\x63"
+			  "\x74\x72\x6f\x6e\x69\x63\x20\x63"
+			  "\x6f\x6d\x6d\x75\x6e\x69\x63\x61"
+			  "\x74\x69\x6f\x6e\x73\x20\x6d\x61"
+			  "\x64\x65\x20\x61\x74\x20\x61\x6e"
+			  "\x79\x20\x74\x69\x6d\x65\x20\x6f"
+			  "\x72\x20\x70\x6c\x61\x63\x65\x2c"
+			  "\x20\x77\x68\x69\x63\x68\x20\x61"
+			  "\x72\x65\x20\x61\x64\x64\x72\x65"
+			  "\x73\x73\x65\x64\x20\x74\x6f",
+		.psize	= 407,
+		.digest	= "\xf3\x47\x7e\x7c\xd9\x54\x17\xaf"
+			  "\x89\xa6\xb8\x79\x4c\x31\x0c\xf0",
+		.np	= 3,
+		.tap	= { 200, 150, 57 },
+	}, { /* Test Vector #5, h wraps around p */
+		.plaintext = "\x02\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\xff\xff\xff\xff\xff\xff\xff\xff"
+			  "\xff\xff\xff\xff\xff\xff\xff\xff",
+		.psize	= 48,
+		.digest	= "\x03\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+	}, { /* Test Vector #10, limbs carry */
+		.plaintext = "\x01\x00\x00\x00\x00\x00\x00\x00"
+			  "\x04\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\xe3\x35\x94\xd7\x50\x5e\x43\xb9"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x33\x94\xd7\x50\x5e\x43\x79\xcd"
+			  "\x01\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00"
+			  "\x01\x00\x00\x00\x00\x00\x00\x00"
+			  "\x00\x00\x00\x00\x00\x00\x00\x00",
+		.psize	= 96,
+		.digest	= "\x14\x00\x00\x00\x00\x00\x00\x00"
+			  "\x55\x00\x00\x00\x00\x00\x00\x00",
+	},
+};
+
+/*
+ * CRC32 test vectors
+ */
+#define CRC32_TEST_VECTORS 12
+
+static struct hash_testvec crc32_tv_template[] = {
+	{
+		.psize = 0,
+		.digest = "\x00\x00\x00\x00",
+	},
+	{
+		.key = "\xed\xcb\xa9\x87",
+		.ksize = 4,
+		.psize = 0,
+		.digest = "\xed\xcb\xa9\x87",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x01\x02\x03\x04\x05\x06\x07\x08"
+			     "\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10"
+			     "\x11\x12\x13\x14\x15\x16\x17\x18"
+			     "\x19\x1a\x1b\x1c\x1d\x1e\x1f\x20"
+			     "\x21\x22\x23\x24\x25\x26\x27\x28",
+		.psize = 40,
+		.digest = "\x3a\xdf\x4b\xb0",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x29\x2a\x2b\x2c\x2d\x2e\x2f\x30"
+			     "\x31\x32\x33\x34\x35\x36\x37\x38"
+			     "\x39\x3a\x3b\x3c\x3d\x3e\x3f\x40"
+			     "\x41\x42\x43\x44\x45\x46\x47\x48"
+			     "\x49\x4a\x4b\x4c\x4d\x4e\x4f\x50",
+		.psize = 40,
+		.digest = "\xa9\x7a\x7f\x7b",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x51\x52\x53\x54\x55\x56\x57\x58"
+			     "\x59\x5a\x5b\x5c\x5d\x5e\x5f\x60"
+			     "\x61\x62\x63\x64\x65\x66\x67\x68"
+			     "\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70"
+			     "\x71\x72\x73\x74\x75\x76\x77\x78",
+		.psize = 40,
+		.digest = "\xba\xd3\xf8\x1c",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x79\x7a\x7b\x7c\x7d\x7e\x7f\x80"
+			     "\x81\x82\x83\x84\x85\x86\x87\x88"
+			     "\x89\x8a\x8b\x8c\x8d\x8e\x8f\x90"
+			     "\x91\x92\x93\x94\x95\x96\x97\x98"
+			     "\x99\x9a\x9b\x9c\x9d\x9e\x9f\xa0",
+		.psize = 40,
+		.digest = "\xa8\xa9\xc2\x02",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8"
+			     "\xa9\xaa\xab\xac\xad\xae\xaf\xb0"
+			     "\xb1\xb2\xb3\xb4\xb5\xb6\xb7\xb8"
+			     "\xb9\xba\xbb\xbc\xbd\xbe\xbf\xc0"
+			     "\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8",
+		.psize = 40,
+		.digest = "\x27\xf0\x57\xe2",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\xc9\xca\xcb\xcc\xcd\xce\xcf\xd0"
+			     "\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8"
+			     "\xd9\xda\xdb\xdc\xdd\xde\xdf\xe0"
+			     "\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8"
+			     "\xe9\xea\xeb\xec\xed\xee\xef\xf0",
+		.psize = 40,
+		.digest = "\x49\x78\x10\x08",
+	},
+	{
+		.key = "\x80\xd3\x3a\x1d",
+		.ksize = 4,
+		.plaintext = "\x29\x2a\x2b\x2c\x2d\x2e\x2f\x30"
+			     "\x31\x32\x33\x34\x35\x36\x37\x38"
+			     "\x39\x3a\x3b\x3c\x3d\x3e\x3f\x40"
+			     "\x41\x42\x43\x44\x45\x46\x47\x48"
+			     "\x49\x4a\x4b\x4c\x4d\x4e\x4f\x50",
+		.psize = 40,
+		.digest = "\xd1\x6b\x3d\xed",
+	},
+	{
+		.key = "\xf3\x4a\x1d\x5d",
+		.ksize = 4,
+		.plaintext = "\x51\x52\x53\x54\x55\x56\x57\x58"
+			     "\x59\x5a\x5b\x5c\x5d\x5e\x5f\x60"
+			     "\x61\x62\x63\x64\x65\x66\x67\x68"
+			     "\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70"
+			     "\x71\x72\x73\x74\x75\x76\x77\x78",
+		.psize = 40,
+		.digest = "\xb4\x97\xcc\xd4",
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x01\x02\x03\x04\x05\x06\x07\x08"
+			     "\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10"
+			     "\x11\x12\x13\x14\x15\x16\x17\x18"
+			     "\x19\x1a\x1b\x1c\x1d\x1e\x1f\x20"
+			     "\x21\x22\x23\x24\x25\x26\x27\x28"
+			     "\x29\x2a\x2b\x2c\x2d\x2e\x2f\x30"
+			     "\x31\x32\x33\x34\x35\x36\x37\x38"
+			     "\x39\x3a\x3b\x3c\x3d\x3e\x3f\x40"
+			     "\x41\x42\x43\x44\x45\x46\x47\x48"
+			     "\x49\x4a\x4b\x4c\x4d\x4e\x4f\x50"
+			     "\x51\x52\x53\x54\x55\x56\x57\x58"
+			     "\x59\x5a\x5b\x5c\x5d\x5e\x5f\x60"
+			     "\x61\x62\x63\x64\x65\x66\x67\x68"
+			     "\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70"
+			     "\x71\x72\x73\x74\x75\x76\x77\x78"
+			     "\x79\x7a\x7b\x7c\x7d\x7e\x7f\x80"
+			     "\x81\x82\x83\x84\x85\x86\x87\x88"
+			     "\x89\x8a\x8b\x8c\x8d\x8e\x8f\x90"
+			     "\x91\x92\x93\x94\x95\x96\x97\x98"
+			     "\x99\x9a\x9b\x9c\x9d\x9e\x9f\xa0"
+			     "\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8"
+			     "\xa9\xaa\xab\xac\xad\xae\xaf\xb0"
+			     "\xb1\xb2\xb3\xb4\xb5\xb6\xb7\xb8"
+			     "\xb9\xba\xbb\xbc\xbd\xbe\xbf\xc0"
+			     "\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8"
+			     "\xc9\xca\xcb\xcc\xcd\xce\xcf\xd0"
+			     "\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8"
+			     "\xd9\xda\xdb\xdc\xdd\xde\xdf\xe0"
+			     "\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8"
+			     "\xe9\xea\xeb\xec\xed\xee\xef\xf0",
+		.psize = 240,
+		.digest = "\x6c\xc6\x56\xde",
+		.np = 2,
+		.tap = { 31, 209 }
+	},
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x00\x05\x0d\x10\x1b\x2b\x20\x3d"
+			     "\x35\x30\x56\x5f\x40\x4e\x75\x70"
+			     "\x6a\x6b\x63\x9a\xad\xb1\xbe\x87"
+			     "\x8f\x86\x9c\x91\xea\xe4\xe3\xea"
+			     "\xd4\xd1\xd9\xcc\xc7\x3f\x34\x51"
+			     "\x59\x5c\x62\x6b\x7c\x72\x09\x04"
+			     "\x1e\x07\x0f\x36\x39\x25\x22\xdb"
+			     "\xd3\xd2\xc8\xfd\xc6\xc8\xd7\xde"
+			     "\xa8\xad\xa5\xb8\xb3\x93\x98\x85"
+			     "\x8d\x88\x7e\x77\x68\x66\x5d\xa8"
+			     "\xb2\xb3\xbb\xc2\xc5\xd9\xd6\xef"
+			     "\xe7\xfe\xe4\xe9\x12\x1c\x0b\x02"
+			     "\x3c\x39\x31\x14\x1f\x67\x6c\x79"
+			     "\x71\x74\x4a\x43\x44\x4a\xb1\xbc"
+			     "\xa6\xaf\xa7\x9e\x91\x8d\xfa\x83"
+			     "\x8b\x8a\x90\x95\xae\xa0\xbf\xb6"
+			     "\x50\x55\x5d\x40\x4b\x7b\x70\x6d"
+			     "\x65\x60\x26\x2f\x30\x3e\x05\x00"
+			     "\x1a\x1b\x13\xea\xfd\xe1\xee\xd7"
+			     "\xdf\xd6\xcc\xc1\xba\xb4\x53\x5a"
+			     "\x64\x61\x69\x7c\x77\x8f\x84\x81"
+			     "\x89\x8c\xb2\xbb\xac\xa2\xd9\xd4"
+			     "\xce\xf7\xff\xc6\xc9\xd5\xd2\x2b"
+			     "\x23\x22\x38\x2d\x16\x18\x07\x0e"
+			     "\x78\x7d\x75\x68\x63\x23\x28\x35"
+			     "\x3d\x38\xce\xc7\xd8\xd6\xed\xf8"
+			     "\xe2\xe3\xeb\x92\x95\x89\x86\xbf"
+			     "\xb7\x8e\x94\x99\x62\x6c\x7b\x72"
+			     "\x4c\x49\x41\x44\x4f\x37\x3c\x29"
+			     "\x21\x24\x1a\x13\xf4\xfa\x01\x0c"
+			     "\x16\x1f\x17\x2e\x21\x3d\x2a\x53"
+			     "\x5b\x5a\x40\x45\x7e\x70\x6f\x66"
+			     "\xa0\xa5\xad\xb0\xbb\x8b\x80\x9d"
+			     "\x95\x90\xf6\xff\xe0\xee\xd5\xd0"
+			     "\xca\xcb\xc3\x3a\x4d\x51\x5e\x67"
+			     "\x6f\x66\x7c\x71\x0a\x04\x03\x0a"
+			     "\x34\x31\x39\x2c\x27\xdf\xd4\xf1"
+			     "\xf9\xfc\xc2\xcb\xdc\xd2\xa9\xa4"
+			     "\xbe\xa7\xaf\x96\x99\x85\x82\x7b"
+			     "\x73\x72\x68\x9d\xa6\xa8\xb7\xbe"
+			     "\xc8\xcd\xc5\xd8\xd3\xf3\xf8\xe5"
+			     "\xed\xe8\x1e\x17\x08\x06\x3d\x08"
+			     "\x12\x13\x1b\x62\x65\x79\x76\x4f"
+			     "\x47\x5e\x44\x49\xb2\xbc\xab\xa2"
+			     "\x9c\x99\x91\xf4\xff\x87\x8c\x99"
+			     "\x91\x94\xaa\xa3\xa4\xaa\x51\x5c"
+			     "\x46\x4f\x47\x7e\x71\x6d\x5a\x23"
+			     "\x2b\x2a\x30\x35\x0e\x00\x1f\x16"
+			     "\xf0\xf5\xfd\xe0\xeb\xdb\xd0\xcd"
+			     "\xc5\xc0\x46\x4f\x50\x5e\x65\x60"
+			     "\x7a\x7b\x73\x8a\x9d\x81\x8e\xb7"
+			     "\xbf\xb6\xac\xa1\xda\xd4\xf3\xfa"
+			     "\xc4\xc1\xc9\xdc\xd7\x2f\x24\x21"
+			     "\x29\x2c\x12\x1b\x0c\x02\x79\x74"
+			     "\x6e\x17\x1f\x26\x29\x35\x32\xcb"
+			     "\xc3\xc2\xd8\xcd\xf6\xf8\xe7\xee"
+			     "\x98\x9d\x95\x88\x83\x83\x88\x95"
+			     "\x9d\x98\x6e\x67\x78\x76\x4d\x58"
+			     "\x42\x43\x4b\x32\x35\x29\x26\x1f"
+			     "\x17\xee\xf4\xf9\x02\x0c\x1b\x12"
+			     "\x2c\x29\x21\x24\x2f\x57\x5c\x49"
+			     "\x41\x44\x7a\x73\x54\x5a\xa1\xac"
+			     "\xb6\xbf\xb7\x8e\x81\x9d\x8a\xf3"
+			     "\xfb\xfa\xe0\xe5\xde\xd0\xcf\xc6"
+			     "\x40\x45\x4d\x50\x5b\x6b\x60\x7d"
+			     "\x75\x70\x16\x1f\x00\x0e\x35\x30"
+			     "\x2a\x2b\x23\xda\xed\xf1\xfe\xc7"
+			     "\xcf\xc6\xdc\xd1\xaa\xa4\xa3\xaa"
+			     "\x94\x91\x99\x8c\x87\x7f\x74\x91"
+			     "\x99\x9c\xa2\xab\xbc\xb2\xc9\xc4"
+			     "\xde\xc7\xcf\xf6\xf9\xe5\xe2\x1b"
+			     "\x13\x12\x08\x3d\x06\x08\x17\x1e"
+			     "\x68\x6d\x65\x78\x73\x53\x58\x45"
+			     "\x4d\x48\xbe\xb7\xa8\xa6\x9d\xe8"
+			     "\xf2\xf3\xfb\x82\x85\x99\x96\xaf"
+			     "\xa7\xbe\xa4\xa9\x52\x5c\x4b\x42"
+			     "\x7c\x79\x71\x54\x5f\x27\x2c\x39"
+			     "\x31\x34\x0a\x03\x04\x0a\xf1\xfc"
+			     "\xe6\xef\xe7\xde\xd1\xcd\x3a\x43"
+			     "\x4b\x4a\x50\x55\x6e\x60\x7f\x76"
+			     "\x90\x95\x9d\x80\x8b\xbb\xb0\xad"
+			     "\xa5\xa0\xe6\xef\xf0\xfe\xc5\xc0"
+			     "\xda\xdb\xd3\x2a\x3d\x21\x2e\x17"
+			     "\x1f\x16\x0c\x01\x7a\x74\x13\x1a"
+			     "\x24\x21\x29\x3c\x37\xcf\xc4\xc1"
+			     "\xc9\xcc\xf2\xfb\xec\xe2\x99\x94"
+			     "\x8e\xb7\xbf\x86\x89\x95\x92\x6b"
+			     "\x63\x62\x78\x6d\x56\x58\x47\x4e"
+			     "\x38\x3d\x35\x28\x23\xe3\xe8\xf5"
+			     "\xfd\xf8\x0e\x07\x18\x16\x2d\x38"
+			     "\x22\x23\x2b\x52\x55\x49\x46\x7f"
+			     "\x77\x4e\x54\x59\xa2\xac\xbb\xb2"
+			     "\x8c\x89\x81\x84\x8f\xf7\xfc\xe9"
+			     "\xe1\xe4\xda\xd3\xb4\xba\x41\x4c"
+			     "\x56\x5f\x57\x6e\x61\x7d\x6a\x13"
+			     "\x1b\x1a\x00\x05\x3e\x30\x2f\x26"
+			     "\xe0\xe5\xed\xf0\xfb\xcb\xc0\xdd"
+			     "\xd5\xd0\xb6\xbf\xa0\xae\x95\x90"
+			     "\x8a\x8b\x83\x7a\x8d\x91\x9e\xa7"
+			     "\xaf\xa6\xbc\xb1\xca\xc4\xc3\xca"
+			     "\xf4\xf1\xf9\xec\xe7\x1f\x14\x31"
+			     "\x39\x3c\x02\x0b\x1c\x12\x69\x64"
+			     "\x7e\x67\x6f\x56\x59\x45\x42\xbb"
+			     "\xb3\xb2\xa8\xdd\xe6\xe8\xf7\xfe"
+			     "\x88\x8d\x85\x98\x93\xb3\xb8\xa5"
+			     "\xad\xa8\x5e\x57\x48\x46\x7d\x48"
+			     "\x52\x53\x5b\x22\x25\x39\x36\x0f"
+			     "\x07\x1e\x04\x09\xf2\xfc\xeb\xe2"
+			     "\xdc\xd9\xd1\x34\x3f\x47\x4c\x59"
+			     "\x51\x54\x6a\x63\x64\x6a\x91\x9c"
+			     "\x86\x8f\x87\xbe\xb1\xad\x9a\xe3"
+			     "\xeb\xea\xf0\xf5\xce\xc0\xdf\xd6"
+			     "\x30\x35\x3d\x20\x2b\x1b\x10\x0d"
+			     "\x05\x00\x06\x0f\x10\x1e\x25\x20"
+			     "\x3a\x3b\x33\xca\xdd\xc1\xce\xf7"
+			     "\xff\xf6\xec\xe1\x9a\x94\xb3\xba"
+			     "\x84\x81\x89\x9c\x97\x6f\x64\x61"
+			     "\x69\x6c\x52\x5b\x4c\x42\x39\x34"
+			     "\x2e\xd7\xdf\xe6\xe9\xf5\xf2\x0b"
+			     "\x03\x02\x18\x0d\x36\x38\x27\x2e"
+			     "\x58\x5d\x55\x48\x43\x43\x48\x55"
+			     "\x5d\x58\xae\xa7\xb8\xb6\x8d\x98"
+			     "\x82\x83\x8b\xf2\xf5\xe9\xe6\xdf"
+			     "\xd7\xae\xb4\xb9\x42\x4c\x5b\x52"
+			     "\x6c\x69\x61\x64\x6f\x17\x1c\x09"
+			     "\x01\x04\x3a\x33\x14\x1a\xe1\xec"
+			     "\xf6\xff\xf7\xce\xc1\xdd\xca\xb3"
+			     "\xbb\xba\xa0\xa5\x9e\x90\x8f\x86"
+			     "\x80\x85\x8d\x90\x9b\xab\xa0\xbd"
+			     "\xb5\xb0\xd6\xdf\xc0\xce\xf5\xf0"
+			     "\xea\xeb\xe3\x1a\x2d\x31\x3e\x07"
+			     "\x0f\x06\x1c\x11\x6a\x64\x63\x6a"
+			     "\x54\x51\x59\x4c\x47\xbf\xb4\xd1"
+			     "\xd9\xdc\xe2\xeb\xfc\xf2\x89\x84"
+			     "\x9e\x87\x8f\xb6\xb9\xa5\xa2\x5b"
+			     "\x53\x52\x48\x7d\x46\x48\x57\x5e"
+			     "\x28\x2d\x25\x38\x33\x13\x18\x05"
+			     "\x0d\x08\xfe\xf7\xe8\xe6\xdd\x28"
+			     "\x32\x33\x3b\x42\x45\x59\x56\x6f"
+			     "\x67\x7e\x64\x69\x92\x9c\x8b\x82"
+			     "\xbc\xb9\xb1\x94\x9f\xe7\xec\xf9"
+			     "\xf1\xf4\xca\xc3\xc4\xca\x31\x3c"
+			     "\x26\x2f\x27\x1e\x11\x0d\x7a\x03"
+			     "\x0b\x0a\x10\x15\x2e\x20\x3f\x36"
+			     "\xd0\xd5\xdd\xc0\xcb\xfb\xf0\xed"
+			     "\xe5\xe0\xa6\xaf\xb0\xbe\x85\x80"
+			     "\x9a\x9b\x93\x6a\x7d\x61\x6e\x57"
+			     "\x5f\x56\x4c\x41\x3a\x34\xd3\xda"
+			     "\xe4\xe1\xe9\xfc\xf7\x0f\x04\x01"
+			     "\x09\x0c\x32\x3b\x2c\x22\x59\x54"
+			     "\x4e\x77\x7f\x46\x49\x55\x52\xab"
+			     "\xa3\xa2\xb8\xad\x96\x98\x87\x8e"
+			     "\xf8\xfd\xf5\xe8\xe3\xa3\xa8\xb5"
+			     "\xbd\xb8\x4e\x47\x58\x56\x6d\x78"
+			     "\x62\x63\x6b\x12\x15\x09\x06\x3f"
+			     "\x37\x0e\x14\x19\xe2\xec\xfb\xf2"
+			     "\xcc\xc9\xc1\xc4\xcf\xb7\xbc\xa9"
+			     "\xa1\xa4\x9a\x93\x74\x7a\x81\x8c"
+			     "\x96\x9f\x97\xae\xa1\xbd\xaa\xd3"
+			     "\xdb\xda\xc0\xc5\xfe\xf0\xef\xe6"
+			     "\x20\x25\x2d\x30\x3b\x0b\x00\x1d"
+			     "\x15\x10\x76\x7f\x60\x6e\x55\x50"
+			     "\x4a\x4b\x43\xba\xcd\xd1\xde\xe7"
+			     "\xef\xe6\xfc\xf1\x8a\x84\x83\x8a"
+			     "\xb4\xb1\xb9\xac\xa7\x5f\x54\x71"
+			     "\x79\x7c\x42\x4b\x5c\x52\x29\x24"
+			     "\x3e\x27\x2f\x16\x19\x05\x02\xfb"
+			     "\xf3\xf2\xe8\x1d\x26\x28\x37\x3e"
+			     "\x48\x4d\x45\x58\x53\x73\x78\x65"
+			     "\x6d\x68\x9e\x97\x88\x86\xbd\x88"
+			     "\x92\x93\x9b\xe2\xe5\xf9\xf6\xcf"
+			     "\xc7\xde\xc4\xc9\x32\x3c\x2b\x22"
+			     "\x1c\x19\x11\x74\x7f\x07\x0c\x19"
+			     "\x11\x14\x2a\x23\x24\x2a\xd1\xdc"
+			     "\xc6\xcf\xc7\xfe\xf1\xed\xda\xa3"
+			     "\xab\xaa\xb0\xb5\x8e\x80\x9f\x96"
+			     "\x70\x75\x7d\x60\x6b\x5b\x50\x4d"
+			     "\x45\x40\xc6\xcf\xd0\xde\xe5\xe0"
+			     "\xfa\xfb\xf3\x0a\x1d\x01\x0e\x37"
+			     "\x3f\x36\x2c\x21\x5a\x54\x73\x7a"
+			     "\x44\x41\x49\x5c\x57\xaf\xa4\xa1"
+			     "\xa9\xac\x92\x9b\x8c\x82\xf9\xf4"
+			     "\xee\x97\x9f\xa6\xa9\xb5\xb2\x4b"
+			     "\x43\x42\x58\x4d\x76\x78\x67\x6e"
+			     "\x18\x1d\x15\x08\x03\x03\x08\x15"
+			     "\x1d\x18\xee\xe7\xf8\xf6\xcd\xd8"
+			     "\xc2\xc3\xcb\xb2\xb5\xa9\xa6\x9f"
+			     "\x97\x6e\x74\x79\x82\x8c\x9b\x92"
+			     "\xac\xa9\xa1\xa4\xaf\xd7\xdc\xc9"
+			     "\xc1\xc4\xfa\xf3\xd4\xda\x21\x2c"
+			     "\x36\x3f\x37\x0e\x01\x1d\x0a\x73"
+			     "\x7b\x7a\x60\x65\x5e\x50\x4f\x46",
+		.psize = 1536,
+		.digest = "\xde\xda\x2d\x58",
+	}
+};
+
 /*
  * CRC32C test vectors
  */
-#define CRC32C_TEST_VECTORS 14
+#define CRC32C_TEST_VECTORS 15
 
 static struct hash_testvec crc32c_tv_template[] = {
 	{
@@ -16553,7 +17870,541 @@ static struct hash_testvec crc32c_tv_template[] = {
 		.digest = "\x75\xd3\xc5\x24",
 		.np = 2,
 		.tap = { 31, 209 }
+	},,
+	{
+		.key = "\xff\xff\xff\xff",
+		.ksize = 4,
+		.plaintext = "\x00\x03\x09\x1e\x12\x31\x3c\x28"
+			     "\x25\x1e\x62\x65\x7f\x74\x51\x5f"
+			     "\x4a\x49\x3f\xc0\xc4\xdf\xca\xf2"
+			     "\xff\xf4\xe8\xdf\xa1\xa2\xbf\xa9"
+			     "\x94\x9f\x95\x8a\x7e\x85\x80\x9c"
+			     "\x89\x8a\xbe\xb1\xab\x98\xe5\xe3"
+			     "\xfe\xe5\xeb\xdc\xd0\xb3\xbe\x46"
+			     "\x43\x40\x44\x4b\x7d\x76\x53\x5d"
+			     "\x28\x2b\x21\x26\x2a\x19\x14\xf0"
+			     "\xfd\xf6\x0a\x1d\x07\x0c\x39\x37"
+			     "\x12\x11\x17\x68\x7c\x67\x62\x5a"
+			     "\x57\x2c\x30\x37\xc9\xda\xc7\xc1"
+			     "\xfc\xc7\xcd\xd2\xd6\xad\xb8\xa4"
+			     "\xa1\xa2\x66\x69\x73\x70\x8d\x9b"
+			     "\x86\x8d\x83\x84\x88\x9b\x96\xee"
+			     "\xfb\xf8\xec\xe3\xa5\xae\xbb\xb5"
+			     "\x50\x53\x59\x4e\x42\x41\x4c\x58"
+			     "\x55\x4e\x32\x35\x2f\x24\xe1\xef"
+			     "\xfa\xf9\xef\x10\x14\x0f\x3a\x02"
+			     "\x0f\x04\x18\x0f\x71\x72\x6f\x19"
+			     "\x24\x2f\x25\x3a\x2e\xd5\xd0\xcc"
+			     "\xf9\xfa\xce\xc1\xdb\xc8\xb5\xb3"
+			     "\xae\x55\x5b\x6c\x60\x63\x6e\x96"
+			     "\x93\x90\xb4\xbb\x8d\x86\x83\x8d"
+			     "\xf8\xfb\xf1\x96\x9a\xa9\xa4\xa0"
+			     "\xad\xa6\x5a\x6d\x77\x7c\x49\x47"
+			     "\x42\x41\x47\x38\xcc\xd7\xd2\xea"
+			     "\xe7\xfc\xe0\xe7\x19\x2a\x37\x31"
+			     "\x0c\x17\x1d\x02\x06\x7d\x08\x14"
+			     "\x11\x12\x36\x39\x23\x20\xdd\xeb"
+			     "\xf6\xfd\xf3\xd4\xd8\xcb\xc6\xbe"
+			     "\x4b\x48\x5c\x53\x75\x7e\x6b\x65"
+			     "\xa0\xa3\xa9\xbe\xb2\x91\x9c\x88"
+			     "\x85\xfe\x82\x85\x9f\x94\xb1\xbf"
+			     "\xaa\xa9\x9f\x60\x64\x7f\x6a\x52"
+			     "\x5f\x54\x48\xbf\xc1\xc2\xdf\xc9"
+			     "\xf4\xff\xf5\xea\xde\x25\x20\x3c"
+			     "\x29\x2a\x1e\x11\x0b\x78\x05\x03"
+			     "\x1e\x05\x0b\x3c\x30\x13\x1e\xe6"
+			     "\xe3\xe0\xe4\xeb\xdd\xd6\x33\x3d"
+			     "\x48\x4b\x41\x46\x4a\x79\x74\x50"
+			     "\x5d\x56\xaa\xbd\xa7\xac\x99\x97"
+			     "\xf2\xf1\xf7\x88\x9c\x87\x82\xba"
+			     "\xb7\x8c\x90\x97\x69\x7a\x67\x61"
+			     "\x5c\xa7\xad\xb2\xb6\xcd\xd8\xc4"
+			     "\xc1\xc2\xc6\xc9\xd3\xd0\x2d\x3b"
+			     "\x26\x2d\x23\x64\x68\x7b\x76\x0e"
+			     "\x1b\x18\x0c\x03\x05\x0e\x1b\x15"
+			     "\xf0\xf3\xf9\xee\xe2\x21\x2c\x38"
+			     "\x35\x2e\x52\x55\x4f\x44\x41\x4f"
+			     "\x5a\x59\x4f\xb0\xb4\xaf\xda\xe2"
+			     "\xef\xe4\xf8\xef\x91\x92\x8f\xb9"
+			     "\x84\x8f\x85\x9a\x8e\x75\x70\x6c"
+			     "\x99\x9a\xae\xa1\xbb\xa8\xd5\xd3"
+			     "\xce\xf5\xfb\xcc\xc0\xc3\xce\x36"
+			     "\x33\x30\x54\x5b\x6d\x66\x63\x6d"
+			     "\x18\x1b\x11\x36\x3a\x09\x04\x00"
+			     "\x0d\x06\xfa\x0d\x17\x1c\x29\x27"
+			     "\x22\x21\x27\x58\x6c\x77\x72\x4a"
+			     "\x47\x5c\x40\x47\xb9\xca\xd7\xd1"
+			     "\xec\xf7\xfd\xe2\xe6\x9d\xa8\xb4"
+			     "\xb1\xb2\x96\x99\x83\x80\x7d\x8b"
+			     "\x96\x9d\x93\xb4\xb8\xab\xa6\xde"
+			     "\xeb\xe8\xfc\xf3\xd5\xde\xcb\xc5"
+			     "\x40\x43\x49\x5e\x52\x71\x7c\x68"
+			     "\x65\x5e\x22\x25\x3f\x34\x11\x1f"
+			     "\x0a\x09\xff\x00\x04\x1f\x0a\x32"
+			     "\x3f\x34\x28\x1f\x61\x62\x7f\x69"
+			     "\x54\x5f\x55\x4a\x3e\xc5\xc0\xdc"
+			     "\xc9\xca\xfe\xf1\xeb\xd8\xa5\xa3"
+			     "\xbe\xa5\xab\x9c\x90\x73\x7e\x86"
+			     "\x83\x80\x84\x8b\xbd\xb6\x93\x9d"
+			     "\xe8\xeb\xe1\xe6\xea\xd9\xd4\xb0"
+			     "\xbd\xb6\x4a\x5d\x47\x4c\x79\x77"
+			     "\x52\x51\x57\x28\x3c\x27\x22\x1a"
+			     "\x17\xec\xf0\xf7\x09\x1a\x07\x01"
+			     "\x3c\x07\x0d\x12\x16\x6d\x78\x64"
+			     "\x61\x62\x26\x29\x33\x30\xcd\xdb"
+			     "\xc6\xcd\xc3\xc4\xc8\xdb\xd6\xae"
+			     "\xbb\xb8\xac\xa3\x65\x6e\x7b\x75"
+			     "\x90\x93\x99\x8e\x82\x81\x8c\x98"
+			     "\x95\x8e\xf2\xf5\xef\xe4\xa1\xaf"
+			     "\xba\xb9\xaf\x50\x54\x4f\x7a\x42"
+			     "\x4f\x44\x58\x4f\x31\x32\x2f\xd9"
+			     "\xe4\xef\xe5\xfa\xee\x15\x10\x0c"
+			     "\x39\x3a\x0e\x01\x1b\x08\x75\x73"
+			     "\x6e\x15\x1b\x2c\x20\x23\x2e\xd6"
+			     "\xd3\xd0\xf4\xfb\xcd\xc6\xc3\xcd"
+			     "\xb8\xbb\xb1\x56\x5a\x69\x64\x60"
+			     "\x6d\x66\x9a\xad\xb7\xbc\x89\x87"
+			     "\x82\x81\x87\xf8\x8c\x97\x92\xaa"
+			     "\xa7\xbc\xa0\xa7\x59\x6a\x77\x71"
+			     "\x4c\x57\x5d\x42\x46\x3d\xc8\xd4"
+			     "\xd1\xd2\xf6\xf9\xe3\xe0\x1d\x2b"
+			     "\x36\x3d\x33\x14\x18\x0b\x06\x7e"
+			     "\x0b\x08\x1c\x13\x35\x3e\x2b\x25"
+			     "\xe0\xe3\xe9\xfe\xf2\xd1\xdc\xc8"
+			     "\xc5\x3e\x42\x45\x5f\x54\x71\x7f"
+			     "\x6a\x69\x5f\xa0\xa4\xbf\xaa\x92"
+			     "\x9f\x94\x88\xff\x81\x82\x9f\x89"
+			     "\xb4\xbf\xb5\xaa\x9e\x65\x60\x7c"
+			     "\x69\x6a\x5e\x51\x4b\xb8\xc5\xc3"
+			     "\xde\xc5\xcb\xfc\xf0\xd3\xde\x26"
+			     "\x23\x20\x24\x2b\x1d\x16\x73\x7d"
+			     "\x08\x0b\x01\x06\x0a\x39\x34\x10"
+			     "\x1d\x16\xea\xfd\xe7\xec\xd9\xd7"
+			     "\x32\x31\x37\x48\x5c\x47\x42\x7a"
+			     "\x77\x4c\x50\x57\xa9\xba\xa7\xa1"
+			     "\x9c\xe7\xed\xf2\xf6\x8d\x98\x84"
+			     "\x81\x82\x86\x89\x93\x90\x6d\x7b"
+			     "\x66\x6d\x63\xa4\xa8\xbb\xb6\xce"
+			     "\xdb\xd8\xcc\xc3\xc5\xce\xdb\xd5"
+			     "\x30\x33\x39\x2e\x22\x61\x6c\x78"
+			     "\x75\x6e\x12\x15\x0f\x04\x01\x0f"
+			     "\x1a\x19\x0f\xf0\xf4\xef\x1a\x22"
+			     "\x2f\x24\x38\x2f\x51\x52\x4f\x79"
+			     "\x44\x4f\x45\x5a\x4e\xb5\xb0\xac"
+			     "\xd9\xda\xee\xe1\xfb\xe8\x95\x93"
+			     "\x8e\xb5\xbb\x8c\x80\x83\x8e\x76"
+			     "\x73\x70\x94\x9b\xad\xa6\xa3\xad"
+			     "\xd8\xdb\xd1\xf6\xfa\xc9\xc4\xc0"
+			     "\xcd\xc6\x3a\x4d\x57\x5c\x69\x67"
+			     "\x62\x61\x67\x18\x2c\x37\x32\x0a"
+			     "\x07\x1c\x00\x07\xf9\x0a\x17\x11"
+			     "\x2c\x37\x3d\x22\x26\x5d\x68\x74"
+			     "\x71\x72\x56\x59\x43\x40\xbd\xcb"
+			     "\xd6\xdd\xd3\xf4\xf8\xeb\xe6\x9e"
+			     "\xab\xa8\xbc\xb3\x95\x9e\x8b\x85"
+			     "\x80\x83\x89\x9e\x92\xb1\xbc\xa8"
+			     "\xa5\x9e\xe2\xe5\xff\xf4\xd1\xdf"
+			     "\xca\xc9\xbf\x40\x44\x5f\x4a\x72"
+			     "\x7f\x74\x68\x5f\x21\x22\x3f\x29"
+			     "\x14\x1f\x15\x0a\xfe\x05\x00\x1c"
+			     "\x09\x0a\x3e\x31\x2b\x18\x65\x63"
+			     "\x7e\x65\x6b\x5c\x50\x33\x3e\xc6"
+			     "\xc3\xc0\xc4\xcb\xfd\xf6\xd3\xdd"
+			     "\xa8\xab\xa1\xa6\xaa\x99\x94\x70"
+			     "\x7d\x76\x8a\x9d\x87\x8c\xb9\xb7"
+			     "\x92\x91\x97\xe8\xfc\xe7\xe2\xda"
+			     "\xd7\xac\xb0\xb7\x49\x5a\x47\x41"
+			     "\x7c\x47\x4d\x52\x56\x2d\x38\x24"
+			     "\x21\x22\xe6\xe9\xf3\xf0\x0d\x1b"
+			     "\x06\x0d\x03\x04\x08\x1b\x16\x6e"
+			     "\x7b\x78\x6c\x63\x25\x2e\x3b\x35"
+			     "\xd0\xd3\xd9\xce\xc2\xc1\xcc\xd8"
+			     "\xd5\xce\xb2\xb5\xaf\xa4\x61\x6f"
+			     "\x7a\x79\x6f\x90\x94\x8f\xba\x82"
+			     "\x8f\x84\x98\x8f\xf1\xf2\xef\x99"
+			     "\xa4\xaf\xa5\xba\xae\x55\x50\x4c"
+			     "\x79\x7a\x4e\x41\x5b\x48\x35\x33"
+			     "\x2e\xd5\xdb\xec\xe0\xe3\xee\x16"
+			     "\x13\x10\x34\x3b\x0d\x06\x03\x0d"
+			     "\x78\x7b\x71\x16\x1a\x29\x24\x20"
+			     "\x2d\x26\xda\xed\xf7\xfc\xc9\xc7"
+			     "\xc2\xc1\xc7\xb8\x4c\x57\x52\x6a"
+			     "\x67\x7c\x60\x67\x99\xaa\xb7\xb1"
+			     "\x8c\x97\x9d\x82\x86\xfd\x88\x94"
+			     "\x91\x92\xb6\xb9\xa3\xa0\x5d\x6b"
+			     "\x76\x7d\x73\x54\x58\x4b\x46\x3e"
+			     "\xcb\xc8\xdc\xd3\xf5\xfe\xeb\xe5"
+			     "\x20\x23\x29\x3e\x32\x11\x1c\x08"
+			     "\x05\x7e\x02\x05\x1f\x14\x31\x3f"
+			     "\x2a\x29\x1f\xe0\xe4\xff\xea\xd2"
+			     "\xdf\xd4\xc8\x3f\x41\x42\x5f\x49"
+			     "\x74\x7f\x75\x6a\x5e\xa5\xa0\xbc"
+			     "\xa9\xaa\x9e\x91\x8b\xf8\x85\x83"
+			     "\x9e\x85\x8b\xbc\xb0\x93\x9e\x66"
+			     "\x63\x60\x64\x6b\x5d\x56\xb3\xbd"
+			     "\xc8\xcb\xc1\xc6\xca\xf9\xf4\xd0"
+			     "\xdd\xd6\x2a\x3d\x27\x2c\x19\x17"
+			     "\x72\x71\x77\x08\x1c\x07\x02\x3a"
+			     "\x37\x0c\x10\x17\xe9\xfa\xe7\xe1"
+			     "\xdc\x27\x2d\x32\x36\x4d\x58\x44"
+			     "\x41\x42\x46\x49\x53\x50\xad\xbb"
+			     "\xa6\xad\xa3\xe4\xe8\xfb\xf6\x8e"
+			     "\x9b\x98\x8c\x83\x85\x8e\x9b\x95"
+			     "\x70\x73\x79\x6e\x62\xa1\xac\xb8"
+			     "\xb5\xae\xd2\xd5\xcf\xc4\xc1\xcf"
+			     "\xda\xd9\xcf\x30\x34\x2f\x5a\x62"
+			     "\x6f\x64\x78\x6f\x11\x12\x0f\x39"
+			     "\x04\x0f\x05\x1a\x0e\xf5\xf0\xec"
+			     "\x19\x1a\x2e\x21\x3b\x28\x55\x53"
+			     "\x4e\x75\x7b\x4c\x40\x43\x4e\xb6"
+			     "\xb3\xb0\xd4\xdb\xed\xe6\xe3\xed"
+			     "\x98\x9b\x91\xb6\xba\x89\x84\x80"
+			     "\x8d\x86\x7a\x8d\x97\x9c\xa9\xa7"
+			     "\xa2\xa1\xa7\xd8\xec\xf7\xf2\xca"
+			     "\xc7\xdc\xc0\xc7\x39\x4a\x57\x51"
+			     "\x6c\x77\x7d\x62\x66\x1d\x28\x34"
+			     "\x31\x32\x16\x19\x03\x00\xfd\x0b"
+			     "\x16\x1d\x13\x34\x38\x2b\x26\x5e"
+			     "\x6b\x68\x7c\x73\x55\x5e\x4b\x45",
+		.psize = 1536,
+		.digest = "\xdc\x75\xca\xe0",
+	}
+};
+
+/*
+ * CRC-T10DIF test vectors
+ */
+#define CRCT10DIF_TEST_VECTORS 4
+
+static struct hash_testvec crct10dif_tv_template[] = {
+	{
+		.plaintext = "\x61\x62\x63",
+		.psize = 3,
+#ifdef __LITTLE_ENDIAN
+		.digest = "\x3b\x44",
+#else
+		.digest = "\x44\x3b",
+#endif
+	},
+	{
+		.plaintext = "\x01\x02\x03\x04\x05\x06\x07\x08"
+			     "\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10"
+			     "\x11\x12\x13\x14\x15\x16\x17\x18"
+			     "\x19\x1a\x1b\x1c\x1d\x1e\x1f\x20"
+			     "\x21\x22\x23\x24\x25\x26\x27\x28"
+			     "\x29\x2a\x2b\x2c\x2d\x2e\x2f\x30"
+			     "\x31\x32\x33\x34\x35\x36\x37\x38",
+		.psize = 56,
+#ifdef __LITTLE_ENDIAN
+		.digest = "\x11\xa7",
+#else
+		.digest = "\xa7\x11",
+#endif
 	},
+	{
+		.plaintext = "\x01\x02\x03\x04\x05\x06\x07\x08"
+			     "\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10"
+			     "\x11\x12\x13\x14\x15\x16\x17\x18"
+			     "\x19\x1a\x1b\x1c\x1d\x1e\x1f\x20"
+			     "\x21\x22\x23\x24\x25\x26\x27\x28"
+			     "\x29\x2a\x2b\x2c\x2d\x2e\x2f\x30"
+			     "\x31\x32\x33\x34\x35\x36\x37\x38"
+			     "\x39\x3a\x3b\x3c\x3d\x3e\x3f\x40"
+			     "\x41\x42\x43\x44\x45\x46\x47\x48"
+			     "\x49\x4a\x4b\x4c\x4d\x4e\x4f\x50"
+			     "\x51\x52\x53\x54\x55\x56\x57\x58"
+			     "\x59\x5a\x5b\x5c\x5d\x5e\x5f\x60"
+			     "\x61\x62\x63\x64\x65\x66\x67\x68"
+			     "\x69\x6a\x6b\x6c\x6d\x6e\x6f\x70"
+			     "\x71\x72\x73\x74\x75\x76\x77\x78"
+			     "\x79\x7a\x7b\x7c\x7d\x7e\x7f\x80"
+			     "\x81\x82\x83\x84\x85\x86\x87\x88"
+			     "\x89\x8a\x8b\x8c\x8d\x8e\x8f\x90"
+			     "\x91\x92\x93\x94\x95\x96\x97\x98"
+			     "\x99\x9a\x9b\x9c\x9d\x9e\x9f\xa0"
+			     "\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8"
+			     "\xa9\xaa\xab\xac\xad\xae\xaf\xb0"
+			     "\xb1\xb2\xb3\xb4\xb5\xb6\xb7\xb8"
+			     "\xb9\xba\xbb\xbc\xbd\xbe\xbf\xc0"
+			     "\xc1\xc2\xc3\xc4\xc5\xc6\xc7\xc8"
+			     "\xc9\xca\xcb\xcc\xcd\xce\xcf\xd0"
+			     "\xd1\xd2\xd3\xd4\xd5\xd6\xd7\xd8"
+			     "\xd9\xda\xdb\xdc\xdd\xde\xdf\xe0"
+			     "\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8"
+			     "\xe9\xea\xeb\xec\xed\xee\xef\xf0",
+		.psize = 240,
+#ifdef __LITTLE_ENDIAN
+		.digest = "\x8c\xe7",
+#else
+		.digest = "\xe7\x8c",
+#endif
+		.np = 2,
+		.tap = { 100, 140 }
+	},
+	{
+		.plaintext = "\x00\x05\x0d\x10\x1a\x24\x23\x3b"
+			     "\x33\x32\x48\x5d\x45\x49\x76\x7c"
+			     "\x66\x6f\x67\x9e\x90\x8e\x85\x81"
+			     "\x89\x8c\x92\x9b\xe3\xe3\xf8\xf2"
+			     "\xcc\xc9\xc1\xc4\xce\x30\x3f\x27"
+			     "\x2f\x26\x1c\x11\x09\x05\x02\x08"
+			     "\x12\x13\x1b\x22\x24\x3a\x31\xcd"
+			     "\xc5\xc0\xc6\xcf\xf7\xff\xe4\xee"
+			     "\x98\x9d\x95\x88\x82\xbc\x8b\x93"
+			     "\x9b\x9a\x60\x65\x7d\x71\x4e\x44"
+			     "\x5e\x47\x4f\x36\x38\x26\x2d\x19"
+			     "\x11\x14\x0a\x03\xfb\x0b\x10\x1a"
+			     "\x24\x21\x29\x3c\x36\x48\x47\x5f"
+			     "\x57\x4e\x74\x79\x61\x6d\x9a\x90"
+			     "\x8a\x8b\x83\xba\x8c\x92\x99\xe5"
+			     "\xed\xe8\xfe\xf7\xcf\xc7\xdc\xd6"
+			     "\x30\x35\x3d\x20\x2a\x14\x13\x0b"
+			     "\x03\x02\x78\x0d\x15\x19\x26\x2c"
+			     "\x36\x3f\x37\xce\xc0\xde\xd5\xf1"
+			     "\xf9\xfc\xe2\xeb\x93\x93\x88\x82"
+			     "\xbc\xb9\xb1\x94\x9e\x60\x6f\x77"
+			     "\x7f\x76\x4c\x41\x59\x55\x32\x38"
+			     "\x22\x23\x2b\x12\x14\x0a\x01\xfd"
+			     "\xf5\xf0\x16\x1f\x27\x2f\x34\x3e"
+			     "\x48\x4d\x45\x58\x52\x6c\x7b\x63"
+			     "\x6b\x6a\x90\x95\x8d\x81\xbe\xb4"
+			     "\xae\x97\x9f\xe6\xe8\xf6\xfd\xc9"
+			     "\xc1\xc4\xda\xd3\x2b\x3b\x20\x2a"
+			     "\x14\x11\x19\x0c\x06\x78\x77\x6f"
+			     "\x67\x1e\x24\x29\x31\x3d\xca\xc0"
+			     "\xda\xdb\xd3\xea\xfc\xe2\xe9\x95"
+			     "\x9d\x98\x8e\x87\xbf\xb7\xac\xa6"
+			     "\x60\x65\x6d\x70\x7a\x44\x43\x5b"
+			     "\x53\x52\x28\x3d\x25\x29\x16\x1c"
+			     "\x06\x0f\x07\xfe\xf0\xee\xe5\x21"
+			     "\x29\x2c\x32\x3b\x43\x43\x58\x52"
+			     "\x6c\x69\x61\x64\x6e\x90\x9f\x87"
+			     "\x8f\x86\xbc\xb1\xa9\xa5\xe2\xe8"
+			     "\xf2\xf3\xfb\xc2\xc4\xda\xd1\x2d"
+			     "\x25\x20\x26\x2f\x17\x1f\x04\x0e"
+			     "\x78\x7d\x75\x68\x62\x5c\x2b\x33"
+			     "\x3b\x3a\xc0\xc5\xdd\xd1\xee\xe4"
+			     "\xfe\xe7\xef\x96\x98\x86\x8d\xb9"
+			     "\xb1\xb4\xaa\xa3\x5b\x6b\x70\x7a"
+			     "\x44\x41\x49\x5c\x56\x28\x27\x3f"
+			     "\x37\x2e\x14\x19\x01\x0d\xfa\xf0"
+			     "\xea\xeb\xe3\xda\x2c\x32\x39\x45"
+			     "\x4d\x48\x5e\x57\x6f\x67\x7c\x76"
+			     "\x90\x95\x9d\x80\x8a\xb4\xb3\xab"
+			     "\xa3\xa2\xd8\xed\xf5\xf9\xc6\xcc"
+			     "\xd6\xdf\xd7\x2e\x20\x3e\x35\x11"
+			     "\x19\x1c\x02\x0b\x73\x73\x68\x62"
+			     "\x5c\x59\x51\x34\x3e\xc0\xcf\xd7"
+			     "\xdf\xd6\xec\xe1\xf9\xf5\x92\x98"
+			     "\x82\x83\x8b\xb2\xb4\xaa\xa1\x5d"
+			     "\x55\x50\x76\x7f\x47\x4f\x54\x5e"
+			     "\x28\x2d\x25\x38\x32\x0c\x1b\x03"
+			     "\x0b\x0a\xf0\xf5\xed\xe1\xde\xd4"
+			     "\xce\x37\x3f\x46\x48\x56\x5d\x69"
+			     "\x61\x64\x7a\x73\x8b\x9b\x80\x8a"
+			     "\xb4\xb1\xb9\xac\xa6\xd8\xd7\xcf"
+			     "\xc7\xfe\xc4\xc9\xd1\xdd\x2a\x20"
+			     "\x3a\x3b\x33\x0a\x1c\x02\x09\x75"
+			     "\x7d\x78\x6e\x67\x5f\x57\x4c\x46"
+			     "\xc0\xc5\xcd\xd0\xda\xe4\xe3\xfb"
+			     "\xf3\xf2\x88\x9d\x85\x89\xb6\xbc"
+			     "\xa6\xaf\xa7\x5e\x50\x4e\x45\x41"
+			     "\x49\x4c\x52\x5b\x23\x23\x38\x32"
+			     "\x0c\x09\x01\x04\x0e\xf0\xff\xe7"
+			     "\xef\xe6\xdc\xd1\xc9\xc5\x42\x48"
+			     "\x52\x53\x5b\x62\x64\x7a\x71\x8d"
+			     "\x85\x80\x86\x8f\xb7\xbf\xa4\xae"
+			     "\xd8\xdd\xd5\xc8\xc2\xfc\xcb\xd3"
+			     "\xdb\xda\x20\x25\x3d\x31\x0e\x04"
+			     "\x1e\x07\x0f\x76\x78\x66\x6d\x59"
+			     "\x51\x54\x4a\x43\xbb\xcb\xd0\xda"
+			     "\xe4\xe1\xe9\xfc\xf6\x88\x87\x9f"
+			     "\x97\x8e\xb4\xb9\xa1\xad\x5a\x50"
+			     "\x4a\x4b\x43\x7a\x4c\x52\x59\x25"
+			     "\x2d\x28\x3e\x37\x0f\x07\x1c\x16"
+			     "\xf0\xf5\xfd\xe0\xea\xd4\xd3\xcb"
+			     "\xc3\xc2\xb8\x4d\x55\x59\x66\x6c"
+			     "\x76\x7f\x77\x8e\x80\x9e\x95\xb1"
+			     "\xb9\xbc\xa2\xab\xd3\xd3\xc8\xc2"
+			     "\xfc\xf9\xf1\xd4\xde\x20\x2f\x37"
+			     "\x3f\x36\x0c\x01\x19\x15\x72\x78"
+			     "\x62\x63\x6b\x52\x54\x4a\x41\xbd"
+			     "\xb5\xb0\xd6\xdf\xe7\xef\xf4\xfe"
+			     "\x88\x8d\x85\x98\x92\xac\xbb\xa3"
+			     "\xab\xaa\x50\x55\x4d\x41\x7e\x74"
+			     "\x6e\x57\x5f\x26\x28\x36\x3d\x09"
+			     "\x01\x04\x1a\x13\xeb\xfb\xe0\xea"
+			     "\xd4\xd1\xd9\xcc\xc6\xb8\xb7\xaf"
+			     "\xa7\x5e\x64\x69\x71\x7d\x8a\x80"
+			     "\x9a\x9b\x93\xaa\xbc\xa2\xa9\xd5"
+			     "\xdd\xd8\xce\xc7\xff\xf7\xec\xe6"
+			     "\x20\x25\x2d\x30\x3a\x04\x03\x1b"
+			     "\x13\x12\x68\x7d\x65\x69\x56\x5c"
+			     "\x46\x4f\x47\xbe\xb0\xae\xa5\xe1"
+			     "\xe9\xec\xf2\xfb\x83\x83\x98\x92"
+			     "\xac\xa9\xa1\xa4\xae\x50\x5f\x47"
+			     "\x4f\x46\x7c\x71\x69\x65\x22\x28"
+			     "\x32\x33\x3b\x02\x04\x1a\x11\xed"
+			     "\xe5\xe0\xe6\xef\xd7\xdf\xc4\xce"
+			     "\xb8\xbd\xb5\xa8\xa2\x9c\x6b\x73"
+			     "\x7b\x7a\x80\x85\x9d\x91\xae\xa4"
+			     "\xbe\xa7\xaf\xd6\xd8\xc6\xcd\xf9"
+			     "\xf1\xf4\xea\xe3\x1b\x2b\x30\x3a"
+			     "\x04\x01\x09\x1c\x16\x68\x67\x7f"
+			     "\x77\x6e\x54\x59\x41\x4d\xba\xb0"
+			     "\xaa\xab\xa3\x9a\xec\xf2\xf9\x85"
+			     "\x8d\x88\x9e\x97\xaf\xa7\xbc\xb6"
+			     "\x50\x55\x5d\x40\x4a\x74\x73\x6b"
+			     "\x63\x62\x18\x2d\x35\x39\x06\x0c"
+			     "\x16\x1f\x17\xee\xe0\xfe\xf5\xd1"
+			     "\xd9\xdc\xc2\xcb\xb3\xb3\xa8\xa2"
+			     "\x9c\x99\x91\x74\x7e\x80\x8f\x97"
+			     "\x9f\x96\xac\xa1\xb9\xb5\xd2\xd8"
+			     "\xc2\xc3\xcb\xf2\xf4\xea\xe1\x1d"
+			     "\x15\x10\x36\x3f\x07\x0f\x14\x1e"
+			     "\x68\x6d\x65\x78\x72\x4c\x5b\x43"
+			     "\x4b\x4a\xb0\xb5\xad\xa1\x9e\x94"
+			     "\x8e\xf7\xff\x86\x88\x96\x9d\xa9"
+			     "\xa1\xa4\xba\xb3\x4b\x5b\x40\x4a"
+			     "\x74\x71\x79\x6c\x66\x18\x17\x0f"
+			     "\x07\x3e\x04\x09\x11\x1d\xea\xe0"
+			     "\xfa\xfb\xf3\xca\xdc\xc2\xc9\xb5"
+			     "\xbd\xb8\xae\xa7\x9f\x97\x8c\x86"
+			     "\x80\x85\x8d\x90\x9a\xa4\xa3\xbb"
+			     "\xb3\xb2\xc8\xdd\xc5\xc9\xf6\xfc"
+			     "\xe6\xef\xe7\x1e\x10\x0e\x05\x01"
+			     "\x09\x0c\x12\x1b\x63\x63\x78\x72"
+			     "\x4c\x49\x41\x44\x4e\xb0\xbf\xa7"
+			     "\xaf\xa6\x9c\x91\x89\x85\x82\x88"
+			     "\x92\x93\x9b\xa2\xa4\xba\xb1\x4d"
+			     "\x45\x40\x46\x4f\x77\x7f\x64\x6e"
+			     "\x18\x1d\x15\x08\x02\x3c\x0b\x13"
+			     "\x1b\x1a\xe0\xe5\xfd\xf1\xce\xc4"
+			     "\xde\xc7\xcf\xb6\xb8\xa6\xad\x99"
+			     "\x91\x94\x8a\x83\x7b\x8b\x90\x9a"
+			     "\xa4\xa1\xa9\xbc\xb6\xc8\xc7\xdf"
+			     "\xd7\xce\xf4\xf9\xe1\xed\x1a\x10"
+			     "\x0a\x0b\x03\x3a\x0c\x12\x19\x65"
+			     "\x6d\x68\x7e\x77\x4f\x47\x5c\x56"
+			     "\xb0\xb5\xbd\xa0\xaa\x94\x93\x8b"
+			     "\x83\x82\xf8\x8d\x95\x99\xa6\xac"
+			     "\xb6\xbf\xb7\x4e\x40\x5e\x55\x71"
+			     "\x79\x7c\x62\x6b\x13\x13\x08\x02"
+			     "\x3c\x39\x31\x14\x1e\xe0\xef\xf7"
+			     "\xff\xf6\xcc\xc1\xd9\xd5\xb2\xb8"
+			     "\xa2\xa3\xab\x92\x94\x8a\x81\x7d"
+			     "\x75\x70\x96\x9f\xa7\xaf\xb4\xbe"
+			     "\xc8\xcd\xc5\xd8\xd2\xec\xfb\xe3"
+			     "\xeb\xea\x10\x15\x0d\x01\x3e\x34"
+			     "\x2e\x17\x1f\x66\x68\x76\x7d\x49"
+			     "\x41\x44\x5a\x53\xab\xbb\xa0\xaa"
+			     "\x94\x91\x99\x8c\x86\xf8\xf7\xef"
+			     "\xe7\x9e\xa4\xa9\xb1\xbd\x4a\x40"
+			     "\x5a\x5b\x53\x6a\x7c\x62\x69\x15"
+			     "\x1d\x18\x0e\x07\x3f\x37\x2c\x26"
+			     "\xe0\xe5\xed\xf0\xfa\xc4\xc3\xdb"
+			     "\xd3\xd2\xa8\xbd\xa5\xa9\x96\x9c"
+			     "\x86\x8f\x87\x7e\x70\x6e\x65\xa1"
+			     "\xa9\xac\xb2\xbb\xc3\xc3\xd8\xd2"
+			     "\xec\xe9\xe1\xe4\xee\x10\x1f\x07"
+			     "\x0f\x06\x3c\x31\x29\x25\x62\x68"
+			     "\x72\x73\x7b\x42\x44\x5a\x51\xad"
+			     "\xa5\xa0\xa6\xaf\x97\x9f\x84\x8e"
+			     "\xf8\xfd\xf5\xe8\xe2\xdc\xab\xb3"
+			     "\xbb\xba\x40\x45\x5d\x51\x6e\x64"
+			     "\x7e\x67\x6f\x16\x18\x06\x0d\x39"
+			     "\x31\x34\x2a\x23\xdb\xeb\xf0\xfa"
+			     "\xc4\xc1\xc9\xdc\xd6\xa8\xa7\xbf"
+			     "\xb7\xae\x94\x99\x81\x8d\x7a\x70"
+			     "\x6a\x6b\x63\x5a\xac\xb2\xb9\xc5"
+			     "\xcd\xc8\xde\xd7\xef\xe7\xfc\xf6"
+			     "\x10\x15\x1d\x00\x0a\x34\x33\x2b"
+			     "\x23\x22\x58\x6d\x75\x79\x46\x4c"
+			     "\x56\x5f\x57\xae\xa0\xbe\xb5\x91"
+			     "\x99\x9c\x82\x8b\xf3\xf3\xe8\xe2"
+			     "\xdc\xd9\xd1\xb4\xbe\x40\x4f\x57"
+			     "\x5f\x56\x6c\x61\x79\x75\x12\x18"
+			     "\x02\x03\x0b\x32\x34\x2a\x21\xdd"
+			     "\xd5\xd0\xf6\xff\xc7\xcf\xd4\xde"
+			     "\xa8\xad\xa5\xb8\xb2\x8c\x9b\x83"
+			     "\x8b\x8a\x70\x75\x6d\x61\x5e\x54"
+			     "\x4e\xb7\xbf\xc6\xc8\xd6\xdd\xe9"
+			     "\xe1\xe4\xfa\xf3\x0b\x1b\x00\x0a"
+			     "\x34\x31\x39\x2c\x26\x58\x57\x4f"
+			     "\x47\x7e\x44\x49\x51\x5d\xaa\xa0"
+			     "\xba\xbb\xb3\x8a\x9c\x82\x89\xf5"
+			     "\xfd\xf8\xee\xe7\xdf\xd7\xcc\xc6"
+			     "\x40\x45\x4d\x50\x5a\x64\x63\x7b"
+			     "\x73\x72\x08\x1d\x05\x09\x36\x3c"
+			     "\x26\x2f\x27\xde\xd0\xce\xc5\xc1"
+			     "\xc9\xcc\xd2\xdb\xa3\xa3\xb8\xb2"
+			     "\x8c\x89\x81\x84\x8e\x70\x7f\x67"
+			     "\x6f\x66\x5c\x51\x49\x45\xc2\xc8"
+			     "\xd2\xd3\xdb\xe2\xe4\xfa\xf1\x0d"
+			     "\x05\x00\x06\x0f\x37\x3f\x24\x2e"
+			     "\x58\x5d\x55\x48\x42\x7c\x4b\x53"
+			     "\x5b\x5a\xa0\xa5\xbd\xb1\x8e\x84"
+			     "\x9e\x87\x8f\xf6\xf8\xe6\xed\xd9"
+			     "\xd1\xd4\xca\xc3\x3b\x4b\x50\x5a"
+			     "\x64\x61\x69\x7c\x76\x08\x07\x1f"
+			     "\x17\x0e\x34\x39\x21\x2d\xda\xd0"
+			     "\xca\xcb\xc3\xfa\xcc\xd2\xd9\xa5"
+			     "\xad\xa8\xbe\xb7\x8f\x87\x9c\x96"
+			     "\x70\x75\x7d\x60\x6a\x54\x53\x4b"
+			     "\x43\x42\x38\xcd\xd5\xd9\xe6\xec"
+			     "\xf6\xff\xf7\x0e\x00\x1e\x15\x31"
+			     "\x39\x3c\x22\x2b\x53\x53\x48\x42"
+			     "\x7c\x79\x71\x54\x5e\xa0\xaf\xb7"
+			     "\xbf\xb6\x8c\x81\x99\x95\xf2\xf8"
+			     "\xe2\xe3\xeb\xd2\xd4\xca\xc1\x3d"
+			     "\x35\x30\x56\x5f\x67\x6f\x74\x7e"
+			     "\x08\x0d\x05\x18\x12\x2c\x3b\x23"
+			     "\x2b\x2a\xd0\xd5\xcd\xc1\xfe\xf4"
+			     "\xee\xd7\xdf\xa6\xa8\xb6\xbd\x89"
+			     "\x81\x84\x9a\x93\x6b\x7b\x60\x6a"
+			     "\x54\x51\x59\x4c\x46\x38\x37\x2f"
+			     "\x27\xde\xe4\xe9\xf1\xfd\x0a\x00"
+			     "\x1a\x1b\x13\x2a\x3c\x22\x29\x55"
+			     "\x5d\x58\x4e\x47\x7f\x77\x6c\x66"
+			     "\xa0\xa5\xad\xb0\xba\x84\x83\x9b"
+			     "\x93\x92\xe8\xfd\xe5\xe9\xd6\xdc"
+			     "\xc6\xcf\xc7\x3e\x30\x2e\x25\x61"
+			     "\x69\x6c\x72\x7b\x03\x03\x18\x12"
+			     "\x2c\x29\x21\x24\x2e\xd0\xdf\xc7"
+			     "\xcf\xc6\xfc\xf1\xe9\xe5\xa2\xa8"
+			     "\xb2\xb3\xbb\x82\x84\x9a\x91\x6d"
+			     "\x65\x60\x66\x6f\x57\x5f\x44\x4e"
+			     "\x38\x3d\x35\x28\x22\x1c\xeb\xf3"
+			     "\xfb\xfa\x00\x05\x1d\x11\x2e\x24"
+			     "\x3e\x27\x2f\x56\x58\x46\x4d\x79"
+			     "\x71\x74\x6a\x63\x9b\xab\xb0\xba"
+			     "\x84\x81\x89\x9c\x96\xe8\xe7\xff"
+			     "\xf7\xee\xd4\xd9\xc1\xcd\x3a\x30"
+			     "\x2a\x2b\x23\x1a\x6c\x72\x79\x05"
+			     "\x0d\x08\x1e\x17\x2f\x27\x3c\x36"
+			     "\xd0\xd5\xdd\xc0\xca\xf4\xf3\xeb"
+			     "\xe3\xe2\x98\xad\xb5\xb9\x86\x8c"
+			     "\x96\x9f\x97\x6e\x60\x7e\x75\x51"
+			     "\x59\x5c\x42\x4b\x33\x33\x28\x22"
+			     "\x1c\x19\x11\xf4\xfe\x00\x0f\x17"
+			     "\x1f\x16\x2c\x21\x39\x35\x52\x58"
+			     "\x42\x43\x4b\x72\x74\x6a\x61\x9d"
+			     "\x95\x90\xb6\xbf\x87\x8f\x94\x9e"
+			     "\xe8\xed\xe5\xf8\xf2\xcc\xdb\xc3"
+			     "\xcb\xca\x30\x35\x2d\x21\x1e\x14"
+			     "\x0e\x77\x7f\x06\x08\x16\x1d\x29"
+			     "\x21\x24\x3a\x33\xcb\xdb\xc0\xca"
+			     "\xf4\xf1\xf9\xec\xe6\x98\x97\x8f"
+			     "\x87\xbe\x84\x89\x91\x9d\x6a\x60"
+			     "\x7a\x7b\x73\x4a\x5c\x42\x49\x35"
+			     "\x3d\x38\x2e\x27\x1f\x17\x0c\x06",
+		.psize = 2048,
+#ifdef __LITTLE_ENDIAN
+		.digest = "\x32\x6f",
+#else
+		.digest = "\x6f\x32",
+#endif
+	}
 };
 
 /*
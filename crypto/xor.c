@@ -60,11 +60,24 @@ static struct xor_block_template *template_list;
 
 #define BENCH_SIZE (PAGE_SIZE)
 
+/*
+ * The benchmark walks a page at a time through two areas, one in each
+ * half of a 2MB allocation.  With 4K pages that is close to 256 pages
+ * per area, the default number of stripes in the md raid5 stripe cache,
+ * and more than the inner caches hold: templates that write around the
+ * cache are then measured on the kind of data they are meant for rather
+ * than on one hot page.  If that much memory is not available, fall
+ * back to the original four pages.
+ */
+#define BENCH_ORDER	get_order(2 << 20)
+#define BENCH_ORDER_MIN	2
+
 static void
-do_xor_speed(struct xor_block_template *tmpl, void *b1, void *b2)
+do_xor_speed(struct xor_block_template *tmpl, void *b1, void *b2,
+	     unsigned long span)
 {
 	int speed;
-	unsigned long now, j;
+	unsigned long now, j, off;
 	int i, count, max;
 
 	tmpl->next = template_list;
@@ -74,10 +87,12 @@ do_xor_speed(struct xor_block_template *tmpl, void *b1, void *b2)
 
 	/*
 	 * Count the number of XORs done during a whole jiffy, and use
-	 * this to calculate the speed of checksumming.  We use a 2-page
-	 * allocation to have guaranteed color L1-cache layout.
+	 * this to calculate the speed of checksumming.  b2 is one page
+	 * further into its half of the allocation than b1, to have a
+	 * guaranteed color L1-cache layout.
 	 */
 	max = 0;
+	off = 0;
 	for (i = 0; i < 5; i++) {
 		j = jiffies;
 		count = 0;
@@ -85,9 +100,12 @@ do_xor_speed(struct xor_block_template *tmpl, void *b1, void *b2)
 			cpu_relax();
 		while (time_before(jiffies, now + 1)) {
 			mb(); /* prevent loop optimzation */
-			tmpl->do_2(BENCH_SIZE, b1, b2);
+			tmpl->do_2(BENCH_SIZE, b1 + off, b2 + off);
 			mb();
 			count++;
+			off += BENCH_SIZE;
+			if (off == span)
+				off = 0;
 			mb();
 		}
 		if (count > max)
@@ -107,6 +125,8 @@ static int __init
 calibrate_xor_blocks(void)
 {
 	void *b1, *b2;
+	unsigned int order = BENCH_ORDER;
+	unsigned long span;
 	struct xor_block_template *f, *fastest;
 
 	/*
@@ -114,12 +134,19 @@ calibrate_xor_blocks(void)
 	 * test the XOR speed, we don't really want kmemcheck to warn about
 	 * reading uninitialized bytes here.
 	 */
-	b1 = (void *) __get_free_pages(GFP_KERNEL | __GFP_NOTRACK, 2);
+	b1 = (void *) __get_free_pages(GFP_KERNEL | __GFP_NOTRACK |
+				       __GFP_NOWARN, order);
+	if (!b1) {
+		order = BENCH_ORDER_MIN;
+		b1 = (void *) __get_free_pages(GFP_KERNEL | __GFP_NOTRACK,
+					       order);
+	}
 	if (!b1) {
 		printk(KERN_WARNING "xor: Yikes!  No memory available.\n");
 		return -ENOMEM;
 	}
-	b2 = b1 + 2*PAGE_SIZE + BENCH_SIZE;
+	span = (PAGE_SIZE << order) / 2 - BENCH_SIZE;
+	b2 = b1 + span + 2 * BENCH_SIZE;
 
 	/*
 	 * If this arch/cpu has a short-circuited selection, don't loop through
@@ -132,7 +159,7 @@ calibrate_xor_blocks(void)
 		fastest = XOR_SELECT_TEMPLATE(fastest);
 #endif
 
-#define xor_speed(templ)	do_xor_speed((templ), b1, b2)
+#define xor_speed(templ)	do_xor_speed((templ), b1, b2, span)
 
 	if (fastest) {
 		printk(KERN_INFO "xor: automatically using best "
@@ -154,7 +181,7 @@ calibrate_xor_blocks(void)
 #undef xor_speed
 
  out:
-	free_pages((unsigned long)b1, 2);
+	free_pages((unsigned long)b1, order);
 
 	active_template = fastest;
 	return 0;
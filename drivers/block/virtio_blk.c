@@ -13,16 +13,50 @@
 #include <linux/idr.h>
 
 #define PART_BITS 4
+#define VQ_NAME_LEN 16
 
 static int major;
 static DEFINE_IDA(vd_index_ida);
 
 struct workqueue_struct *virtblk_wq;
 
+struct virtio_blk_vq
+{
+	struct virtqueue *vq;
+
+	/* Protects the virtqueue and sg. */
+	spinlock_t lock;
+
+	/* Bios wait here for room in the virtqueue. */
+	wait_queue_head_t wait;
+
+	/* Buffers were added under a plug and are not kicked yet. */
+	bool kick_pending;
+
+	/* The device is suspended, bios wait for it to be restored. */
+	bool frozen;
+
+	char name[VQ_NAME_LEN];
+
+	/* Scatterlist: can be too big for stack. */
+	struct scatterlist *sg;
+} ____cacheline_aligned_in_smp;
+
 struct virtio_blk
 {
 	struct virtio_device *vdev;
-	struct virtqueue *vq;
+
+	/*
+	 * Request virtqueues.  Requests from the request queue all go to
+	 * the first one; with more than one, bios are sent straight to the
+	 * virtqueue of the submitting cpu.
+	 */
+	struct virtio_blk_vq *vqs;
+	unsigned int num_vqs;
+
+	/* Bios in virtblk_make_request or on a virtqueue. */
+	atomic_t bios_in_flight;
+	wait_queue_head_t drain_wait;
 
 	/* The disk structure for the kernel. */
 	struct gendisk *disk;
@@ -43,66 +77,151 @@ struct virtio_blk
 
 	/* Ida index - used to track minor number allocations. */
 	int index;
-
-	/* Scatterlist: can be too big for stack. */
-	struct scatterlist sg[/*sg_elems*/];
 };
 
 struct virtblk_req
 {
 	struct request *req;
+	struct bio *bio;
+	struct virtblk_req *next;
 	struct virtio_blk_outhdr out_hdr;
 	struct virtio_scsi_inhdr in_hdr;
 	u8 status;
 };
 
+static inline int virtblk_result(struct virtblk_req *vbr)
+{
+	switch (vbr->status) {
+	case VIRTIO_BLK_S_OK:
+		return 0;
+	case VIRTIO_BLK_S_UNSUPP:
+		return -ENOTTY;
+	default:
+		return -EIO;
+	}
+}
+
+static struct virtio_blk_vq *virtblk_vq(struct virtio_blk *vblk,
+					struct virtqueue *vq)
+{
+	unsigned int i;
+
+	for (i = 0; i < vblk->num_vqs; i++)
+		if (vblk->vqs[i].vq == vq)
+			return &vblk->vqs[i];
+	BUG();
+}
+
+static void virtblk_kick(struct virtio_blk_vq *vbq)
+{
+	unsigned long flags;
+	bool notify = false;
+
+	spin_lock_irqsave(&vbq->lock, flags);
+	/* Freezing kicked all virtqueues, which may be gone now. */
+	if (!vbq->frozen) {
+		vbq->kick_pending = false;
+		notify = virtqueue_kick_prepare(vbq->vq);
+	}
+	spin_unlock_irqrestore(&vbq->lock, flags);
+
+	/* The host may take a while, don't make others wait for the lock. */
+	if (notify)
+		virtqueue_notify(vbq->vq);
+}
+
+static void virtblk_bio_put(struct virtio_blk *vblk)
+{
+	if (atomic_dec_and_test(&vblk->bios_in_flight))
+		wake_up(&vblk->drain_wait);
+}
+
+/* Wait for all bios taken by virtblk_make_request to complete. */
+static void virtblk_drain_bios(struct virtio_blk *vblk)
+{
+	wait_event(vblk->drain_wait, !atomic_read(&vblk->bios_in_flight));
+}
+
+/* Called with the queue lock held. */
+static void virtblk_request_done(struct virtblk_req *vbr)
+{
+	struct request *req = vbr->req;
+	int error = virtblk_result(vbr);
+
+	switch (req->cmd_type) {
+	case REQ_TYPE_BLOCK_PC:
+		req->resid_len = vbr->in_hdr.residual;
+		req->sense_len = vbr->in_hdr.sense_len;
+		req->errors = vbr->in_hdr.errors;
+		break;
+	case REQ_TYPE_SPECIAL:
+		req->errors = (error != 0);
+		break;
+	default:
+		break;
+	}
+
+	__blk_end_request_all(req, error);
+}
+
 static void blk_done(struct virtqueue *vq)
 {
 	struct virtio_blk *vblk = vq->vdev->priv;
-	struct virtblk_req *vbr;
+	struct virtio_blk_vq *vbq = virtblk_vq(vblk, vq);
+	struct request_queue *q = vblk->disk->queue;
+	struct virtblk_req *vbr, *reqs = NULL, *bios = NULL;
+	struct virtblk_req **reqs_tail = &reqs, **bios_tail = &bios;
+	bool restart = false;
 	unsigned int len;
 	unsigned long flags;
 
-	spin_lock_irqsave(vblk->disk->queue->queue_lock, flags);
-	while ((vbr = virtqueue_get_buf(vblk->vq, &len)) != NULL) {
-		int error;
-
-		switch (vbr->status) {
-		case VIRTIO_BLK_S_OK:
-			error = 0;
-			break;
-		case VIRTIO_BLK_S_UNSUPP:
-			error = -ENOTTY;
-			break;
-		default:
-			error = -EIO;
-			break;
-		}
-
-		switch (vbr->req->cmd_type) {
-		case REQ_TYPE_BLOCK_PC:
-			vbr->req->resid_len = vbr->in_hdr.residual;
-			vbr->req->sense_len = vbr->in_hdr.sense_len;
-			vbr->req->errors = vbr->in_hdr.errors;
-			break;
-		case REQ_TYPE_SPECIAL:
-			vbr->req->errors = (error != 0);
-			break;
-		default:
-			break;
+	spin_lock_irqsave(&vbq->lock, flags);
+	while ((vbr = virtqueue_get_buf(vq, &len)) != NULL) {
+		if (vbr->bio) {
+			*bios_tail = vbr;
+			bios_tail = &vbr->next;
+		} else {
+			*reqs_tail = vbr;
+			reqs_tail = &vbr->next;
 		}
+	}
+	*reqs_tail = *bios_tail = NULL;
+	/*
+	 * The request function stops the queue under our lock when it
+	 * finds this virtqueue full, so we cannot miss restarting it.
+	 */
+	if (vbq == vblk->vqs)
+		restart = blk_queue_stopped(q);
+	spin_unlock_irqrestore(&vbq->lock, flags);
 
-		__blk_end_request_all(vbr->req, error);
+	while ((vbr = bios) != NULL) {
+		bios = vbr->next;
+		bio_endio(vbr->bio, virtblk_result(vbr));
 		mempool_free(vbr, vblk->pool);
+		virtblk_bio_put(vblk);
 	}
-	/* In case queue is stopped waiting for more buffers. */
-	blk_start_queue(vblk->disk->queue);
-	spin_unlock_irqrestore(vblk->disk->queue->queue_lock, flags);
+
+	if (reqs || restart) {
+		spin_lock_irqsave(q->queue_lock, flags);
+		while ((vbr = reqs) != NULL) {
+			reqs = vbr->next;
+			virtblk_request_done(vbr);
+			mempool_free(vbr, vblk->pool);
+		}
+		/* In case queue is stopped waiting for more buffers. */
+		if (restart)
+			blk_start_queue(q);
+		spin_unlock_irqrestore(q->queue_lock, flags);
+	}
+
+	/* Room for bios waiting for this virtqueue. */
+	wake_up(&vbq->wait);
 }
 
 static bool do_req(struct request_queue *q, struct virtio_blk *vblk,
 		   struct request *req)
 {
+	struct virtio_blk_vq *vbq = &vblk->vqs[0];
 	unsigned long num, out = 0, in = 0;
 	struct virtblk_req *vbr;
 
@@ -112,6 +231,7 @@ static bool do_req(struct request_queue *q, struct virtio_blk *vblk,
 		return false;
 
 	vbr->req = req;
+	vbr->bio = NULL;
 
 	if (req->cmd_flags & REQ_FLUSH) {
 		vbr->out_hdr.type = VIRTIO_BLK_T_FLUSH;
@@ -140,7 +260,10 @@ static bool do_req(struct request_queue *q, struct virtio_blk *vblk,
 		}
 	}
 
-	sg_set_buf(&vblk->sg[out++], &vbr->out_hdr, sizeof(vbr->out_hdr));
+	/* Interrupts are already off under the queue lock. */
+	spin_lock(&vbq->lock);
+
+	sg_set_buf(&vbq->sg[out++], &vbr->out_hdr, sizeof(vbr->out_hdr));
 
 	/*
 	 * If this is a packet command we need a couple of additional headers.
@@ -149,17 +272,17 @@ static bool do_req(struct request_queue *q, struct virtio_blk *vblk,
 	 * inhdr with additional status information before the normal inhdr.
 	 */
 	if (vbr->req->cmd_type == REQ_TYPE_BLOCK_PC)
-		sg_set_buf(&vblk->sg[out++], vbr->req->cmd, vbr->req->cmd_len);
+		sg_set_buf(&vbq->sg[out++], vbr->req->cmd, vbr->req->cmd_len);
 
-	num = blk_rq_map_sg(q, vbr->req, vblk->sg + out);
+	num = blk_rq_map_sg(q, vbr->req, vbq->sg + out);
 
 	if (vbr->req->cmd_type == REQ_TYPE_BLOCK_PC) {
-		sg_set_buf(&vblk->sg[num + out + in++], vbr->req->sense, SCSI_SENSE_BUFFERSIZE);
-		sg_set_buf(&vblk->sg[num + out + in++], &vbr->in_hdr,
+		sg_set_buf(&vbq->sg[num + out + in++], vbr->req->sense, SCSI_SENSE_BUFFERSIZE);
+		sg_set_buf(&vbq->sg[num + out + in++], &vbr->in_hdr,
 			   sizeof(vbr->in_hdr));
 	}
 
-	sg_set_buf(&vblk->sg[num + out + in++], &vbr->status,
+	sg_set_buf(&vbq->sg[num + out + in++], &vbr->status,
 		   sizeof(vbr->status));
 
 	if (num) {
@@ -172,11 +295,15 @@ static bool do_req(struct request_queue *q, struct virtio_blk *vblk,
 		}
 	}
 
-	if (virtqueue_add_buf(vblk->vq, vblk->sg, out, in, vbr, GFP_ATOMIC)<0) {
+	if (virtqueue_add_buf(vbq->vq, vbq->sg, out, in, vbr, GFP_ATOMIC)<0) {
+		/* Stop the queue while blk_done can't miss it, see there. */
+		blk_stop_queue(q);
+		spin_unlock(&vbq->lock);
 		mempool_free(vbr, vblk->pool);
 		return false;
 	}
 
+	spin_unlock(&vbq->lock);
 	return true;
 }
 
@@ -189,18 +316,129 @@ static void do_virtblk_request(struct request_queue *q)
 	while ((req = blk_peek_request(q)) != NULL) {
 		BUG_ON(req->nr_phys_segments + 2 > vblk->sg_elems);
 
-		/* If this request fails, stop queue and wait for something to
-		   finish to restart it. */
-		if (!do_req(q, vblk, req)) {
-			blk_stop_queue(q);
+		/* If this request fails, the queue is stopped until
+		   something finishes to restart it. */
+		if (!do_req(q, vblk, req))
 			break;
-		}
 		blk_start_request(req);
 		issued++;
 	}
 
 	if (issued)
-		virtqueue_kick(vblk->vq);
+		virtblk_kick(&vblk->vqs[0]);
+}
+
+static void virtblk_unplug(struct blk_plug_cb *cb, bool from_schedule)
+{
+	struct virtio_blk *vblk = cb->data;
+	unsigned int i;
+
+	for (i = 0; i < vblk->num_vqs; i++)
+		if (vblk->vqs[i].kick_pending)
+			virtblk_kick(&vblk->vqs[i]);
+	kfree(cb);
+}
+
+/*
+ * With more than one virtqueue, bios bypass the request queue and its
+ * lock: each goes to the virtqueue of the cpu it is submitted on, whose
+ * interrupt is steered to that cpu, and under a plug the host is only
+ * notified once the plug is flushed.
+ */
+static void virtblk_make_request(struct request_queue *q, struct bio *bio)
+{
+	struct virtio_blk *vblk = q->queuedata;
+	struct virtio_blk_vq *vbq;
+	struct virtblk_req *vbr;
+	unsigned int num, out, in;
+	bool notify;
+	DEFINE_WAIT(wait);
+
+	/* Flushes and FUA writes are sequenced by the request queue. */
+	if (bio->bi_rw & (REQ_FLUSH | REQ_FUA)) {
+		blk_queue_bio(q, bio);
+		return;
+	}
+
+	blk_queue_bounce(q, &bio);
+	BUG_ON(bio_phys_segments(q, bio) + 2 > vblk->sg_elems);
+
+	atomic_inc(&vblk->bios_in_flight);
+	vbr = mempool_alloc(vblk->pool, GFP_NOIO);
+	vbr->req = NULL;
+	vbr->bio = bio;
+	vbr->out_hdr.sector = bio->bi_sector;
+	vbr->out_hdr.ioprio = bio_prio(bio);
+
+	vbq = &vblk->vqs[raw_smp_processor_id() % vblk->num_vqs];
+
+	spin_lock_irq(&vbq->lock);
+	for (;;) {
+		/*
+		 * The virtqueue is going away or gone: don't hold up the
+		 * drain in virtblk_freeze, and wait for virtblk_restore.
+		 */
+		if (unlikely(vbq->frozen)) {
+			prepare_to_wait(&vbq->wait, &wait, TASK_UNINTERRUPTIBLE);
+			spin_unlock_irq(&vbq->lock);
+			virtblk_bio_put(vblk);
+			io_schedule();
+			finish_wait(&vbq->wait, &wait);
+			atomic_inc(&vblk->bios_in_flight);
+			spin_lock_irq(&vbq->lock);
+			continue;
+		}
+
+		/* Others use the sg while we sleep, so set it up each time. */
+		out = in = 0;
+		sg_set_buf(&vbq->sg[out++], &vbr->out_hdr, sizeof(vbr->out_hdr));
+		num = blk_bio_map_sg(q, bio, vbq->sg + out);
+		sg_set_buf(&vbq->sg[num + out + in++], &vbr->status,
+			   sizeof(vbr->status));
+
+		vbr->out_hdr.type = 0;
+		if (num) {
+			if (bio_data_dir(bio) == WRITE) {
+				vbr->out_hdr.type |= VIRTIO_BLK_T_OUT;
+				out += num;
+			} else {
+				vbr->out_hdr.type |= VIRTIO_BLK_T_IN;
+				in += num;
+			}
+		}
+
+		if (virtqueue_add_buf(vbq->vq, vbq->sg, out, in, vbr,
+				      GFP_ATOMIC) >= 0)
+			break;
+
+		/* Full: get everything moving and wait for a completion. */
+		vbq->kick_pending = false;
+		notify = virtqueue_kick_prepare(vbq->vq);
+		prepare_to_wait_exclusive(&vbq->wait, &wait,
+					  TASK_UNINTERRUPTIBLE);
+		spin_unlock_irq(&vbq->lock);
+		if (notify)
+			virtqueue_notify(vbq->vq);
+		io_schedule();
+		finish_wait(&vbq->wait, &wait);
+		spin_lock_irq(&vbq->lock);
+	}
+
+	/*
+	 * Sleeping above may have flushed our plug, so only look for it
+	 * now.
+	 */
+	if (blk_check_plugged(virtblk_unplug, vblk, sizeof(struct blk_plug_cb))) {
+		vbq->kick_pending = true;
+		spin_unlock_irq(&vbq->lock);
+		return;
+	}
+
+	vbq->kick_pending = false;
+	notify = virtqueue_kick_prepare(vbq->vq);
+	spin_unlock_irq(&vbq->lock);
+	if (notify)
+		virtqueue_notify(vbq->vq);
 }
 
 /* return id (s/n) string for *disk to *id_str
@@ -355,15 +593,97 @@ static void virtblk_config_changed(struct virtio_device *vdev)
 	queue_work(virtblk_wq, &vblk->config_work);
 }
 
+static int virtblk_alloc_vqs(struct virtio_blk *vblk)
+{
+	struct virtio_blk_vq *vbq;
+	unsigned int i;
+	u16 num_vqs;
+	int err;
+
+	err = virtio_config_val(vblk->vdev, VIRTIO_BLK_F_MQ,
+				offsetof(struct virtio_blk_config, num_queues),
+				&num_vqs);
+	if (err || !num_vqs)
+		num_vqs = 1;
+
+	/* One per cpu is all we can use. */
+	vblk->num_vqs = min_t(unsigned int, num_vqs, nr_cpu_ids);
+	vblk->vqs = kcalloc(vblk->num_vqs, sizeof(*vblk->vqs), GFP_KERNEL);
+	if (!vblk->vqs)
+		return -ENOMEM;
+
+	atomic_set(&vblk->bios_in_flight, 0);
+	init_waitqueue_head(&vblk->drain_wait);
+
+	for (i = 0; i < vblk->num_vqs; i++) {
+		vbq = &vblk->vqs[i];
+		spin_lock_init(&vbq->lock);
+		init_waitqueue_head(&vbq->wait);
+		if (vblk->num_vqs == 1)
+			strcpy(vbq->name, "requests");
+		else
+			snprintf(vbq->name, VQ_NAME_LEN, "req.%u", i);
+
+		vbq->sg = kmalloc(sizeof(*vbq->sg) * vblk->sg_elems,
+				  GFP_KERNEL);
+		if (!vbq->sg)
+			goto out_free;
+		sg_init_table(vbq->sg, vblk->sg_elems);
+	}
+	return 0;
+
+out_free:
+	while (i--)
+		kfree(vblk->vqs[i].sg);
+	kfree(vblk->vqs);
+	return -ENOMEM;
+}
+
+static void virtblk_free_vqs(struct virtio_blk *vblk)
+{
+	unsigned int i;
+
+	for (i = 0; i < vblk->num_vqs; i++)
+		kfree(vblk->vqs[i].sg);
+	kfree(vblk->vqs);
+}
+
 static int init_vq(struct virtio_blk *vblk)
 {
-	int err = 0;
+	struct virtio_device *vdev = vblk->vdev;
+	vq_callback_t **callbacks;
+	const char **names;
+	struct virtqueue **vqs;
+	unsigned int i;
+	int err = -ENOMEM;
+
+	callbacks = kmalloc(vblk->num_vqs * sizeof(*callbacks), GFP_KERNEL);
+	names = kmalloc(vblk->num_vqs * sizeof(*names), GFP_KERNEL);
+	vqs = kmalloc(vblk->num_vqs * sizeof(*vqs), GFP_KERNEL);
+	if (!callbacks || !names || !vqs)
+		goto out;
+
+	for (i = 0; i < vblk->num_vqs; i++) {
+		callbacks[i] = blk_done;
+		names[i] = vblk->vqs[i].name;
+	}
+
+	err = vdev->config->find_vqs(vdev, vblk->num_vqs, vqs, callbacks,
+				     names);
+	if (err)
+		goto out;
 
-	/* We expect one virtqueue, for output. */
-	vblk->vq = virtio_find_single_vq(vblk->vdev, blk_done, "requests");
-	if (IS_ERR(vblk->vq))
-		err = PTR_ERR(vblk->vq);
+	for (i = 0; i < vblk->num_vqs; i++) {
+		vblk->vqs[i].vq = vqs[i];
+		/* Complete on the cpu that submits to it, see make_request. */
+		if (vblk->num_vqs > 1)
+			virtqueue_set_affinity(vqs[i], i);
+	}
 
+out:
+	kfree(vqs);
+	kfree(names);
+	kfree(callbacks);
 	return err;
 }
 
@@ -499,8 +819,7 @@ static int __devinit virtblk_probe(struct virtio_device *vdev)
 
 	/* We need an extra sg elements at head and tail. */
 	sg_elems += 2;
-	vdev->priv = vblk = kmalloc(sizeof(*vblk) +
-				    sizeof(vblk->sg[0]) * sg_elems, GFP_KERNEL);
+	vdev->priv = vblk = kmalloc(sizeof(*vblk), GFP_KERNEL);
 	if (!vblk) {
 		err = -ENOMEM;
 		goto out_free_index;
@@ -508,15 +827,18 @@ static int __devinit virtblk_probe(struct virtio_device *vdev)
 
 	vblk->vdev = vdev;
 	vblk->sg_elems = sg_elems;
-	sg_init_table(vblk->sg, vblk->sg_elems);
 	mutex_init(&vblk->config_lock);
 	INIT_WORK(&vblk->config_work, virtblk_config_changed_work);
 	vblk->config_enable = true;
 
-	err = init_vq(vblk);
+	err = virtblk_alloc_vqs(vblk);
 	if (err)
 		goto out_free_vblk;
 
+	err = init_vq(vblk);
+	if (err)
+		goto out_free_vqs;
+
 	vblk->pool = mempool_create_kmalloc_pool(1,sizeof(struct virtblk_req));
 	if (!vblk->pool) {
 		err = -ENOMEM;
@@ -536,6 +858,10 @@ static int __devinit virtblk_probe(struct virtio_device *vdev)
 		goto out_put_disk;
 	}
 
+	/* This resets the queue limits, so it goes before we set them. */
+	if (vblk->num_vqs > 1)
+		blk_queue_make_request(q, virtblk_make_request);
+
 	q->queuedata = vblk;
 
 	virtblk_name_format("vd", index, vblk->disk->disk_name, DISK_NAME_LEN);
@@ -645,6 +971,8 @@ out_mempool:
 	mempool_destroy(vblk->pool);
 out_free_vq:
 	vdev->config->del_vqs(vdev);
+out_free_vqs:
+	virtblk_free_vqs(vblk);
 out_free_vblk:
 	kfree(vblk);
 out_free_index:
@@ -666,6 +994,9 @@ static void __devexit virtblk_remove(struct virtio_device *vdev)
 	del_gendisk(vblk->disk);
 	blk_cleanup_queue(vblk->disk->queue);
 
+	/* The queue cleanup above only waits for requests, not for bios. */
+	virtblk_drain_bios(vblk);
+
 	/* Stop all the virtqueues. */
 	vdev->config->reset(vdev);
 
@@ -674,15 +1005,57 @@ static void __devexit virtblk_remove(struct virtio_device *vdev)
 	put_disk(vblk->disk);
 	mempool_destroy(vblk->pool);
 	vdev->config->del_vqs(vdev);
+	virtblk_free_vqs(vblk);
 	kfree(vblk);
 	ida_simple_remove(&vd_index_ida, index);
 }
 
 #ifdef CONFIG_PM
+/*
+ * Stop new bios from being added to the virtqueues and kick what was
+ * added under a plug, so that in flight bios complete.
+ */
+static void virtblk_freeze_vqs(struct virtio_blk *vblk)
+{
+	struct virtio_blk_vq *vbq;
+	unsigned int i;
+	bool notify;
+
+	for (i = 0; i < vblk->num_vqs; i++) {
+		vbq = &vblk->vqs[i];
+		spin_lock_irq(&vbq->lock);
+		vbq->frozen = true;
+		vbq->kick_pending = false;
+		notify = virtqueue_kick_prepare(vbq->vq);
+		spin_unlock_irq(&vbq->lock);
+		if (notify)
+			virtqueue_notify(vbq->vq);
+		/* Bios waiting for room go park until restore. */
+		wake_up_all(&vbq->wait);
+	}
+}
+
+static void virtblk_thaw_vqs(struct virtio_blk *vblk)
+{
+	struct virtio_blk_vq *vbq;
+	unsigned int i;
+
+	for (i = 0; i < vblk->num_vqs; i++) {
+		vbq = &vblk->vqs[i];
+		spin_lock_irq(&vbq->lock);
+		vbq->frozen = false;
+		spin_unlock_irq(&vbq->lock);
+		wake_up_all(&vbq->wait);
+	}
+}
+
 static int virtblk_freeze(struct virtio_device *vdev)
 {
 	struct virtio_blk *vblk = vdev->priv;
 
+	virtblk_freeze_vqs(vblk);
+	virtblk_drain_bios(vblk);
+
 	/* Ensure we don't receive any more interrupts */
 	vdev->config->reset(vdev);
 
@@ -710,6 +1083,7 @@ static int virtblk_restore(struct virtio_device *vdev)
 	vblk->config_enable = true;
 	ret = init_vq(vdev->priv);
 	if (!ret) {
+		virtblk_thaw_vqs(vblk);
 		spin_lock_irq(vblk->disk->queue->queue_lock);
 		blk_start_queue(vblk->disk->queue);
 		spin_unlock_irq(vblk->disk->queue->queue_lock);
@@ -726,7 +1100,8 @@ static const struct virtio_device_id id_table[] = {
 static unsigned int features[] = {
 	VIRTIO_BLK_F_SEG_MAX, VIRTIO_BLK_F_SIZE_MAX, VIRTIO_BLK_F_GEOMETRY,
 	VIRTIO_BLK_F_RO, VIRTIO_BLK_F_BLK_SIZE, VIRTIO_BLK_F_SCSI,
-	VIRTIO_BLK_F_WCE, VIRTIO_BLK_F_TOPOLOGY, VIRTIO_BLK_F_CONFIG_WCE
+	VIRTIO_BLK_F_WCE, VIRTIO_BLK_F_TOPOLOGY, VIRTIO_BLK_F_CONFIG_WCE,
+	VIRTIO_BLK_F_MQ
 };
 
 /*
@@ -36,7 +36,7 @@
 #include <linux/moduleparam.h>
 #include <linux/rtnetlink.h>
 #include <net/rtnetlink.h>
-#include <linux/u64_stats_sync.h>
+#include <linux/pcpu_stats.h>
 
 static int numdummies = 1;
 
@@ -54,33 +54,21 @@ struct pcpu_dstats {
 static struct rtnl_link_stats64 *dummy_get_stats64(struct net_device *dev,
 						   struct rtnl_link_stats64 *stats)
 {
-	int i;
-
-	for_each_possible_cpu(i) {
-		const struct pcpu_dstats *dstats;
-		u64 tbytes, tpackets;
-		unsigned int start;
-
-		dstats = per_cpu_ptr(dev->dstats, i);
-		do {
-			start = u64_stats_fetch_begin_bh(&dstats->syncp);
-			tbytes = dstats->tx_bytes;
-			tpackets = dstats->tx_packets;
-		} while (u64_stats_fetch_retry_bh(&dstats->syncp, start));
-		stats->tx_bytes += tbytes;
-		stats->tx_packets += tpackets;
-	}
+	struct pcpu_dstats sum;
+
+	pcpu_stats_fold(dev->dstats, &sum);
+	stats->tx_bytes += sum.tx_bytes;
+	stats->tx_packets += sum.tx_packets;
 	return stats;
 }
 
 static netdev_tx_t dummy_xmit(struct sk_buff *skb, struct net_device *dev)
 {
-	struct pcpu_dstats *dstats = this_cpu_ptr(dev->dstats);
+	struct pcpu_dstats *dstats = pcpu_stats_update_begin(dev->dstats);
 
-	u64_stats_update_begin(&dstats->syncp);
 	dstats->tx_packets++;
 	dstats->tx_bytes += skb->len;
-	u64_stats_update_end(&dstats->syncp);
+	pcpu_stats_update_end(dstats);
 
 	dev_kfree_skb(skb);
 	return NETDEV_TX_OK;
@@ -88,7 +76,7 @@ static netdev_tx_t dummy_xmit(struct sk_buff *skb, struct net_device *dev)
 
 static int dummy_dev_init(struct net_device *dev)
 {
-	dev->dstats = alloc_percpu(struct pcpu_dstats);
+	dev->dstats = pcpu_stats_alloc(struct pcpu_dstats);
 	if (!dev->dstats)
 		return -ENOMEM;
 
@@ -97,7 +85,7 @@ static int dummy_dev_init(struct net_device *dev)
 
 static void dummy_dev_uninit(struct net_device *dev)
 {
-	free_percpu(dev->dstats);
+	pcpu_stats_free(dev->dstats);
 }
 
 static const struct net_device_ops dummy_netdev_ops = {
@@ -57,7 +57,7 @@
 #include <linux/tcp.h>
 #include <linux/percpu.h>
 #include <net/net_namespace.h>
-#include <linux/u64_stats_sync.h>
+#include <linux/pcpu_stats.h>
 
 struct pcpu_lstats {
 	u64			packets;
@@ -79,15 +79,13 @@ static netdev_tx_t loopback_xmit(struct sk_buff *skb,
 
 	skb->protocol = eth_type_trans(skb, dev);
 
-	/* it's OK to use per_cpu_ptr() because BHs are off */
-	lb_stats = this_cpu_ptr(dev->lstats);
-
 	len = skb->len;
 	if (likely(netif_rx(skb) == NET_RX_SUCCESS)) {
-		u64_stats_update_begin(&lb_stats->syncp);
+		/* it's OK to use per cpu stats because BHs are off */
+		lb_stats = pcpu_stats_update_begin(dev->lstats);
 		lb_stats->bytes += len;
 		lb_stats->packets++;
-		u64_stats_update_end(&lb_stats->syncp);
+		pcpu_stats_update_end(lb_stats);
 	}
 
 	return NETDEV_TX_OK;
@@ -96,28 +94,13 @@ static netdev_tx_t loopback_xmit(struct sk_buff *skb,
 static struct rtnl_link_stats64 *loopback_get_stats64(struct net_device *dev,
 						      struct rtnl_link_stats64 *stats)
 {
-	u64 bytes = 0;
-	u64 packets = 0;
-	int i;
-
-	for_each_possible_cpu(i) {
-		const struct pcpu_lstats *lb_stats;
-		u64 tbytes, tpackets;
-		unsigned int start;
-
-		lb_stats = per_cpu_ptr(dev->lstats, i);
-		do {
-			start = u64_stats_fetch_begin_bh(&lb_stats->syncp);
-			tbytes = lb_stats->bytes;
-			tpackets = lb_stats->packets;
-		} while (u64_stats_fetch_retry_bh(&lb_stats->syncp, start));
-		bytes   += tbytes;
-		packets += tpackets;
-	}
-	stats->rx_packets = packets;
-	stats->tx_packets = packets;
-	stats->rx_bytes   = bytes;
-	stats->tx_bytes   = bytes;
+	struct pcpu_lstats sum;
+
+	pcpu_stats_fold(dev->lstats, &sum);
+	stats->rx_packets = sum.packets;
+	stats->tx_packets = sum.packets;
+	stats->rx_bytes   = sum.bytes;
+	stats->tx_bytes   = sum.bytes;
 	return stats;
 }
 
@@ -132,7 +115,7 @@ static const struct ethtool_ops loopback_ethtool_ops = {
 
 static int loopback_dev_init(struct net_device *dev)
 {
-	dev->lstats = alloc_percpu(struct pcpu_lstats);
+	dev->lstats = pcpu_stats_alloc(struct pcpu_lstats);
 	if (!dev->lstats)
 		return -ENOMEM;
 
@@ -141,7 +124,7 @@ static int loopback_dev_init(struct net_device *dev)
 
 static void loopback_dev_free(struct net_device *dev)
 {
-	free_percpu(dev->lstats);
+	pcpu_stats_free(dev->lstats);
 	free_netdev(dev);
 }
 
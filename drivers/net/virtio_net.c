@@ -18,6 +18,7 @@
  */
 //#define DEBUG
 #include <linux/netdevice.h>
+#include <linux/pcpu_stats.h>
 #include <linux/etherdevice.h>
 #include <linux/ethtool.h>
 #include <linux/module.h>
@@ -41,14 +42,22 @@ module_param(gso, bool, 0444);
 #define VIRTNET_SEND_COMMAND_SG_MAX    2
 #define VIRTNET_DRIVER_VERSION "1.0.0"
 
-struct virtnet_stats {
-	struct u64_stats_sync tx_syncp;
-	struct u64_stats_sync rx_syncp;
+struct virtnet_rx_stats {
+	u64 rx_bytes;
+	u64 rx_packets;
+	struct u64_stats_sync syncp;
+};
+
+struct virtnet_tx_stats {
 	u64 tx_bytes;
 	u64 tx_packets;
+	struct u64_stats_sync syncp;
+};
 
-	u64 rx_bytes;
-	u64 rx_packets;
+/* Receive and transmit paths update their counters independently */
+struct virtnet_stats {
+	struct virtnet_rx_stats rx;
+	struct virtnet_tx_stats tx;
 };
 
 struct virtnet_info {
@@ -265,7 +274,7 @@ static int receive_mergeable(struct virtnet_info *vi, struct sk_buff *skb)
 static void receive_buf(struct net_device *dev, void *buf, unsigned int len)
 {
 	struct virtnet_info *vi = netdev_priv(dev);
-	struct virtnet_stats *stats = this_cpu_ptr(vi->stats);
+	struct virtnet_rx_stats *stats;
 	struct sk_buff *skb;
 	struct page *page;
 	struct skb_vnet_hdr *hdr;
@@ -301,10 +310,10 @@ static void receive_buf(struct net_device *dev, void *buf, unsigned int len)
 
 	hdr = skb_vnet_hdr(skb);
 
-	u64_stats_update_begin(&stats->rx_syncp);
+	stats = pcpu_stats_update_begin(&vi->stats->rx);
 	stats->rx_bytes += skb->len;
 	stats->rx_packets++;
-	u64_stats_update_end(&stats->rx_syncp);
+	pcpu_stats_update_end(stats);
 
 	if (hdr->hdr.flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
 		pr_debug("Needs csum!\n");
@@ -561,15 +570,15 @@ static unsigned int free_old_xmit_skbs(struct virtnet_info *vi)
 {
 	struct sk_buff *skb;
 	unsigned int len, tot_sgs = 0;
-	struct virtnet_stats *stats = this_cpu_ptr(vi->stats);
+	struct virtnet_tx_stats *stats;
 
 	while ((skb = virtqueue_get_buf(vi->svq, &len)) != NULL) {
 		pr_debug("Sent skb %p\n", skb);
 
-		u64_stats_update_begin(&stats->tx_syncp);
+		stats = pcpu_stats_update_begin(&vi->stats->tx);
 		stats->tx_bytes += skb->len;
 		stats->tx_packets++;
-		u64_stats_update_end(&stats->tx_syncp);
+		pcpu_stats_update_end(stats);
 
 		tot_sgs += skb_vnet_hdr(skb)->num_sg;
 		dev_kfree_skb_any(skb);
@@ -696,30 +705,16 @@ static struct rtnl_link_stats64 *virtnet_stats(struct net_device *dev,
 					       struct rtnl_link_stats64 *tot)
 {
 	struct virtnet_info *vi = netdev_priv(dev);
-	int cpu;
-	unsigned int start;
-
-	for_each_possible_cpu(cpu) {
-		struct virtnet_stats *stats = per_cpu_ptr(vi->stats, cpu);
-		u64 tpackets, tbytes, rpackets, rbytes;
-
-		do {
-			start = u64_stats_fetch_begin_bh(&stats->tx_syncp);
-			tpackets = stats->tx_packets;
-			tbytes   = stats->tx_bytes;
-		} while (u64_stats_fetch_retry_bh(&stats->tx_syncp, start));
-
-		do {
-			start = u64_stats_fetch_begin_bh(&stats->rx_syncp);
-			rpackets = stats->rx_packets;
-			rbytes   = stats->rx_bytes;
-		} while (u64_stats_fetch_retry_bh(&stats->rx_syncp, start));
-
-		tot->rx_packets += rpackets;
-		tot->tx_packets += tpackets;
-		tot->rx_bytes   += rbytes;
-		tot->tx_bytes   += tbytes;
-	}
+	struct virtnet_rx_stats rx;
+	struct virtnet_tx_stats tx;
+
+	pcpu_stats_fold(&vi->stats->rx, &rx);
+	pcpu_stats_fold(&vi->stats->tx, &tx);
+
+	tot->rx_packets = rx.rx_packets;
+	tot->tx_packets = tx.tx_packets;
+	tot->rx_bytes   = rx.rx_bytes;
+	tot->tx_bytes   = tx.tx_bytes;
 
 	tot->tx_dropped = dev->stats.tx_dropped;
 	tot->tx_fifo_errors = dev->stats.tx_fifo_errors;
@@ -1108,7 +1103,7 @@ static int virtnet_probe(struct virtio_device *vdev)
 	vi->vdev = vdev;
 	vdev->priv = vi;
 	vi->pages = NULL;
-	vi->stats = alloc_percpu(struct virtnet_stats);
+	vi->stats = pcpu_stats_alloc(struct virtnet_stats);
 	err = -ENOMEM;
 	if (vi->stats == NULL)
 		goto free;
@@ -1166,7 +1161,7 @@ unregister:
 free_vqs:
 	vdev->config->del_vqs(vdev);
 free_stats:
-	free_percpu(vi->stats);
+	pcpu_stats_free(vi->stats);
 free:
 	free_netdev(dev);
 	return err;
@@ -1222,7 +1217,7 @@ static void __devexit virtnet_remove(struct virtio_device *vdev)
 
 	flush_work(&vi->config_work);
 
-	free_percpu(vi->stats);
+	pcpu_stats_free(vi->stats);
 	free_netdev(vi->dev);
 }
 
@@ -0,0 +1,69 @@
+/*
+ * Compressed RAM block device - compression backends and streams
+ *
+ * This code is released using a dual license strategy: BSD/GPL
+ * You can choose the licence that better fits your requirements.
+ *
+ * Released under the terms of 3-clause BSD License
+ * Released under the terms of GNU General Public License Version 2.0
+ */
+
+#ifndef _ZCOMP_H_
+#define _ZCOMP_H_
+
+#include <linux/list.h>
+#include <linux/spinlock.h>
+#include <linux/wait.h>
+
+/* A compression algorithm; both routines return 0 on success */
+struct zcomp_backend {
+	const char *name;
+	size_t workmem_size;
+	int (*compress)(const unsigned char *src, size_t src_len,
+			unsigned char *dst, size_t *dst_len, void *wrkmem);
+	int (*decompress)(const unsigned char *src, size_t src_len,
+			unsigned char *dst, size_t *dst_len);
+};
+
+/*
+ * A compression stream: the working memory and output buffer needed by
+ * one compression in flight.  Decompression needs neither.
+ */
+struct zcomp_strm {
+	void *workmem;
+	/* compression output, two pages to cover any backend's worst case */
+	void *buffer;
+	struct list_head list;
+};
+
+/*
+ * A pool of up to max_strm streams.  Streams are allocated on demand,
+ * so a device only pays for the parallelism it actually sees; writers
+ * beyond max_strm wait for a stream to be released.
+ */
+struct zcomp {
+	const struct zcomp_backend *backend;
+
+	spinlock_t strm_lock;		/* protects the fields below */
+	struct list_head idle_strm;
+	wait_queue_head_t strm_wait;
+	int avail_strm;			/* streams allocated, idle or busy */
+	int max_strm;
+};
+
+ssize_t zcomp_available_show(const char *comp, char *buf);
+bool zcomp_available_algorithm(const char *comp);
+
+struct zcomp *zcomp_create(const char *comp, int max_strm);
+void zcomp_destroy(struct zcomp *comp);
+bool zcomp_set_max_streams(struct zcomp *comp, int num_strm);
+
+struct zcomp_strm *zcomp_strm_find(struct zcomp *comp);
+void zcomp_strm_release(struct zcomp *comp, struct zcomp_strm *zstrm);
+
+int zcomp_compress(struct zcomp *comp, struct zcomp_strm *zstrm,
+		const unsigned char *src, size_t *dst_len);
+int zcomp_decompress(struct zcomp *comp, const unsigned char *src,
+		size_t src_len, unsigned char *dst);
+
+#endif
@@ -671,6 +671,8 @@ unsigned long zs_malloc(struct zs_pool *pool, size_t size)
 		set_zspage_mapping(first_page, class->index, ZS_EMPTY);
 		spin_lock(&class->lock);
 		class->pages_allocated += class->pages_per_zspage;
+		atomic_long_add(class->pages_per_zspage,
+				&pool->pages_allocated);
 	}
 
 	obj = (unsigned long)first_page->freelist;
@@ -724,8 +726,11 @@ void zs_free(struct zs_pool *pool, unsigned long obj)
 	first_page->inuse--;
 	fullness = fix_fullness_group(pool, first_page);
 
-	if (fullness == ZS_EMPTY)
+	if (fullness == ZS_EMPTY) {
 		class->pages_allocated -= class->pages_per_zspage;
+		atomic_long_sub(class->pages_per_zspage,
+				&pool->pages_allocated);
+	}
 
 	spin_unlock(&class->lock);
 
@@ -821,15 +826,15 @@ out:
 }
 EXPORT_SYMBOL_GPL(zs_unmap_object);
 
-u64 zs_get_total_size_bytes(struct zs_pool *pool)
+unsigned long zs_get_total_pages(struct zs_pool *pool)
 {
-	int i;
-	u64 npages = 0;
-
-	for (i = 0; i < ZS_SIZE_CLASSES; i++)
-		npages += pool->size_class[i].pages_allocated;
+	return atomic_long_read(&pool->pages_allocated);
+}
+EXPORT_SYMBOL_GPL(zs_get_total_pages);
 
-	return npages << PAGE_SHIFT;
+u64 zs_get_total_size_bytes(struct zs_pool *pool)
+{
+	return (u64)zs_get_total_pages(pool) << PAGE_SHIFT;
 }
 EXPORT_SYMBOL_GPL(zs_get_total_size_bytes);
 
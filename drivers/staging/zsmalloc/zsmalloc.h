@@ -38,6 +38,7 @@ void *zs_map_object(struct zs_pool *pool, unsigned long handle,
 			enum zs_mapmode mm);
 void zs_unmap_object(struct zs_pool *pool, unsigned long handle);
 
+unsigned long zs_get_total_pages(struct zs_pool *pool);
 u64 zs_get_total_size_bytes(struct zs_pool *pool);
 
 #endif
@@ -194,12 +194,13 @@ static void ctx_rcu_free(struct rcu_head *head)
 	kmem_cache_free(kioctx_cachep, ctx);
 }
 
-/* __put_ioctx
+/* free_ioctx
  *	Called when the last user of an aio context has gone away,
  *	and the struct needs to be freed.
  */
-static void __put_ioctx(struct kioctx *ctx)
+static void free_ioctx(struct work_struct *work)
 {
+	struct kioctx *ctx = container_of(work, struct kioctx, free_work);
 	unsigned nr_events = ctx->max_reqs;
 	BUG_ON(ctx->reqs_active);
 
@@ -213,20 +214,29 @@ static void __put_ioctx(struct kioctx *ctx)
 		aio_nr -= nr_events;
 		spin_unlock(&aio_nr_lock);
 	}
-	pr_debug("__put_ioctx: freeing %p\n", ctx);
+	pr_debug("free_ioctx: freeing %p\n", ctx);
 	call_rcu(&ctx->rcu_head, ctx_rcu_free);
 }
 
+/*
+ * The last reference may be dropped by the RCU callback that folds the
+ * percpu counts, in softirq context; the teardown sleeps, punt it.
+ */
+static void free_ioctx_ref(struct percpu_ref *ref)
+{
+	struct kioctx *ctx = container_of(ref, struct kioctx, users);
+
+	schedule_work(&ctx->free_work);
+}
+
 static inline int try_get_ioctx(struct kioctx *kioctx)
 {
-	return atomic_inc_not_zero(&kioctx->users);
+	return percpu_ref_tryget(&kioctx->users);
 }
 
 static inline void put_ioctx(struct kioctx *kioctx)
 {
-	BUG_ON(atomic_read(&kioctx->users) <= 0);
-	if (unlikely(atomic_dec_and_test(&kioctx->users)))
-		__put_ioctx(kioctx);
+	percpu_ref_put(&kioctx->users);
 }
 
 /* ioctx_alloc
@@ -256,7 +266,10 @@ static struct kioctx *ioctx_alloc(unsigned nr_events)
 	mm = ctx->mm = current->mm;
 	atomic_inc(&mm->mm_count);
 
-	atomic_set(&ctx->users, 2);
+	if (percpu_ref_init(&ctx->users, free_ioctx_ref))
+		goto out_freectx;
+	percpu_ref_get(&ctx->users);	/* one for the list, one for the caller */
+
 	spin_lock_init(&ctx->ctx_lock);
 	spin_lock_init(&ctx->ring_info.ring_lock);
 	init_waitqueue_head(&ctx->wait);
@@ -264,6 +277,7 @@ static struct kioctx *ioctx_alloc(unsigned nr_events)
 	INIT_LIST_HEAD(&ctx->active_reqs);
 	INIT_LIST_HEAD(&ctx->run_list);
 	INIT_DELAYED_WORK(&ctx->wq, aio_kick_handler);
+	INIT_WORK(&ctx->free_work, free_ioctx);
 
 	if (aio_setup_ring(ctx) < 0)
 		goto out_freectx;
@@ -291,6 +305,7 @@ out_cleanup:
 	err = -EAGAIN;
 	aio_free_ring(ctx);
 out_freectx:
+	percpu_ref_cancel_init(&ctx->users);
 	mmdrop(mm);
 	kmem_cache_free(kioctx_cachep, ctx);
 	dprintk("aio: error allocating ioctx %d\n", err);
@@ -376,23 +391,17 @@ void exit_aio(struct mm_struct *mm)
 
 		kill_ctx(ctx);
 
-		if (1 != atomic_read(&ctx->users))
-			printk(KERN_DEBUG
-				"exit_aio:ioctx still alive: %d %d %d\n",
-				atomic_read(&ctx->users), ctx->dead,
-				ctx->reqs_active);
 		/*
 		 * We don't need to bother with munmap() here -
 		 * exit_mmap(mm) is coming and it'll unmap everything.
 		 * Since aio_free_ring() uses non-zero ->mmap_size
 		 * as indicator that it needs to unmap the area,
-		 * just set it to 0; aio_free_ring() is the only
-		 * place that uses ->mmap_size, so it's safe.
-		 * That way we get all munmap done to current->mm -
-		 * all other callers have ctx->mm == current->mm.
+		 * just set it to 0, as io_destroy() does after its
+		 * own munmap; the context may be freed from a worker
+		 * that has no mm at all.
 		 */
 		ctx->ring_info.mmap_size = 0;
-		put_ioctx(ctx);
+		percpu_ref_kill(&ctx->users);
 	}
 }
 
@@ -595,9 +604,9 @@ static struct kioctx *lookup_ioctx(unsigned long ctx_id)
 	hlist_for_each_entry_rcu(ctx, n, &mm->ioctx_list, list) {
 		/*
 		 * RCU protects us against accessing freed memory but
-		 * we have to be careful not to get a reference when the
-		 * reference count already dropped to 0 (ctx->dead test
-		 * is unreliable because of races).
+		 * we have to be careful not to get a reference once the
+		 * refcount has been killed (ctx->dead test is unreliable
+		 * because of races).
 		 */
 		if (ctx->user_id == ctx_id && !ctx->dead && try_get_ioctx(ctx)){
 			ret = ctx;
@@ -1202,8 +1211,16 @@ static void io_destroy(struct kioctx *ioctx)
 	spin_unlock(&mm->ioctx_lock);
 
 	dprintk("aio_release(%p)\n", ioctx);
-	if (likely(!was_dead))
-		put_ioctx(ioctx);	/* twice for the list */
+	if (likely(!was_dead)) {
+		/*
+		 * The context may be freed from a worker, which has no mm:
+		 * unmap the ring now, while we are still in the owner's.
+		 */
+		vm_munmap(ioctx->ring_info.mmap_base,
+			  ioctx->ring_info.mmap_size);
+		ioctx->ring_info.mmap_size = 0;
+		percpu_ref_kill(&ioctx->users);	/* drops the list's ref */
+	}
 
 	kill_ctx(ioctx);
 
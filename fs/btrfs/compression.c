@@ -733,6 +733,8 @@ static wait_queue_head_t comp_workspace_wait[BTRFS_COMPRESS_TYPES];
 struct btrfs_compress_op *btrfs_compress_op[] = {
 	&btrfs_zlib_compress,
 	&btrfs_lzo_compress,
+	NULL,			/* BTRFS_COMPRESS_ZSTD is reserved */
+	&btrfs_lz4_compress,
 };
 
 void __init btrfs_init_compress(void)
@@ -756,12 +758,22 @@ static struct list_head *find_workspace(int type)
 	struct list_head *workspace;
 	int cpus = num_online_cpus();
 	int idx = type - 1;
-
-	struct list_head *idle_workspace	= &comp_idle_workspace[idx];
-	spinlock_t *workspace_lock		= &comp_workspace_lock[idx];
-	atomic_t *alloc_workspace		= &comp_alloc_workspace[idx];
-	wait_queue_head_t *workspace_wait	= &comp_workspace_wait[idx];
-	int *num_workspace			= &comp_num_workspace[idx];
+	struct list_head *idle_workspace;
+	spinlock_t *workspace_lock;
+	atomic_t *alloc_workspace;
+	wait_queue_head_t *workspace_wait;
+	int *num_workspace;
+
+	/* the type may come straight off disk */
+	if (type <= BTRFS_COMPRESS_NONE || type >= BTRFS_COMPRESS_LAST ||
+	    !btrfs_compress_op[idx])
+		return ERR_PTR(-EIO);
+
+	idle_workspace	= &comp_idle_workspace[idx];
+	workspace_lock	= &comp_workspace_lock[idx];
+	alloc_workspace	= &comp_alloc_workspace[idx];
+	workspace_wait	= &comp_workspace_wait[idx];
+	num_workspace	= &comp_num_workspace[idx];
 again:
 	spin_lock(workspace_lock);
 	if (!list_empty(idle_workspace)) {
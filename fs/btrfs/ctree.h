@@ -489,6 +489,13 @@ struct btrfs_super_block {
  */
 #define BTRFS_FEATURE_INCOMPAT_BIG_METADATA	(1ULL << 5)
 
+/*
+ * Mainline hands out incompat bits in order from here on (extended irefs,
+ * raid56, skinny metadata, no holes, ...), so lz4 stays out of their way at
+ * the top of the word.
+ */
+#define BTRFS_FEATURE_INCOMPAT_COMPRESS_LZ4	(1ULL << 63)
+
 #define BTRFS_FEATURE_COMPAT_SUPP		0ULL
 #define BTRFS_FEATURE_COMPAT_RO_SUPP		0ULL
 #define BTRFS_FEATURE_INCOMPAT_SUPP			\
@@ -496,7 +503,8 @@ struct btrfs_super_block {
 	 BTRFS_FEATURE_INCOMPAT_DEFAULT_SUBVOL |	\
 	 BTRFS_FEATURE_INCOMPAT_MIXED_GROUPS |		\
 	 BTRFS_FEATURE_INCOMPAT_BIG_METADATA |		\
-	 BTRFS_FEATURE_INCOMPAT_COMPRESS_LZO)
+	 BTRFS_FEATURE_INCOMPAT_COMPRESS_LZO |		\
+	 BTRFS_FEATURE_INCOMPAT_COMPRESS_LZ4)
 
 /*
  * A leaf is full of items. offset and size tell us where to find
@@ -652,8 +660,11 @@ enum btrfs_compression_type {
 	BTRFS_COMPRESS_NONE  = 0,
 	BTRFS_COMPRESS_ZLIB  = 1,
 	BTRFS_COMPRESS_LZO   = 2,
-	BTRFS_COMPRESS_TYPES = 2,
-	BTRFS_COMPRESS_LAST  = 3,
+	/* 3 is zstd in mainline; we only reserve the number */
+	BTRFS_COMPRESS_ZSTD  = 3,
+	BTRFS_COMPRESS_LZ4   = 4,
+	BTRFS_COMPRESS_TYPES = 4,
+	BTRFS_COMPRESS_LAST  = 5,
 };
 
 struct btrfs_inode_item {
@@ -1718,7 +1718,7 @@ __xfs_buf_delwri_submit(
 		trace_xfs_buf_delwri_split(bp, _RET_IP_);
 	}
 
-	list_sort(NULL, io_list, xfs_buf_cmp);
+	list_sort_inline(NULL, io_list, xfs_buf_cmp);
 
 	blk_start_plug(&plug);
 	list_for_each_entry_safe(bp, n, io_list, b_list) {
@@ -0,0 +1,62 @@
+/*
+ * Software multi-buffer async crypto daemon
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation; either version 2 of the License, or (at your option)
+ * any later version.
+ *
+ */
+
+#ifndef _CRYPTO_MCRYPT_H
+#define _CRYPTO_MCRYPT_H
+
+#include <linux/crypto.h>
+#include <linux/kernel.h>
+#include <linux/list.h>
+#include <linux/mutex.h>
+#include <linux/workqueue.h>
+
+/**
+ * struct mcryptd_ops - lane manager of a multi-buffer algorithm
+ * @init_mgr:	set up the per-cpu manager state, with all lanes free
+ * @submit:	start @req on a free lane.  If that was the last free lane,
+ *		run the lanes until at least one is free again.  Requests
+ *		that are finished are added to @done.  Returns true if any
+ *		lane is still in use.
+ * @flush:	run the lanes that are in use, partially filled as they
+ *		are, until at least one request is finished, and add it to
+ *		@done.  Returns true if any lane is still in use.
+ */
+struct mcryptd_ops {
+	void (*init_mgr)(void *mgr);
+	bool (*submit)(void *mgr, struct crypto_async_request *req,
+		       struct list_head *done);
+	bool (*flush)(void *mgr, struct list_head *done);
+};
+
+struct mcryptd_cpu_queue {
+	struct crypto_queue queue;
+	struct work_struct work;
+	struct delayed_work flush;
+	struct mutex lock;		/* serialises access to @mgr */
+	bool busy;			/* some lane of @mgr is in use */
+	struct mcryptd_queue *mqueue;
+	void *mgr;
+};
+
+struct mcryptd_queue {
+	struct mcryptd_cpu_queue __percpu *cpu_queue;
+	void __percpu *mgr;
+	const struct mcryptd_ops *ops;
+	unsigned long flush_delay;	/* in jiffies */
+};
+
+int mcryptd_init_queue(struct mcryptd_queue *queue,
+		       const struct mcryptd_ops *ops, size_t mgr_size,
+		       unsigned int max_cpu_qlen, unsigned long flush_delay);
+void mcryptd_fini_queue(struct mcryptd_queue *queue);
+int mcryptd_enqueue_request(struct mcryptd_queue *queue,
+			    struct crypto_async_request *request);
+
+#endif
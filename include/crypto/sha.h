@@ -87,4 +87,10 @@ struct shash_desc;
 extern int crypto_sha1_update(struct shash_desc *desc, const u8 *data,
 			      unsigned int len);
 
+extern int crypto_sha256_update(struct shash_desc *desc, const u8 *data,
+				unsigned int len);
+
+extern int crypto_sha512_update(struct shash_desc *desc, const u8 *data,
+				unsigned int len);
+
 #endif
@@ -6,6 +6,7 @@
 #include <linux/aio_abi.h>
 #include <linux/uio.h>
 #include <linux/rcupdate.h>
+#include <linux/percpu-refcount.h>
 
 #include <linux/atomic.h>
 
@@ -180,7 +181,7 @@ static inline unsigned aio_ring_avail(struct aio_ring_info *info,
 }
 
 struct kioctx {
-	atomic_t		users;
+	struct percpu_ref	users;
 	int			dead;
 	struct mm_struct	*mm;
 
@@ -203,6 +204,7 @@ struct kioctx {
 
 	struct delayed_work	wq;
 
+	struct work_struct	free_work;
 	struct rcu_head		rcu_head;
 };
 
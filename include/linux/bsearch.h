@@ -1,9 +1,44 @@
 #ifndef _LINUX_BSEARCH_H
 #define _LINUX_BSEARCH_H
 
+#include <linux/compiler.h>
 #include <linux/types.h>
 
 void *bsearch(const void *key, const void *base, size_t num, size_t size,
 	      int (*cmp)(const void *key, const void *elt));
 
+/**
+ * bsearch_inline - binary search an array of elements, inlining @cmp
+ * @key: pointer to item being searched for
+ * @base: pointer to first element to search
+ * @num: number of elements
+ * @size: size of each element
+ * @cmp: pointer to comparison function
+ *
+ * The same search as bsearch(), expanded at the call site so that a
+ * comparison function known at compile time is inlined rather than
+ * called indirectly at every step.
+ */
+static __always_inline void *bsearch_inline(const void *key, const void *base,
+		size_t num, size_t size,
+		int (*cmp)(const void *key, const void *elt))
+{
+	size_t start = 0, end = num;
+	int result;
+
+	while (start < end) {
+		size_t mid = start + (end - start) / 2;
+
+		result = cmp(key, base + mid * size);
+		if (result < 0)
+			end = mid;
+		else if (result > 0)
+			start = mid + 1;
+		else
+			return (void *)base + mid * size;
+	}
+
+	return NULL;
+}
+
 #endif /* _LINUX_BSEARCH_H */
@@ -161,6 +161,7 @@ struct kvm_vcpu {
 	int guest_fpu_loaded, guest_xcr0_loaded;
 	wait_queue_head_t wq;
 	struct pid *pid;
+	unsigned int halt_poll_ns;
 	int sigset_active;
 	sigset_t sigset;
 	struct kvm_vcpu_stat stat;
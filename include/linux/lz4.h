@@ -0,0 +1,53 @@
+#ifndef __LZ4_H__
+#define __LZ4_H__
+/*
+ *  LZ4 Public Kernel Interface
+ *
+ *  LZ4 is a byte oriented LZ77 compressor with a very simple block
+ *  format, designed for decompression speed.  The block format is
+ *  described at http://code.google.com/p/lz4/ and every block produced
+ *  here can be decoded by the reference implementation and vice versa.
+ *
+ *  lz4_compress() is a greedy single-probe compressor for speed;
+ *  lz4hc_compress() searches hash chains and emits the same block
+ *  format with a better ratio at a much higher compression cost.
+ */
+
+#include <linux/types.h>
+
+#define LZ4_HASH_LOG		13
+#define LZ4_MEM_COMPRESS	((1 << LZ4_HASH_LOG) * sizeof(u32))
+
+#define LZ4HC_HASH_LOG		15
+#define LZ4HC_MAX_DISTANCE	65535
+#define LZ4HC_MEM_COMPRESS	((1 << LZ4HC_HASH_LOG) * sizeof(u32) + \
+				 (LZ4HC_MAX_DISTANCE + 1) * sizeof(u16))
+
+/* worst case output size for incompressible input of length x */
+#define lz4_worst_compress(x)	((x) + ((x) / 255) + 16)
+
+/* This requires 'wrkmem' of size LZ4_MEM_COMPRESS */
+int lz4_compress(const unsigned char *src, size_t src_len,
+		unsigned char *dst, size_t *dst_len, void *wrkmem);
+
+/* This requires 'wrkmem' of size LZ4HC_MEM_COMPRESS */
+int lz4hc_compress(const unsigned char *src, size_t src_len,
+		unsigned char *dst, size_t *dst_len, void *wrkmem);
+
+/*
+ * Safe decompression with overrun testing.  On entry *dst_len is the
+ * size of the dst buffer, on success it is the number of bytes produced.
+ */
+int lz4_decompress_safe(const unsigned char *src, size_t src_len,
+		unsigned char *dst, size_t *dst_len);
+
+/*
+ * Return values (< 0 = Error)
+ */
+#define LZ4_E_OK			0
+#define LZ4_E_ERROR			(-1)
+#define LZ4_E_INPUT_OVERRUN		(-4)
+#define LZ4_E_OUTPUT_OVERRUN		(-5)
+#define LZ4_E_LOOKBEHIND_OVERRUN	(-6)
+
+#endif
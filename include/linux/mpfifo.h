@@ -0,0 +1,184 @@
+#ifndef _LINUX_MPFIFO_H
+#define _LINUX_MPFIFO_H
+
+/*
+ * Multi-producer fifo
+ *
+ * A bounded fifo of fixed size elements, like kfifo, which any number of
+ * producers may put elements into concurrently without a lock, and from
+ * which one consumer at a time takes them out, in batches.  This is for
+ * the many places that wrap a kfifo in a spinlock only because more
+ * than one context feeds it.
+ *
+ * Each slot carries a sequence number.  A producer claims the slot at
+ * the tail with a cmpxchg on @in, copies its element in and then
+ * publishes it by advancing the slot's sequence number; the consumer
+ * takes published slots from the head in order and hands them back to
+ * the producers of the next lap by advancing their sequence numbers
+ * again.  Producers thus only share the @in cacheline, and never wait
+ * for each other except for the cmpxchg: a producer preempted between
+ * claiming and publishing its slot only holds up the consumer, which
+ * stops at that slot until it is published.
+ *
+ * Elements put by one producer come out in the order they were put.
+ *
+ * Consumers (mpfifo_get(), mpfifo_out()) must be serialized against each
+ * other by the caller.
+ */
+
+#include <linux/cache.h>
+#include <linux/compiler.h>
+#include <linux/gfp.h>
+#include <linux/types.h>
+
+struct __mpfifo {
+	unsigned int	mask;
+	unsigned int	esize;
+	unsigned int	*seq;
+	void		*data;
+
+	/* written by producers */
+	unsigned int	in ____cacheline_aligned_in_smp;
+	/* written by the consumer */
+	unsigned int	out ____cacheline_aligned_in_smp;
+};
+
+#define __STRUCT_MPFIFO_PTR(datatype) \
+{ \
+	union { \
+		struct __mpfifo	mpfifo; \
+		datatype	*type; \
+		const datatype	*ptr_const; \
+	}; \
+}
+
+/**
+ * DECLARE_MPFIFO_PTR - macro to declare a multi-producer fifo object
+ * @fifo: name of the declared fifo
+ * @type: type of the fifo elements
+ */
+#define DECLARE_MPFIFO_PTR(fifo, type) \
+	struct __STRUCT_MPFIFO_PTR(type) fifo
+
+extern int __mpfifo_alloc(struct __mpfifo *fifo, unsigned int size,
+			  size_t esize, gfp_t gfp_mask);
+extern void __mpfifo_free(struct __mpfifo *fifo);
+extern unsigned int __mpfifo_in(struct __mpfifo *fifo, const void *buf);
+extern unsigned int __mpfifo_out(struct __mpfifo *fifo, void *buf,
+				 unsigned int n);
+
+static inline unsigned int __must_check
+__mpfifo_uint_must_check_helper(unsigned int val)
+{
+	return val;
+}
+
+/**
+ * mpfifo_alloc - dynamically allocates a new multi-producer fifo
+ * @fifo: pointer to the fifo
+ * @size: the number of elements in the fifo, at least 2
+ * @gfp_mask: get_free_pages mask, passed to kmalloc()
+ *
+ * The number of elements will be rounded down to a power of 2.
+ * The fifo will be released with mpfifo_free().
+ * Return 0 if no error, otherwise an error code.
+ */
+#define mpfifo_alloc(fifo, size, gfp_mask) \
+({ \
+	typeof((fifo) + 1) __tmp = (fifo); \
+	__mpfifo_alloc(&__tmp->mpfifo, size, sizeof(*__tmp->type), \
+		       gfp_mask); \
+})
+
+/**
+ * mpfifo_free - frees the fifo
+ * @fifo: the fifo to be freed
+ */
+#define mpfifo_free(fifo) \
+	__mpfifo_free(&(fifo)->mpfifo)
+
+/**
+ * mpfifo_size - returns the size of the fifo in elements
+ * @fifo: address of the fifo to be used
+ */
+#define mpfifo_size(fifo)	((fifo)->mpfifo.mask + 1)
+
+/**
+ * mpfifo_len - returns the number of elements in the fifo
+ * @fifo: address of the fifo to be used
+ *
+ * This counts elements which have been claimed by a producer but not
+ * yet published, and is only a snapshot while producers are running.
+ */
+#define mpfifo_len(fifo) \
+({ \
+	typeof((fifo) + 1) __tmpl = (fifo); \
+	ACCESS_ONCE(__tmpl->mpfifo.in) - ACCESS_ONCE(__tmpl->mpfifo.out); \
+})
+
+/**
+ * mpfifo_is_empty - returns true if the fifo is empty
+ * @fifo: address of the fifo to be used
+ */
+#define mpfifo_is_empty(fifo)	(mpfifo_len(fifo) == 0)
+
+/**
+ * mpfifo_put - put data into the fifo
+ * @fifo: address of the fifo to be used
+ * @val: address of the data to be added
+ *
+ * This macro copies the given value into the fifo.  It returns 0 if the
+ * fifo was full, otherwise 1.
+ *
+ * Any number of producers may call this concurrently, from any context,
+ * without locking.
+ */
+#define mpfifo_put(fifo, val) \
+({ \
+	typeof((fifo) + 1) __tmp = (fifo); \
+	typeof((val) + 1) __val = (val); \
+	if (0) { \
+		typeof(__tmp->ptr_const) __dummy __attribute__ ((unused)); \
+		__dummy = (typeof(__val))NULL; \
+	} \
+	__mpfifo_in(&__tmp->mpfifo, __val); \
+})
+
+/**
+ * mpfifo_out - get data from the fifo
+ * @fifo: address of the fifo to be used
+ * @buf: pointer to the storage buffer
+ * @n: max. number of elements to get
+ *
+ * This macro takes up to @n elements out of the fifo, stopping at the
+ * first one which has not been published yet, and returns the number
+ * of elements copied to @buf.  The slots of the whole batch are handed
+ * back to the producers at once.
+ *
+ * Calls must be serialized against each other, but not against
+ * mpfifo_put().
+ */
+#define mpfifo_out(fifo, buf, n) \
+__mpfifo_uint_must_check_helper( \
+({ \
+	typeof((fifo) + 1) __tmp = (fifo); \
+	typeof((buf) + 1) __buf = (buf); \
+	if (0) { \
+		typeof(__tmp->type) __dummy __attribute__ ((unused)); \
+		__dummy = __buf; \
+	} \
+	__mpfifo_out(&__tmp->mpfifo, __buf, n); \
+}) \
+)
+
+/**
+ * mpfifo_get - get one element from the fifo
+ * @fifo: address of the fifo to be used
+ * @val: address of the variable to store the element in
+ *
+ * Returns 0 if the fifo was empty, otherwise 1.  Same rules as for
+ * mpfifo_out().
+ */
+#define mpfifo_get(fifo, val)	mpfifo_out(fifo, val, 1)
+
+#endif /* _LINUX_MPFIFO_H */
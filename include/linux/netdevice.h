@@ -40,6 +40,7 @@
 #include <asm/byteorder.h>
 
 #include <linux/percpu.h>
+#include <linux/pcpu_stats.h>
 #include <linux/rculist.h>
 #include <linux/dmaengine.h>
 #include <linux/workqueue.h>
@@ -2605,10 +2606,25 @@ extern void		netdev_features_change(struct net_device *dev);
 /* Load a device via the kmod */
 extern void		dev_load(struct net *net, const char *name);
 extern void		dev_mcast_init(void);
+
+/*
+ * Often modified stats of software devices, kept per cpu while the
+ * others stay in dev->stats.  See <linux/pcpu_stats.h>.
+ */
+struct pcpu_tstats {
+	u64			rx_packets;
+	u64			rx_bytes;
+	u64			tx_packets;
+	u64			tx_bytes;
+	struct u64_stats_sync	syncp;
+};
+
 extern struct rtnl_link_stats64 *dev_get_stats(struct net_device *dev,
 					       struct rtnl_link_stats64 *storage);
 extern void netdev_stats_to_stats64(struct rtnl_link_stats64 *stats64,
 				    const struct net_device_stats *netdev_stats);
+extern void dev_fold_tstats(struct rtnl_link_stats64 *stats64,
+			    const struct pcpu_tstats __percpu *tstats);
 
 extern int		netdev_max_backlog;
 extern int		netdev_tstamp_prequeue;
@@ -0,0 +1,123 @@
+#ifndef _LINUX_PCPU_STATS_H
+#define _LINUX_PCPU_STATS_H
+
+/*
+ * Per-cpu statistics
+ *
+ * A statistics group is a structure of u64 counters followed by a
+ * struct u64_stats_sync named syncp, with one instance per cpu:
+ *
+ *   struct foo_stats {
+ *           u64                     packets;
+ *           u64                     bytes;
+ *           struct u64_stats_sync   syncp;
+ *   };
+ *
+ *   struct foo_stats __percpu *stats = pcpu_stats_alloc(struct foo_stats);
+ *
+ * Writers only touch the counters of their own cpu, without atomics or
+ * locks, and readers fold the counters of all cpus into one instance of
+ * the group.  On 32 bit SMP the syncp makes readers retry a cpu until
+ * they get an untorn snapshot of its counters; everywhere else it is
+ * empty and costs nothing (see <linux/u64_stats_sync.h>).
+ *
+ * A writer must not be preempted, and the counters of a group must
+ * always be written from the same context (e.g. only from softirq, or
+ * only with BH disabled), so that two updates on one cpu never nest.
+ * Counters written from different contexts go into different groups.
+ */
+
+#include <linux/bug.h>
+#include <linux/percpu.h>
+#include <linux/stddef.h>
+#include <linux/types.h>
+#include <linux/u64_stats_sync.h>
+
+/* maximum number of counters in a group */
+#define PCPU_STATS_MAX		32
+
+extern void __pcpu_stats_fold(const void __percpu *stats, u64 *sum,
+			      unsigned int nr, size_t syncp_offset);
+
+/**
+ * pcpu_stats_alloc - allocate a per-cpu statistics group
+ * @type: type of the group, or of a structure of several groups
+ *
+ * Returns a zeroed instance for every possible cpu, or NULL.  Free it
+ * with pcpu_stats_free().
+ */
+#define pcpu_stats_alloc(type)	alloc_percpu(type)
+
+/**
+ * pcpu_stats_free - free a per-cpu statistics group
+ * @stats: the group, may be NULL
+ */
+#define pcpu_stats_free(stats)	free_percpu(stats)
+
+/**
+ * pcpu_stats_update_begin - start updating this cpu's counters
+ * @stats: the per-cpu group
+ *
+ * Returns this cpu's instance of @stats; update its counters with plain
+ * arithmetic and finish with pcpu_stats_update_end().  Preemption must
+ * be disabled.
+ */
+#define pcpu_stats_update_begin(stats)					\
+({									\
+	typeof(this_cpu_ptr(stats)) __s = this_cpu_ptr(stats);		\
+	u64_stats_update_begin(&__s->syncp);				\
+	__s;								\
+})
+
+/**
+ * pcpu_stats_update_end - finish updating this cpu's counters
+ * @s: the instance returned by pcpu_stats_update_begin()
+ */
+#define pcpu_stats_update_end(s)	u64_stats_update_end(&(s)->syncp)
+
+/**
+ * pcpu_stats_add - add to a counter of this cpu
+ * @stats: the per-cpu group
+ * @field: the counter
+ * @val: the value to add
+ *
+ * Preemption must be disabled.
+ */
+#define pcpu_stats_add(stats, field, val)				\
+do {									\
+	typeof(this_cpu_ptr(stats)) __sa = pcpu_stats_update_begin(stats); \
+	__sa->field += (val);						\
+	pcpu_stats_update_end(__sa);					\
+} while (0)
+
+/**
+ * pcpu_stats_inc - increment a counter of this cpu
+ * @stats: the per-cpu group
+ * @field: the counter
+ */
+#define pcpu_stats_inc(stats, field)	pcpu_stats_add(stats, field, 1)
+
+/**
+ * pcpu_stats_fold - sum up the counters of all cpus
+ * @stats: the per-cpu group
+ * @sum: instance of the group to store the sums in
+ *
+ * No counter is ever seen half updated, but only on 32 bit SMP are the
+ * counters of one cpu read together as a snapshot, and different cpus
+ * are read at different times in any case.  The syncp of @sum is left
+ * alone.  Must not be called from hard irq context if the counters are
+ * written from softirq context.
+ */
+#define pcpu_stats_fold(stats, sum)					\
+do {									\
+	typeof(sum) __sum = (sum);					\
+	BUILD_BUG_ON(offsetof(typeof(*__sum), syncp) % sizeof(u64));	\
+	BUILD_BUG_ON(offsetof(typeof(*__sum), syncp) >			\
+		     PCPU_STATS_MAX * sizeof(u64));			\
+	(void)sizeof(__sum == this_cpu_ptr(stats));			\
+	__pcpu_stats_fold(stats, (u64 *)__sum,				\
+			  offsetof(typeof(*__sum), syncp) / sizeof(u64),	\
+			  offsetof(typeof(*__sum), syncp));		\
+} while (0)
+
+#endif /* _LINUX_PCPU_STATS_H */
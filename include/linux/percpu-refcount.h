@@ -0,0 +1,139 @@
+/*
+ * Percpu refcounts
+ *
+ * A reference count for objects that are got and put far more often than
+ * they are torn down.  While the object is live, gets and puts just bump
+ * a counter of the local cpu, without any shared cacheline or atomic
+ * operation.  When the owner starts the teardown with percpu_ref_kill(),
+ * the refcount switches to a single atomic_t: after an RCU-sched grace
+ * period all the percpu counters are folded into it, and from then on it
+ * behaves like an ordinary refcount whose last put calls the release
+ * function.
+ *
+ * The initial reference, the one returned by percpu_ref_init(), is
+ * dropped by percpu_ref_kill(), so the usual pattern is
+ *
+ *	percpu_ref_init(&obj->ref, release);	at creation
+ *	percpu_ref_get()/percpu_ref_put()	any number of times
+ *	percpu_ref_kill(&obj->ref);		instead of the owner's put
+ *
+ * percpu_ref_tryget() fails once the refcount has been killed, so it
+ * can be used to look objects up in RCU protected structures that the
+ * owner unlinks them from before killing.
+ *
+ * The release function may be called from any context, including the
+ * softirq that runs the RCU callbacks.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#ifndef _LINUX_PERCPU_REFCOUNT_H
+#define _LINUX_PERCPU_REFCOUNT_H
+
+#include <linux/atomic.h>
+#include <linux/kernel.h>
+#include <linux/percpu.h>
+#include <linux/rcupdate.h>
+
+struct percpu_ref;
+typedef void (percpu_ref_release)(struct percpu_ref *);
+
+/*
+ * Low bit of the percpu pointer, set by percpu_ref_kill(): the counters
+ * are being folded into @count and must not be touched any more.
+ */
+#define PCPU_REF_DEAD		1UL
+
+struct percpu_ref {
+	atomic_t		count;
+	unsigned __percpu	*pcpu_count;
+	percpu_ref_release	*release;
+	struct rcu_head		rcu;
+};
+
+int __must_check percpu_ref_init(struct percpu_ref *ref,
+				 percpu_ref_release *release);
+void percpu_ref_cancel_init(struct percpu_ref *ref);
+void percpu_ref_kill(struct percpu_ref *ref);
+
+static inline bool __pcpu_ref_alive(unsigned __percpu *pcpu_count)
+{
+	return !((unsigned long)pcpu_count & PCPU_REF_DEAD);
+}
+
+/**
+ * percpu_ref_get - increment a percpu refcount
+ * @ref: percpu_ref to get
+ *
+ * The caller must already hold a reference, or otherwise know that the
+ * refcount can't drop to zero under it.
+ */
+static inline void percpu_ref_get(struct percpu_ref *ref)
+{
+	unsigned __percpu *pcpu_count;
+
+	rcu_read_lock_sched();
+
+	pcpu_count = ACCESS_ONCE(ref->pcpu_count);
+
+	if (likely(__pcpu_ref_alive(pcpu_count)))
+		__this_cpu_inc(*pcpu_count);
+	else
+		atomic_inc(&ref->count);
+
+	rcu_read_unlock_sched();
+}
+
+/**
+ * percpu_ref_tryget - try to increment a percpu refcount
+ * @ref: percpu_ref to try-get
+ *
+ * Returns %true on success, %false if percpu_ref_kill() has already been
+ * called on @ref.  The caller must make sure that the memory of @ref
+ * stays around, typically with rcu_read_lock().
+ */
+static inline bool percpu_ref_tryget(struct percpu_ref *ref)
+{
+	unsigned __percpu *pcpu_count;
+	bool ret = false;
+
+	rcu_read_lock_sched();
+
+	pcpu_count = ACCESS_ONCE(ref->pcpu_count);
+
+	if (likely(__pcpu_ref_alive(pcpu_count))) {
+		__this_cpu_inc(*pcpu_count);
+		ret = true;
+	}
+
+	rcu_read_unlock_sched();
+
+	return ret;
+}
+
+/**
+ * percpu_ref_put - decrement a percpu refcount
+ * @ref: percpu_ref to put
+ *
+ * Calls the release function if this was the last reference; that can
+ * only happen after percpu_ref_kill().
+ */
+static inline void percpu_ref_put(struct percpu_ref *ref)
+{
+	unsigned __percpu *pcpu_count;
+
+	rcu_read_lock_sched();
+
+	pcpu_count = ACCESS_ONCE(ref->pcpu_count);
+
+	if (likely(__pcpu_ref_alive(pcpu_count)))
+		__this_cpu_dec(*pcpu_count);
+	else if (unlikely(atomic_dec_and_test(&ref->count)))
+		ref->release(ref);
+
+	rcu_read_unlock_sched();
+}
+
+#endif /* _LINUX_PERCPU_REFCOUNT_H */
@@ -15,6 +15,13 @@
 
 #ifdef CONFIG_SMP
 
+struct percpu_counter_node;
+
+/*
+ * On NUMA machines the per-cpu counts are first folded into a count per
+ * node, and only the node counts into @count, so that cpus only contend
+ * on @lock when a whole node's worth of updates has accumulated.
+ */
 struct percpu_counter {
 	raw_spinlock_t lock;
 	s64 count;
@@ -22,6 +29,9 @@ struct percpu_counter {
 	struct list_head list;	/* All percpu_counters are on a list */
 #endif
 	s32 __percpu *counters;
+#ifdef CONFIG_NUMA
+	struct percpu_counter_node *nodes;	/* NULL on single node */
+#endif
 };
 
 extern int percpu_counter_batch;
@@ -0,0 +1,74 @@
+#ifndef __PERCPU_IDA_H__
+#define __PERCPU_IDA_H__
+
+#include <linux/types.h>
+#include <linux/bitops.h>
+#include <linux/cache.h>
+#include <linux/init.h>
+#include <linux/spinlock_types.h>
+#include <linux/wait.h>
+#include <linux/cpumask.h>
+
+struct percpu_ida_cpu;
+
+/*
+ * Percpu tag allocator
+ *
+ * Hands out integers in [0, nr_tags) for things like block and SCSI
+ * tags, where the IDs are allocated and freed at a high rate and are
+ * usually freed on the cpu they were allocated on.  Each cpu keeps a
+ * small cache of free tags; a cpu whose cache is empty refills it in a
+ * batch from the global freelist, and failing that steals the cache of
+ * another cpu.  When no tag is left anywhere, allocations that may
+ * sleep wait until one is freed.
+ *
+ * Tags are only stolen once enough cpus cache them that half the pool
+ * could be stuck there, so an allocation can fail (or wait) while some
+ * free tags still sit in the caches of other cpus; size the pool with
+ * some slack for that.
+ */
+struct percpu_ida {
+	/*
+	 * number of tags available to be allocated, as passed to
+	 * percpu_ida_init()
+	 */
+	unsigned			nr_tags;
+
+	struct percpu_ida_cpu __percpu	*tag_cpu;
+
+	/*
+	 * Bitmap of cpus that (may) have tags on their percpu freelists:
+	 * steal_tags() uses this to decide when to steal tags, and which
+	 * cpus to try stealing from.
+	 */
+	cpumask_t			cpus_have_tags;
+
+	struct {
+		spinlock_t		lock;
+		/*
+		 * When we go to steal tags from another cpu (see
+		 * steal_tags()), we want to pick a cpu at random.
+		 * Cycling through them every time we steal is a bit
+		 * easier and more or less equivalent:
+		 */
+		unsigned		cpu_last_stolen;
+
+		/* For sleeping on allocation failure */
+		wait_queue_head_t	wait;
+
+		/*
+		 * Global freelist - it's a stack where nr_free points to
+		 * the top
+		 */
+		unsigned		nr_free;
+		unsigned		*freelist;
+	} ____cacheline_aligned_in_smp;
+};
+
+int percpu_ida_alloc(struct percpu_ida *pool, gfp_t gfp);
+void percpu_ida_free(struct percpu_ida *pool, unsigned tag);
+
+void percpu_ida_destroy(struct percpu_ida *pool);
+int percpu_ida_init(struct percpu_ida *pool, unsigned long nr_tags);
+
+#endif /* __PERCPU_IDA_H__ */
@@ -28,11 +28,12 @@
 #include <linux/rcupdate.h>
 
 /*
- * An indirect pointer (root->rnode pointing to a radix_tree_node, rather
- * than a data item) is signalled by the low bit set in the root->rnode
- * pointer.
+ * An indirect pointer (a slot or root->rnode pointing to a radix_tree_node,
+ * rather than a data item) is signalled by the low bit set in the pointer.
+ * Child nodes are tagged this way at every level of the tree, since a slot
+ * above the leaves may also hold a multi-order data item.
  *
- * In this case root->height is > 0, but the indirect pointer tests are
+ * For root->rnode, root->height is > 0, but the indirect pointer tests are
  * needed for RCU lookups (because root->height is unreliable). The only
  * time callers need worry about this is when doing a lookup_slot under
  * RCU.
@@ -56,6 +57,21 @@ static inline int radix_tree_is_indirect_ptr(void *ptr)
 	return (int)((unsigned long)ptr & RADIX_TREE_INDIRECT_PTR);
 }
 
+/*
+ * A multi-order item, inserted with radix_tree_insert_order(), covers 2^order
+ * aligned indices.  It is stored in the first of the slots it covers in the
+ * node whose slots are no bigger than itself; the following slots hold
+ * sibling entries: the offset of that first slot, shifted and tagged as an
+ * indirect pointer so that it can't be mistaken for an item or a node.
+ */
+#define RADIX_TREE_SIBLING_LIMIT	(64UL << RADIX_TREE_EXCEPTIONAL_SHIFT)
+
+static inline int radix_tree_is_sibling_entry(void *ptr)
+{
+	return radix_tree_is_indirect_ptr(ptr) &&
+		(unsigned long)ptr < RADIX_TREE_SIBLING_LIMIT;
+}
+
 /*** radix-tree API starts here ***/
 
 #define RADIX_TREE_MAX_TAGS 3
@@ -216,6 +232,8 @@ static inline void radix_tree_replace_slot(void **pslot, void *item)
 	rcu_assign_pointer(*pslot, item);
 }
 
+int radix_tree_insert_order(struct radix_tree_root *, unsigned long,
+			    unsigned int order, void *);
 int radix_tree_insert(struct radix_tree_root *, unsigned long, void *);
 void *radix_tree_lookup(struct radix_tree_root *, unsigned long);
 void **radix_tree_lookup_slot(struct radix_tree_root *, unsigned long);
@@ -264,18 +282,24 @@ static inline void radix_tree_preload_end(void)
  * @index:	index of current slot
  * @next_index:	next-to-last index for this chunk
  * @tags:	bit-mask for tag-iterating
+ * @shift:	log2 of the number of indices covered by one slot of the chunk
  *
  * This radix tree iterator works in terms of "chunks" of slots.  A chunk is a
- * subinterval of slots contained within one radix tree leaf node.  It is
+ * subinterval of slots contained within one radix tree node: a leaf node, or,
+ * when it starts with a multi-order item, the node holding that item.  It is
  * described by a pointer to its first slot and a struct radix_tree_iter
  * which holds the chunk's position in the tree and its size.  For tagged
  * iteration radix_tree_iter also holds the slots' bit-mask for one chosen
  * radix tree tag.
+ *
+ * A multi-order item is returned once, with @index set to the first index it
+ * covers, even if the iteration started in the middle of it.
  */
 struct radix_tree_iter {
 	unsigned long	index;
 	unsigned long	next_index;
 	unsigned long	tags;
+	unsigned int	shift;
 };
 
 #define RADIX_TREE_ITER_TAG_MASK	0x00FF	/* tag index in lower byte */
@@ -330,7 +354,7 @@ void **radix_tree_next_chunk(struct radix_tree_root *root,
 static __always_inline unsigned
 radix_tree_chunk_size(struct radix_tree_iter *iter)
 {
-	return iter->next_index - iter->index;
+	return (iter->next_index - iter->index) >> iter->shift;
 }
 
 /**
@@ -350,22 +374,31 @@ radix_tree_next_slot(void **slot, struct radix_tree_iter *iter, unsigned flags)
 	if (flags & RADIX_TREE_ITER_TAGGED) {
 		iter->tags >>= 1;
 		if (likely(iter->tags & 1ul)) {
-			iter->index++;
-			return slot + 1;
+			slot++;
+			iter->index += 1UL << iter->shift;
+			goto found;
 		}
 		if (!(flags & RADIX_TREE_ITER_CONTIG) && likely(iter->tags)) {
 			unsigned offset = __ffs(iter->tags);
 
 			iter->tags >>= offset;
-			iter->index += offset + 1;
-			return slot + offset + 1;
+			slot += offset + 1;
+			iter->index += (unsigned long)(offset + 1) << iter->shift;
+			goto found;
 		}
 	} else {
 		unsigned size = radix_tree_chunk_size(iter) - 1;
 
 		while (size--) {
 			slot++;
-			iter->index++;
+			iter->index += 1UL << iter->shift;
+			if (unlikely(radix_tree_is_indirect_ptr(*slot))) {
+				/* the rest of a multi-order item */
+				if (radix_tree_is_sibling_entry(*slot))
+					continue;
+				if (iter->shift)
+					goto node;
+			}
 			if (likely(*slot))
 				return slot;
 			if (flags & RADIX_TREE_ITER_CONTIG) {
@@ -376,6 +409,17 @@ radix_tree_next_slot(void **slot, struct radix_tree_iter *iter, unsigned flags)
 		}
 	}
 	return NULL;
+
+found:
+	if (likely(!iter->shift) || !radix_tree_is_indirect_ptr(*slot))
+		return slot;
+node:
+	/*
+	 * In a chunk above the leaves, a child node ends the chunk:
+	 * radix_tree_next_chunk() will descend into it.
+	 */
+	iter->next_index = iter->index;
+	return NULL;
 }
 
 /**
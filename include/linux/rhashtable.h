@@ -0,0 +1,178 @@
+/*
+ * Resizable hash table with RCU protected lookups
+ *
+ * Lookups run under rcu_read_lock() without taking any lock.  Insertions
+ * and removals take a spinlock covering the bucket; the locks are kept in
+ * a separate array, so that a table has far fewer locks than buckets.
+ * The table grows when it is more than 75% full and shrinks when it is
+ * less than 30% full.  The resize runs from a work item and moves the
+ * entries over one bucket at a time while lookups, insertions and
+ * removals go on; during that time a lookup that fails in the old table
+ * is repeated in the new one.
+ *
+ * Objects embed a struct rhash_head and a fixed length key, whose
+ * offsets in the object are given in struct rhashtable_params.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#ifndef _LINUX_RHASHTABLE_H
+#define _LINUX_RHASHTABLE_H
+
+#include <linux/atomic.h>
+#include <linux/cache.h>
+#include <linux/compiler.h>
+#include <linux/mutex.h>
+#include <linux/rcupdate.h>
+#include <linux/spinlock.h>
+#include <linux/types.h>
+#include <linux/workqueue.h>
+
+struct rhash_head {
+	struct rhash_head __rcu		*next;
+};
+
+/**
+ * struct bucket_table - Table of hash buckets
+ * @size: Number of buckets, a power of two
+ * @locks_mask: Mask to apply before accessing @locks
+ * @locks: Array of spinlocks protecting the buckets
+ * @future_tbl: Table the entries are being moved to, during a resize
+ * @buckets: The buckets
+ */
+struct bucket_table {
+	size_t				size;
+	unsigned int			locks_mask;
+	spinlock_t			*locks;
+	struct bucket_table __rcu	*future_tbl;
+	struct rhash_head __rcu		*buckets[] ____cacheline_aligned_in_smp;
+};
+
+typedef u32 (*rht_hashfn_t)(const void *data, u32 len, u32 seed);
+
+struct rhashtable;
+
+/**
+ * struct rhashtable_params - Hash table construction parameters
+ * @nelem_hint: Hint on the number of elements, sizes the initial table
+ * @key_len: Length of the key
+ * @key_offset: Offset of the key in the object
+ * @head_offset: Offset of the struct rhash_head in the object
+ * @hash_rnd: Seed to use for the hash function, random if 0
+ * @max_size: Maximum number of buckets, unlimited if 0
+ * @min_size: Minimum number of buckets, when shrinking
+ * @locks_mul: Number of bucket locks to allocate per cpu
+ * @hashfn: Function to hash the key, jhash() if NULL
+ */
+struct rhashtable_params {
+	size_t			nelem_hint;
+	size_t			key_len;
+	size_t			key_offset;
+	size_t			head_offset;
+	u32			hash_rnd;
+	size_t			max_size;
+	size_t			min_size;
+	size_t			locks_mul;
+	rht_hashfn_t		hashfn;
+};
+
+/**
+ * struct rhashtable - Hash table handle
+ * @tbl: Bucket table
+ * @nelems: Number of elements in the table
+ * @p: Configuration parameters
+ * @run_work: Deferred worker growing and shrinking the table
+ * @mutex: Serialises the resizes against each other and destruction
+ * @being_destroyed: True once rhashtable_destroy() has started
+ */
+struct rhashtable {
+	struct bucket_table __rcu	*tbl;
+	atomic_t			nelems;
+	struct rhashtable_params	p;
+	struct work_struct		run_work;
+	struct mutex			mutex;
+	bool				being_destroyed;
+};
+
+#ifdef CONFIG_PROVE_LOCKING
+int lockdep_rht_mutex_is_held(struct rhashtable *ht);
+int lockdep_rht_bucket_is_held(const struct bucket_table *tbl, u32 hash);
+#else
+static inline int lockdep_rht_mutex_is_held(struct rhashtable *ht)
+{
+	return 1;
+}
+
+static inline int lockdep_rht_bucket_is_held(const struct bucket_table *tbl,
+					     u32 hash)
+{
+	return 1;
+}
+#endif /* CONFIG_PROVE_LOCKING */
+
+int rhashtable_init(struct rhashtable *ht, struct rhashtable_params *params);
+void rhashtable_destroy(struct rhashtable *ht);
+
+void rhashtable_insert(struct rhashtable *ht, struct rhash_head *obj);
+bool rhashtable_remove(struct rhashtable *ht, struct rhash_head *obj);
+void *rhashtable_lookup(struct rhashtable *ht, const void *key);
+
+static inline size_t rhashtable_nelems(struct rhashtable *ht)
+{
+	return atomic_read(&ht->nelems);
+}
+
+#define rht_dereference(p, ht) \
+	rcu_dereference_protected(p, lockdep_rht_mutex_is_held(ht))
+
+#define rht_dereference_rcu(p, ht) \
+	rcu_dereference_check(p, lockdep_rht_mutex_is_held(ht))
+
+#define rht_dereference_bucket(p, tbl, hash) \
+	rcu_dereference_protected(p, lockdep_rht_bucket_is_held(tbl, hash))
+
+#define rht_entry(tpos, pos, member) \
+	({ tpos = container_of(pos, typeof(*tpos), member); 1; })
+
+/**
+ * rht_for_each - iterate over a hash chain with the bucket lock held
+ * @pos:	&struct rhash_head to use as a loop cursor.
+ * @tbl:	the &struct bucket_table
+ * @hash:	the hash value / bucket index
+ */
+#define rht_for_each(pos, tbl, hash) \
+	for (pos = rht_dereference_bucket((tbl)->buckets[hash], tbl, hash); \
+	     pos; \
+	     pos = rht_dereference_bucket((pos)->next, tbl, hash))
+
+/**
+ * rht_for_each_rcu - iterate over an RCU protected hash chain
+ * @pos:	&struct rhash_head to use as a loop cursor.
+ * @tbl:	the &struct bucket_table
+ * @hash:	the hash value / bucket index
+ *
+ * Must be called under rcu_read_lock().  During a resize the walk may
+ * continue into a chain of the new table; the caller has to compare
+ * keys anyway.
+ */
+#define rht_for_each_rcu(pos, tbl, hash) \
+	for (pos = rcu_dereference((tbl)->buckets[hash]); \
+	     pos; \
+	     pos = rcu_dereference((pos)->next))
+
+/**
+ * rht_for_each_entry_rcu - iterate over an RCU protected chain of objects
+ * @tpos:	the type * to use as a loop cursor.
+ * @pos:	the &struct rhash_head to use as a loop cursor.
+ * @tbl:	the &struct bucket_table
+ * @hash:	the hash value / bucket index
+ * @member:	name of the &struct rhash_head within the hashable struct.
+ */
+#define rht_for_each_entry_rcu(tpos, pos, tbl, hash, member) \
+	for (pos = rcu_dereference((tbl)->buckets[hash]); \
+	     pos && rht_entry(tpos, pos, member); \
+	     pos = rcu_dereference((pos)->next))
+
+#endif /* _LINUX_RHASHTABLE_H */
@@ -11,6 +11,7 @@
 #include <linux/bug.h>
 #include <linux/workqueue.h>
 #include <linux/kobject.h>
+#include <linux/llist.h>
 
 #include <linux/kmemleak.h>
 
@@ -41,6 +42,9 @@ enum stat_item {
 	CPU_PARTIAL_FREE,	/* Refill cpu partial on free */
 	CPU_PARTIAL_NODE,	/* Refill cpu partial from node partial */
 	CPU_PARTIAL_DRAIN,	/* Drain cpu partial to node partial */
+	FREE_REMOTE,		/* Freeing deferred to the cpu remote list */
+	FREE_REMOTE_FLUSH,	/* Cpu remote list returned to its slabs */
+	FREE_REMOTE_SLAB,	/* Slab given back objects by a remote flush */
 	NR_SLUB_STAT_ITEMS };
 
 struct kmem_cache_cpu {
@@ -48,6 +52,8 @@ struct kmem_cache_cpu {
 	unsigned long tid;	/* Globally unique transaction id */
 	struct page *page;	/* The slab from which we are allocating */
 	struct page *partial;	/* Partially allocated frozen slabs */
+	struct llist_head remote_free;	/* Objects freed to other slabs */
+	unsigned int remote_count;	/* Objects added since the last flush */
 #ifdef CONFIG_SLUB_STATS
 	unsigned stat[NR_SLUB_STAT_ITEMS];
 #endif
@@ -85,6 +91,7 @@ struct kmem_cache {
 	int object_size;	/* The size of an object without meta data */
 	int offset;		/* Free pointer offset. */
 	int cpu_partial;	/* Number of per cpu partial objects to keep around */
+	int remote_batch;	/* Number of remote frees to collect per cpu */
 	struct kmem_cache_order_objects oo;
 
 	/* Allocation and freeing of slabs */
@@ -1,10 +1,86 @@
 #ifndef _LINUX_SORT_H
 #define _LINUX_SORT_H
 
+#include <linux/compiler.h>
 #include <linux/types.h>
 
 void sort(void *base, size_t num, size_t size,
 	  int (*cmp)(const void *, const void *),
 	  void (*swap)(void *, void *, int));
 
+static __always_inline void __sort_swap(void *a, void *b, int size)
+{
+	if (size == 4) {
+		u32 t = *(u32 *)a;
+		*(u32 *)a = *(u32 *)b;
+		*(u32 *)b = t;
+	} else {
+		char t;
+
+		do {
+			t = *(char *)a;
+			*(char *)a++ = *(char *)b;
+			*(char *)b++ = t;
+		} while (--size > 0);
+	}
+}
+
+/**
+ * sort_inline - sort an array of elements, inlining the callbacks
+ * @base: pointer to data to sort
+ * @num: number of elements
+ * @size: size of each element
+ * @cmp_func: pointer to comparison function
+ * @swap_func: pointer to swap function or NULL
+ *
+ * The same heapsort as sort(), expanded at the call site: when
+ * @cmp_func, @swap_func and @size are compile-time constants the
+ * compiler inlines the comparisons and swaps instead of making an
+ * indirect call for each of them.  Every user gets its own copy of the
+ * sort loop, so keep this for the sorts that are hot.
+ */
+static __always_inline void sort_inline(void *base, size_t num, size_t size,
+		int (*cmp_func)(const void *, const void *),
+		void (*swap_func)(void *, void *, int size))
+{
+	/* pre-scale counters for performance */
+	int i = (num/2 - 1) * size, n = num * size, c, r;
+
+	/* heapify */
+	for ( ; i >= 0; i -= size) {
+		for (r = i; r * 2 + size < n; r  = c) {
+			c = r * 2 + size;
+			if (c < n - size &&
+					cmp_func(base + c, base + c + size) < 0)
+				c += size;
+			if (cmp_func(base + r, base + c) >= 0)
+				break;
+			if (swap_func)
+				swap_func(base + r, base + c, size);
+			else
+				__sort_swap(base + r, base + c, size);
+		}
+	}
+
+	/* sort */
+	for (i = n - size; i > 0; i -= size) {
+		if (swap_func)
+			swap_func(base, base + i, size);
+		else
+			__sort_swap(base, base + i, size);
+		for (r = 0; r * 2 + size < i; r = c) {
+			c = r * 2 + size;
+			if (c < i - size &&
+					cmp_func(base + c, base + c + size) < 0)
+				c += size;
+			if (cmp_func(base + r, base + c) >= 0)
+				break;
+			if (swap_func)
+				swap_func(base + r, base + c, size);
+			else
+				__sort_swap(base + r, base + c, size);
+		}
+	}
+}
+
 #endif
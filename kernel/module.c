@@ -373,7 +373,8 @@ static bool find_symbol_in_section(const struct symsearch *syms,
 	struct find_symbol_arg *fsa = data;
 	struct kernel_symbol *sym;
 
-	sym = bsearch(fsa->name, syms->start, syms->stop - syms->start,
+	sym = bsearch_inline(fsa->name, syms->start,
+			syms->stop - syms->start,
 			sizeof(struct kernel_symbol), cmp_name);
 
 	if (sym != NULL && check_symbol(syms, owner, sym - syms->start, data))
@@ -2173,7 +2174,7 @@ static const struct kernel_symbol *lookup_symbol(const char *name,
 	const struct kernel_symbol *start,
 	const struct kernel_symbol *stop)
 {
-	return bsearch(name, start, stop - start,
+	return bsearch_inline(name, start, stop - start,
 			sizeof(struct kernel_symbol), cmp_name);
 }
 
@@ -0,0 +1,163 @@
+/*
+ * LZ4 decompressor for the Linux kernel.
+ *
+ * Handles the legacy LZ4 frame written by "lz4c -l": a four byte magic
+ * number followed by blocks, each a four byte little endian compressed
+ * size and an LZ4 block that expands to at most LZ4_BLOCK_SIZE bytes.
+ * Only the last block may expand to less.  The magic may reappear
+ * between blocks when several frames are concatenated.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#ifdef STATIC
+#include "lz4/lz4_decompress.c"
+#else
+#include <linux/decompress/unlz4.h>
+#endif
+
+#include <linux/types.h>
+#include <linux/lz4.h>
+#include <linux/decompress/mm.h>
+
+#include <linux/compiler.h>
+#include <asm/unaligned.h>
+
+#define LZ4_LEGACY_MAGIC	0x184C2102
+#define LZ4_BLOCK_SIZE		(8 << 20)
+
+STATIC inline int INIT unlz4(u8 *input, int in_len,
+				int (*fill) (void *, unsigned int),
+				int (*flush) (void *, unsigned int),
+				u8 *output, int *posp,
+				void (*error) (char *x))
+{
+	const size_t in_size = lz4_worst_compress(LZ4_BLOCK_SIZE);
+	u32 chunksize;
+	size_t dst_len;
+	u8 *in_buf, *out_buf;
+	int skip, ret = -1;
+
+	if (output) {
+		out_buf = output;
+	} else if (!flush) {
+		error("NULL output pointer and no flush function provided");
+		goto exit;
+	} else {
+		out_buf = large_malloc(LZ4_BLOCK_SIZE);
+		if (!out_buf) {
+			error("Could not allocate output buffer");
+			goto exit;
+		}
+	}
+
+	if (input && fill) {
+		error("Both input pointer and fill function provided, don't know what to do");
+		goto exit_1;
+	} else if (input) {
+		in_buf = input;
+	} else if (!fill) {
+		error("NULL input pointer and missing fill function");
+		goto exit_1;
+	} else {
+		in_buf = large_malloc(in_size);
+		if (!in_buf) {
+			error("Could not allocate input buffer");
+			goto exit_1;
+		}
+		in_len = 0;
+	}
+
+	if (posp)
+		*posp = 0;
+
+	if (fill) {
+		skip = fill(in_buf, 4);
+		if (skip > 0)
+			in_len = skip;
+	}
+	if (in_len < 4 || get_unaligned_le32(in_buf) != LZ4_LEGACY_MAGIC) {
+		error("invalid header");
+		goto exit_2;
+	}
+	if (!fill)
+		in_buf += 4;
+	in_len -= 4;
+	if (posp)
+		*posp = 4;
+
+	for (;;) {
+		/* read compressed block size */
+		if (fill) {
+			skip = fill(in_buf, 4);
+			in_len = skip > 0 ? skip : 0;
+		}
+		/*
+		 * The frame simply ends.  With an in-memory image, kbuild
+		 * appends the four byte decompressed size, so anything too
+		 * short to hold another block is the end as well.
+		 */
+		if (in_len < 4 || (!fill && in_len == 4))
+			break;
+		chunksize = get_unaligned_le32(in_buf);
+
+		/* a concatenated frame starts */
+		if (chunksize == LZ4_LEGACY_MAGIC) {
+			if (!fill)
+				in_buf += 4;
+			in_len -= 4;
+			if (posp)
+				*posp += 4;
+			continue;
+		}
+
+		/* something else follows the frame, leave it to the caller */
+		if (chunksize == 0 || chunksize > in_size)
+			break;
+
+		if (!fill)
+			in_buf += 4;
+		in_len -= 4;
+
+		if (fill) {
+			skip = fill(in_buf, chunksize);
+			in_len = skip > 0 ? skip : 0;
+		}
+		if (in_len < chunksize) {
+			error("file corrupted");
+			goto exit_2;
+		}
+
+		dst_len = LZ4_BLOCK_SIZE;
+		if (lz4_decompress_safe(in_buf, chunksize, out_buf,
+					&dst_len) != LZ4_E_OK) {
+			error("Decoding failed");
+			goto exit_2;
+		}
+
+		if (flush && flush(out_buf, dst_len) != dst_len)
+			goto exit_2;
+		if (output)
+			out_buf += dst_len;
+		if (posp)
+			*posp += chunksize + 4;
+
+		if (!fill)
+			in_buf += chunksize;
+		in_len -= chunksize;
+	}
+
+	ret = 0;
+exit_2:
+	if (!input)
+		large_free(in_buf);
+exit_1:
+	if (!output)
+		large_free(out_buf);
+exit:
+	return ret;
+}
+
+#define decompress unlz4
@@ -36,8 +36,8 @@ static int cmp_ex(const void *a, const void *b)
 void sort_extable(struct exception_table_entry *start,
 		  struct exception_table_entry *finish)
 {
-	sort(start, finish - start, sizeof(struct exception_table_entry),
-	     cmp_ex, NULL);
+	sort_inline(start, finish - start, sizeof(struct exception_table_entry),
+		    cmp_ex, NULL);
 }
 
 #ifdef CONFIG_MODULES
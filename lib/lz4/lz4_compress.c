@@ -0,0 +1,127 @@
+/*
+ *  LZ4 fast compressor
+ *
+ *  A greedy single-probe compressor producing the LZ4 block format:
+ *  each position is hashed on its first four bytes and checked against
+ *  the last position seen with the same hash.  The probe step grows
+ *  while no match is found, so incompressible data is skipped quickly.
+ */
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/string.h>
+#include <linux/lz4.h>
+#include <asm/unaligned.h>
+#include "lz4defs.h"
+
+/* the probe step grows by one every 1 << SKIP_STRENGTH failed probes */
+#define SKIP_STRENGTH	6
+
+static int lz4_hash_log(size_t src_len)
+{
+	int log = fls(src_len) - 1;
+
+	/* small inputs do not need, nor want to clear, the whole table */
+	return clamp(log, 8, LZ4_HASH_LOG);
+}
+
+int lz4_compress(const unsigned char *src, size_t src_len,
+		unsigned char *dst, size_t *dst_len, void *wrkmem)
+{
+	u32 *table = wrkmem;
+	const u8 *ip = src, *anchor = src, *ref;
+	const u8 * const iend = src + src_len;
+	const u8 * const mflimit = iend - MFLIMIT;
+	const u8 * const matchlimit = iend - LASTLITERALS;
+	u8 *op = dst, *token;
+	u8 * const oend = dst + *dst_len;
+	int hash_log;
+	u32 h, forward_h;
+
+	if (src_len < MINLENGTH)
+		goto last_literals;
+
+	hash_log = lz4_hash_log(src_len);
+	memset(table, 0, sizeof(u32) << hash_log);
+
+	/* first byte */
+	table[lz4_hash(LZ4_READ32(ip), hash_log)] = 0;
+	ip++;
+	forward_h = lz4_hash(LZ4_READ32(ip), hash_log);
+
+	for (;;) {
+		const u8 *forward_ip = ip;
+		unsigned int attempts = 1U << SKIP_STRENGTH;
+		size_t step;
+
+		/* find a match */
+		do {
+			ip = forward_ip;
+			h = forward_h;
+			step = attempts++ >> SKIP_STRENGTH;
+			forward_ip = ip + step;
+
+			if (unlikely(forward_ip > mflimit))
+				goto last_literals;
+
+			forward_h = lz4_hash(LZ4_READ32(forward_ip), hash_log);
+			ref = src + table[h];
+			table[h] = ip - src;
+		} while (ref + MAX_DISTANCE < ip ||
+			 LZ4_READ32(ref) != LZ4_READ32(ip));
+
+		/* extend backwards over bytes we skipped as literals */
+		while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+			ip--;
+			ref--;
+		}
+
+		op = lz4_put_literals(op, oend, &token, anchor, ip - anchor);
+		if (!op)
+			return LZ4_E_OUTPUT_OVERRUN;
+
+		for (;;) {
+			size_t len = MINMATCH +
+				lz4_count(ip + MINMATCH, ref + MINMATCH,
+					  matchlimit);
+
+			op = lz4_put_match(op, oend, token, ip - ref, len);
+			if (!op)
+				return LZ4_E_OUTPUT_OVERRUN;
+
+			ip += len;
+			anchor = ip;
+			if (ip > mflimit)
+				goto last_literals;
+
+			/* fill the table for the skipped position */
+			table[lz4_hash(LZ4_READ32(ip - 2), hash_log)] =
+				ip - 2 - src;
+
+			/* a match right here saves a zero length literal run */
+			h = lz4_hash(LZ4_READ32(ip), hash_log);
+			ref = src + table[h];
+			table[h] = ip - src;
+			if (ref + MAX_DISTANCE < ip ||
+			    LZ4_READ32(ref) != LZ4_READ32(ip))
+				break;
+
+			token = op++;
+			*token = 0;
+		}
+
+		forward_h = lz4_hash(LZ4_READ32(++ip), hash_log);
+	}
+
+last_literals:
+	op = lz4_put_last_literals(op, oend, anchor, iend - anchor);
+	if (!op)
+		return LZ4_E_OUTPUT_OVERRUN;
+
+	*dst_len = op - dst;
+	return LZ4_E_OK;
+}
+EXPORT_SYMBOL_GPL(lz4_compress);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("LZ4 Compressor");
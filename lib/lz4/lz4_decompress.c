@@ -0,0 +1,143 @@
+/*
+ *  LZ4 Decompressor
+ *
+ *  Every length read from the input is checked against both buffers, so
+ *  corrupted or malicious input can never read or write out of bounds.
+ *  Literals and matches are copied eight bytes at a time whenever the
+ *  buffers have room for the overshoot, and bytewise near their ends.
+ */
+
+#ifndef STATIC
+#include <linux/module.h>
+#include <linux/kernel.h>
+#endif
+
+#include <linux/compiler.h>
+#include <asm/unaligned.h>
+#include <linux/lz4.h>
+#include "lz4defs.h"
+
+#define HAVE_IP(x, ip_end, ip) ((size_t)(ip_end - ip) < (x))
+#define HAVE_OP(x, op_end, op) ((size_t)(op_end - op) < (x))
+
+/* read a nibble length continued by 255-valued extension bytes */
+static inline int lz4_read_length(const u8 **ipp, const u8 *ip_end,
+				  size_t *len)
+{
+	const u8 *ip = *ipp;
+	unsigned int s;
+
+	do {
+		if (unlikely(ip >= ip_end))
+			return -1;
+		s = *ip++;
+		*len += s;
+	} while (s == 255);
+
+	*ipp = ip;
+	return 0;
+}
+
+int lz4_decompress_safe(const unsigned char *in, size_t in_len,
+			unsigned char *out, size_t *out_len)
+{
+	const u8 * const ip_end = in + in_len;
+	u8 * const op_end = out + *out_len;
+	const u8 *ip = in, *m_pos;
+	u8 *op = out, *cpy;
+	unsigned int token;
+	size_t length, offset;
+
+	*out_len = 0;
+
+	for (;;) {
+		if (unlikely(ip >= ip_end))
+			goto input_overrun;
+		token = *ip++;
+
+		/* literals */
+		length = token >> ML_BITS;
+		if (length == RUN_MASK &&
+		    unlikely(lz4_read_length(&ip, ip_end, &length)))
+			goto input_overrun;
+
+		if (HAVE_IP(length, ip_end, ip))
+			goto input_overrun;
+		if (HAVE_OP(length, op_end, op))
+			goto output_overrun;
+
+		cpy = op + length;
+		if (likely(!HAVE_IP(length + COPYLENGTH, ip_end, ip) &&
+			   !HAVE_OP(length + COPYLENGTH, op_end, op))) {
+			do {
+				LZ4_COPY8(op, ip);
+				op += 8;
+				ip += 8;
+			} while (op < cpy);
+			ip -= op - cpy;
+			op = cpy;
+		} else {
+			while (op < cpy)
+				*op++ = *ip++;
+		}
+
+		/* the block ends with a literal-only sequence */
+		if (ip == ip_end)
+			break;
+
+		/* match */
+		if (HAVE_IP(2, ip_end, ip))
+			goto input_overrun;
+		offset = get_unaligned_le16(ip);
+		ip += 2;
+		m_pos = op - offset;
+		if (unlikely(offset == 0 || offset > (size_t)(op - out)))
+			goto lookbehind_overrun;
+
+		length = token & ML_MASK;
+		if (length == ML_MASK &&
+		    unlikely(lz4_read_length(&ip, ip_end, &length)))
+			goto input_overrun;
+		length += MINMATCH;
+
+		if (HAVE_OP(length, op_end, op))
+			goto output_overrun;
+
+		cpy = op + length;
+		if (likely(offset >= 8 &&
+			   !HAVE_OP(length + COPYLENGTH, op_end, op))) {
+			do {
+				LZ4_COPY8(op, m_pos);
+				op += 8;
+				m_pos += 8;
+			} while (op < cpy);
+			op = cpy;
+		} else {
+			/* overlapping copy repeats the last offset bytes */
+			while (op < cpy)
+				*op++ = *m_pos++;
+		}
+	}
+
+	*out_len = op - out;
+	return LZ4_E_OK;
+
+input_overrun:
+	*out_len = op - out;
+	return LZ4_E_INPUT_OVERRUN;
+
+output_overrun:
+	*out_len = op - out;
+	return LZ4_E_OUTPUT_OVERRUN;
+
+lookbehind_overrun:
+	*out_len = op - out;
+	return LZ4_E_LOOKBEHIND_OVERRUN;
+}
+#ifndef STATIC
+EXPORT_SYMBOL_GPL(lz4_decompress_safe);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("LZ4 Decompressor");
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ *  lz4defs.h -- LZ4 block format constants and common helpers
+ *
+ *  The block format is a sequence of
+ *
+ *	token | [literal length bytes] | literals | offset | [match length bytes]
+ *
+ *  where the token holds the literal length in its high nibble and the
+ *  match length minus MINMATCH in its low nibble, a nibble of 15 being
+ *  continued by bytes that are added until one is not 255.  The offset
+ *  is a 16 bit little endian distance back into the output.  The last
+ *  sequence carries literals only and ends the block.
+ */
+
+#define MINMATCH	4
+#define COPYLENGTH	8
+#define LASTLITERALS	5
+#define MFLIMIT		(COPYLENGTH + MINMATCH)
+#define MINLENGTH	(MFLIMIT + 1)
+
+#define MAX_DISTANCE	65535
+
+#define ML_BITS		4
+#define ML_MASK		((1U << ML_BITS) - 1)
+#define RUN_BITS	(8 - ML_BITS)
+#define RUN_MASK	((1U << RUN_BITS) - 1)
+
+#define LZ4_READ32(p)	get_unaligned((const u32 *)(p))
+#define LZ4_COPY8(d, s)	\
+		put_unaligned(get_unaligned((const u64 *)(s)), (u64 *)(d))
+
+static inline u32 lz4_hash(u32 seq, int hash_log)
+{
+	return (seq * 2654435761U) >> (32 - hash_log);
+}
+
+/* length of the common run at p and ref, stopping before limit */
+static inline size_t lz4_count(const u8 *p, const u8 *ref, const u8 *limit)
+{
+	const u8 *start = p;
+
+	while (p + sizeof(u32) <= limit && LZ4_READ32(p) == LZ4_READ32(ref)) {
+		p += sizeof(u32);
+		ref += sizeof(u32);
+	}
+	while (p < limit && *p == *ref) {
+		p++;
+		ref++;
+	}
+
+	return p - start;
+}
+
+/*
+ * Emit a literal run and the token for the match that follows it.
+ * Returns NULL if the run and the worst case match encoding would not
+ * fit before oend.
+ */
+static inline u8 *lz4_put_literals(u8 *op, const u8 *oend, u8 **token,
+				   const u8 *anchor, size_t lit_len)
+{
+	size_t len;
+
+	if (op + 1 + lit_len + lit_len / 255 + 1 + 2 + LASTLITERALS > oend)
+		return NULL;
+
+	*token = op++;
+	if (lit_len >= RUN_MASK) {
+		**token = RUN_MASK << ML_BITS;
+		for (len = lit_len - RUN_MASK; len >= 255; len -= 255)
+			*op++ = 255;
+		*op++ = len;
+	} else
+		**token = lit_len << ML_BITS;
+
+	memcpy(op, anchor, lit_len);
+	return op + lit_len;
+}
+
+/*
+ * Emit the offset and match length of a sequence whose token is already
+ * in place.  Returns NULL on output overrun.
+ */
+static inline u8 *lz4_put_match(u8 *op, const u8 *oend, u8 *token,
+				size_t offset, size_t match_len)
+{
+	size_t len = match_len - MINMATCH;
+
+	if (op + 2 + len / 255 + 1 + LASTLITERALS > oend)
+		return NULL;
+
+	put_unaligned_le16(offset, op);
+	op += 2;
+
+	if (len >= ML_MASK) {
+		*token += ML_MASK;
+		for (len -= ML_MASK; len >= 255; len -= 255)
+			*op++ = 255;
+		*op++ = len;
+	} else
+		*token += len;
+
+	return op;
+}
+
+/* Emit the final literal-only sequence.  Returns NULL on output overrun. */
+static inline u8 *lz4_put_last_literals(u8 *op, const u8 *oend,
+					const u8 *anchor, size_t lit_len)
+{
+	size_t len;
+
+	if (op + 1 + lit_len + lit_len / 255 + 1 > oend)
+		return NULL;
+
+	if (lit_len >= RUN_MASK) {
+		*op++ = RUN_MASK << ML_BITS;
+		for (len = lit_len - RUN_MASK; len >= 255; len -= 255)
+			*op++ = 255;
+		*op++ = len;
+	} else
+		*op++ = lit_len << ML_BITS;
+
+	memcpy(op, anchor, lit_len);
+	return op + lit_len;
+}
@@ -0,0 +1,148 @@
+/*
+ *  LZ4 HC (high compression) compressor
+ *
+ *  Produces the same block format as lz4_compress() but finds matches
+ *  by walking a hash chain of every earlier position inside the 64KB
+ *  window, and defers a match by one byte when the next position holds
+ *  a longer one.  Decompression speed is unaffected.
+ */
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/string.h>
+#include <linux/lz4.h>
+#include <asm/unaligned.h>
+#include "lz4defs.h"
+
+/* chain links searched per position before settling for the best so far */
+#define LZ4HC_MAX_ATTEMPTS	256
+
+struct lz4hc_ctx {
+	u32 *table;		/* last position for each hash */
+	u16 *chain;		/* distance to the previous position, by pos */
+	const u8 *base;
+	int hash_log;
+	u32 next;		/* first position not yet inserted */
+};
+
+static void lz4hc_insert(struct lz4hc_ctx *ctx, const u8 *ip)
+{
+	u32 target = ip - ctx->base;
+
+	while (ctx->next < target) {
+		u32 pos = ctx->next++;
+		u32 h = lz4_hash(LZ4_READ32(ctx->base + pos), ctx->hash_log);
+		u32 delta = pos - ctx->table[h];
+
+		ctx->chain[pos & LZ4HC_MAX_DISTANCE] =
+			min_t(u32, delta, LZ4HC_MAX_DISTANCE);
+		ctx->table[h] = pos;
+	}
+}
+
+/* longest match for ip, or 0 if there is none of at least MINMATCH */
+static size_t lz4hc_find_match(struct lz4hc_ctx *ctx, const u8 *ip,
+			       const u8 *limit, const u8 **match)
+{
+	const u8 *base = ctx->base;
+	u32 pos = ip - base;
+	u32 ref, delta;
+	size_t len, best = 0;
+	int attempts = LZ4HC_MAX_ATTEMPTS;
+
+	lz4hc_insert(ctx, ip);
+
+	ref = ctx->table[lz4_hash(LZ4_READ32(ip), ctx->hash_log)];
+	while (ref < pos && pos - ref <= LZ4HC_MAX_DISTANCE && attempts--) {
+		const u8 *r = base + ref;
+
+		/* only a candidate that beats best can matter */
+		if (r[best] == ip[best] && LZ4_READ32(r) == LZ4_READ32(ip)) {
+			len = MINMATCH + lz4_count(ip + MINMATCH,
+						   r + MINMATCH, limit);
+			if (len > best) {
+				best = len;
+				*match = r;
+			}
+		}
+
+		delta = ctx->chain[ref & LZ4HC_MAX_DISTANCE];
+		if (delta == 0 || delta > ref)
+			break;
+		ref -= delta;
+	}
+
+	return best;
+}
+
+static int lz4hc_hash_log(size_t src_len)
+{
+	int log = fls(src_len) - 1;
+
+	return clamp(log, 8, LZ4HC_HASH_LOG);
+}
+
+int lz4hc_compress(const unsigned char *src, size_t src_len,
+		unsigned char *dst, size_t *dst_len, void *wrkmem)
+{
+	struct lz4hc_ctx ctx;
+	const u8 *ip = src, *anchor = src, *ref = NULL, *ref2 = NULL;
+	const u8 * const iend = src + src_len;
+	const u8 * const mflimit = iend - MFLIMIT;
+	const u8 * const matchlimit = iend - LASTLITERALS;
+	u8 *op = dst, *token;
+	u8 * const oend = dst + *dst_len;
+	size_t len, len2;
+
+	if (src_len < MINLENGTH)
+		goto last_literals;
+
+	ctx.hash_log = lz4hc_hash_log(src_len);
+	ctx.table = wrkmem;
+	ctx.chain = (u16 *)(ctx.table + (1 << LZ4HC_HASH_LOG));
+	ctx.base = src;
+	ctx.next = 0;
+	/* nothing is inserted at position 0 yet, so mark every slot empty */
+	memset(ctx.table, 0xff, sizeof(u32) << ctx.hash_log);
+
+	ip++;
+	while (ip <= mflimit) {
+		len = lz4hc_find_match(&ctx, ip, matchlimit, &ref);
+		if (!len) {
+			ip++;
+			continue;
+		}
+
+		/* lazy evaluation: prefer a longer match one byte later */
+		while (ip + 1 <= mflimit) {
+			len2 = lz4hc_find_match(&ctx, ip + 1, matchlimit, &ref2);
+			if (len2 <= len)
+				break;
+			ip++;
+			len = len2;
+			ref = ref2;
+		}
+
+		op = lz4_put_literals(op, oend, &token, anchor, ip - anchor);
+		if (!op)
+			return LZ4_E_OUTPUT_OVERRUN;
+		op = lz4_put_match(op, oend, token, ip - ref, len);
+		if (!op)
+			return LZ4_E_OUTPUT_OVERRUN;
+
+		ip += len;
+		anchor = ip;
+	}
+
+last_literals:
+	op = lz4_put_last_literals(op, oend, anchor, iend - anchor);
+	if (!op)
+		return LZ4_E_OUTPUT_OVERRUN;
+
+	*dst_len = op - dst;
+	return LZ4_E_OK;
+}
+EXPORT_SYMBOL_GPL(lz4hc_compress);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("LZ4HC Compressor");
@@ -0,0 +1,130 @@
+/*
+ * Multi-producer fifo
+ *
+ * Slot i of lap l (position p = l * size + i) is free for the producer
+ * of position p while seq[i] == p, holds a published element while
+ * seq[i] == p + 1, and becomes free for position p + size once the
+ * consumer has set seq[i] to p + size.  @in is the next position to be
+ * claimed by a producer, @out the next one to be consumed.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/atomic.h>
+#include <linux/export.h>
+#include <linux/kernel.h>
+#include <linux/log2.h>
+#include <linux/mpfifo.h>
+#include <linux/slab.h>
+#include <linux/string.h>
+
+int __mpfifo_alloc(struct __mpfifo *fifo, unsigned int size,
+		   size_t esize, gfp_t gfp_mask)
+{
+	unsigned int i;
+
+	/* the sequence numbers wrap like the indices, see kfifo */
+	if (!is_power_of_2(size))
+		size = rounddown_pow_of_two(size);
+
+	memset(fifo, 0, sizeof(*fifo));
+	fifo->esize = esize;
+
+	if (size < 2)
+		return -EINVAL;
+
+	fifo->seq = kmalloc(size * sizeof(*fifo->seq), gfp_mask);
+	fifo->data = kmalloc(size * esize, gfp_mask);
+	if (!fifo->seq || !fifo->data) {
+		kfree(fifo->seq);
+		kfree(fifo->data);
+		fifo->seq = NULL;
+		fifo->data = NULL;
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < size; i++)
+		fifo->seq[i] = i;
+	fifo->mask = size - 1;
+
+	return 0;
+}
+EXPORT_SYMBOL(__mpfifo_alloc);
+
+void __mpfifo_free(struct __mpfifo *fifo)
+{
+	kfree(fifo->seq);
+	kfree(fifo->data);
+	memset(fifo, 0, sizeof(*fifo));
+}
+EXPORT_SYMBOL(__mpfifo_free);
+
+unsigned int __mpfifo_in(struct __mpfifo *fifo, const void *buf)
+{
+	unsigned int pos, old, slot;
+	int diff;
+
+	pos = ACCESS_ONCE(fifo->in);
+	for (;;) {
+		slot = pos & fifo->mask;
+		diff = (int)(ACCESS_ONCE(fifo->seq[slot]) - pos);
+
+		if (diff == 0) {
+			/* slot is free for this lap, try to claim it */
+			old = cmpxchg(&fifo->in, pos, pos + 1);
+			if (old == pos)
+				break;
+			pos = old;
+		} else if (diff < 0) {
+			/* the consumer hasn't released it from the last lap */
+			return 0;
+		} else {
+			/* another producer claimed it, try the next one */
+			pos = ACCESS_ONCE(fifo->in);
+		}
+	}
+
+	/*
+	 * The cmpxchg orders the copy after the sequence number read that
+	 * told us the consumer is done with the slot.
+	 */
+	memcpy(fifo->data + slot * fifo->esize, buf, fifo->esize);
+	smp_wmb();
+	fifo->seq[slot] = pos + 1;
+
+	return 1;
+}
+EXPORT_SYMBOL(__mpfifo_in);
+
+unsigned int __mpfifo_out(struct __mpfifo *fifo, void *buf, unsigned int n)
+{
+	unsigned int out = fifo->out;
+	unsigned int size = fifo->mask + 1;
+	unsigned int i, slot;
+
+	for (i = 0; i < n; i++) {
+		slot = (out + i) & fifo->mask;
+		if (ACCESS_ONCE(fifo->seq[slot]) != out + i + 1)
+			break;
+		/* read the element after seeing it published */
+		smp_rmb();
+		memcpy(buf + i * fifo->esize,
+		       fifo->data + slot * fifo->esize, fifo->esize);
+	}
+	if (!i)
+		return 0;
+
+	/*
+	 * Finish reading the whole batch before handing any of its slots
+	 * to the next lap's producers.
+	 */
+	smp_mb();
+	for (n = 0; n < i; n++)
+		fifo->seq[(out + n) & fifo->mask] = out + n + size;
+	fifo->out = out + i;
+
+	return i;
+}
+EXPORT_SYMBOL(__mpfifo_out);
@@ -0,0 +1,39 @@
+/*
+ * Per-cpu statistics
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/cpumask.h>
+#include <linux/export.h>
+#include <linux/pcpu_stats.h>
+#include <linux/string.h>
+
+void __pcpu_stats_fold(const void __percpu *stats, u64 *sum,
+		       unsigned int nr, size_t syncp_offset)
+{
+	u64 snap[PCPU_STATS_MAX];
+	unsigned int i, start;
+	int cpu;
+
+	memset(sum, 0, nr * sizeof(*sum));
+
+	for_each_possible_cpu(cpu) {
+		const u64 *cnt = per_cpu_ptr(stats, cpu);
+		const struct u64_stats_sync *syncp =
+			(const void *)cnt + syncp_offset;
+
+		/* retrying a snapshot must not count anything twice */
+		do {
+			start = u64_stats_fetch_begin_bh(syncp);
+			for (i = 0; i < nr; i++)
+				snap[i] = cnt[i];
+		} while (u64_stats_fetch_retry_bh(syncp, start));
+
+		for (i = 0; i < nr; i++)
+			sum[i] += snap[i];
+	}
+}
+EXPORT_SYMBOL(__pcpu_stats_fold);
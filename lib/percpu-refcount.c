@@ -0,0 +1,106 @@
+/*
+ * Percpu refcounts
+ *
+ * While a refcount is live, the real count is the sum of @count and of
+ * all the percpu counters; the percpu counters are unsigned and wrap
+ * around freely, only their sum matters.  @count starts out with
+ * PCPU_COUNT_BIAS added, so that puts which have already seen the dead
+ * flag, but drop a reference that was taken on a percpu counter, can't
+ * take it to zero before the percpu counters have been folded in.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/export.h>
+#include <linux/kernel.h>
+#include <linux/percpu-refcount.h>
+#include <linux/rcupdate.h>
+
+#define PCPU_COUNT_BIAS		(1U << 31)
+
+/**
+ * percpu_ref_init - initialize a percpu refcount
+ * @ref: percpu_ref to initialize
+ * @release: function which will be called when the refcount hits 0
+ *
+ * Initializes the refcount in percpu mode, holding one reference which
+ * is dropped by percpu_ref_kill().  Returns 0 or -ENOMEM.
+ */
+int percpu_ref_init(struct percpu_ref *ref, percpu_ref_release *release)
+{
+	atomic_set(&ref->count, 1 + PCPU_COUNT_BIAS);
+
+	ref->pcpu_count = alloc_percpu(unsigned);
+	if (!ref->pcpu_count)
+		return -ENOMEM;
+
+	ref->release = release;
+	return 0;
+}
+EXPORT_SYMBOL_GPL(percpu_ref_init);
+
+/**
+ * percpu_ref_cancel_init - drop a percpu refcount that was never killed
+ * @ref: percpu_ref to free
+ *
+ * Frees the percpu counters of a refcount whose object is destroyed on
+ * an error path, without going through percpu_ref_kill().  May be called
+ * after a failed percpu_ref_init().
+ */
+void percpu_ref_cancel_init(struct percpu_ref *ref)
+{
+	WARN_ON_ONCE(!__pcpu_ref_alive(ref->pcpu_count));
+
+	free_percpu(ref->pcpu_count);
+	ref->pcpu_count = NULL;
+}
+EXPORT_SYMBOL_GPL(percpu_ref_cancel_init);
+
+static void percpu_ref_kill_rcu(struct rcu_head *rcu)
+{
+	struct percpu_ref *ref = container_of(rcu, struct percpu_ref, rcu);
+	unsigned __percpu *pcpu_count = (unsigned __percpu *)
+		((unsigned long)ref->pcpu_count & ~PCPU_REF_DEAD);
+	unsigned count = 0;
+	int cpu;
+
+	for_each_possible_cpu(cpu)
+		count += *per_cpu_ptr(pcpu_count, cpu);
+
+	free_percpu(pcpu_count);
+
+	/*
+	 * Nobody touches the percpu counters any more: every get and put
+	 * that saw them alive ran in an RCU-sched read side section, which
+	 * has finished by now.  Fold them in, removing the bias.
+	 */
+	atomic_add((int)count - PCPU_COUNT_BIAS, &ref->count);
+
+	/* and drop the initial reference */
+	percpu_ref_put(ref);
+}
+
+/**
+ * percpu_ref_kill - start the teardown of a percpu refcount
+ * @ref: percpu_ref to kill
+ *
+ * Switches @ref to atomic mode and drops the initial reference.  From now
+ * on percpu_ref_tryget() fails; gets and puts go to the shared atomic
+ * count, and the release function is called once the last reference,
+ * wherever it was taken, is put.  The switch completes asynchronously,
+ * after an RCU-sched grace period, so the release function never runs
+ * from here directly.
+ */
+void percpu_ref_kill(struct percpu_ref *ref)
+{
+	WARN_ONCE(!__pcpu_ref_alive(ref->pcpu_count),
+		  "percpu_ref_kill() called more than once!\n");
+
+	ref->pcpu_count = (unsigned __percpu *)
+		((unsigned long)ref->pcpu_count | PCPU_REF_DEAD);
+
+	call_rcu_sched(&ref->rcu, percpu_ref_kill_rcu);
+}
+EXPORT_SYMBOL_GPL(percpu_ref_kill);
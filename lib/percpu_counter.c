@@ -1,5 +1,20 @@
 /*
  * Fast batching percpu counters.
+ *
+ * Each cpu accumulates up to percpu_counter_batch in its own counter
+ * before folding it into the shared count.  On NUMA machines it is
+ * folded into a count for its node instead, under a lock only the cpus
+ * of that node contend on, and a node's count is folded into fbc->count
+ * when it reaches the batch of all of the node's cpus together.
+ * That doubles the error of percpu_counter_read(), to two batches per
+ * cpu, so only adds with the default batch take the node path: callers
+ * passing a batch of their own (bdi stats, proportions) rely on the read
+ * being within nr_cpu_ids * batch, and keep folding into fbc->count.
+ *
+ * fbc->lock nests outside the node locks, so holding it keeps node
+ * counts from moving into fbc->count: a sum taken under it can add up
+ * one node at a time, and a comparison can stop as soon as the nodes
+ * not added up yet are too few to change its result.
  */
 
 #include <linux/percpu_counter.h>
@@ -9,12 +24,190 @@
 #include <linux/cpu.h>
 #include <linux/module.h>
 #include <linux/debugobjects.h>
+#include <linux/slab.h>
+#include <linux/topology.h>
 
 #ifdef CONFIG_HOTPLUG_CPU
 static LIST_HEAD(percpu_counters);
 static DEFINE_SPINLOCK(percpu_counters_lock);
 #endif
 
+#ifdef CONFIG_NUMA
+
+struct percpu_counter_node {
+	raw_spinlock_t lock;
+	s64 count;
+} ____cacheline_aligned_in_smp;
+
+/* number of online cpus on each node */
+static int nr_node_cpus[MAX_NUMNODES] __read_mostly;
+
+static inline bool percpu_counter_has_nodes(struct percpu_counter *fbc)
+{
+	return fbc->nodes != NULL;
+}
+
+static int percpu_counter_init_nodes(struct percpu_counter *fbc)
+{
+	int node;
+
+	fbc->nodes = NULL;
+	if (nr_node_ids == 1)
+		return 0;
+
+	fbc->nodes = kcalloc(nr_node_ids, sizeof(*fbc->nodes), GFP_KERNEL);
+	if (!fbc->nodes)
+		return -ENOMEM;
+	for (node = 0; node < nr_node_ids; node++)
+		raw_spin_lock_init(&fbc->nodes[node].lock);
+	return 0;
+}
+
+static void percpu_counter_destroy_nodes(struct percpu_counter *fbc)
+{
+	kfree(fbc->nodes);
+	fbc->nodes = NULL;
+}
+
+/* Called with fbc->lock held */
+static void percpu_counter_reset_nodes(struct percpu_counter *fbc)
+{
+	int node;
+
+	if (!fbc->nodes)
+		return;
+	for (node = 0; node < nr_node_ids; node++) {
+		raw_spin_lock(&fbc->nodes[node].lock);
+		fbc->nodes[node].count = 0;
+		raw_spin_unlock(&fbc->nodes[node].lock);
+	}
+}
+
+/*
+ * Fold this cpu's count into its node's, and the node's into fbc->count
+ * once it has reached the node's batch.  Returns false, doing nothing,
+ * if @fbc has no node counts.  Called with preemption disabled.
+ */
+static bool percpu_counter_fold_cpu(struct percpu_counter *fbc, s64 count)
+{
+	int node = numa_node_id();
+	struct percpu_counter_node *pcn;
+	s64 node_batch;
+
+	if (!fbc->nodes)
+		return false;
+
+	pcn = &fbc->nodes[node];
+	node_batch = (s64)percpu_counter_batch * nr_node_cpus[node];
+
+	raw_spin_lock(&pcn->lock);
+	pcn->count += count;
+	__this_cpu_write(*fbc->counters, 0);
+	count = pcn->count;
+	raw_spin_unlock(&pcn->lock);
+
+	if (count >= node_batch || count <= -node_batch) {
+		raw_spin_lock(&fbc->lock);
+		raw_spin_lock(&pcn->lock);
+		fbc->count += pcn->count;
+		pcn->count = 0;
+		raw_spin_unlock(&pcn->lock);
+		raw_spin_unlock(&fbc->lock);
+	}
+	return true;
+}
+
+/*
+ * Add up a node's count and the counts of its online cpus, setting @nr
+ * to the number of cpus.  Called with fbc->lock held.
+ */
+static s64 percpu_counter_node_sum(struct percpu_counter *fbc, int node,
+				   int *nr)
+{
+	struct percpu_counter_node *pcn = &fbc->nodes[node];
+	s64 ret;
+	int cpu;
+
+	*nr = 0;
+	raw_spin_lock(&pcn->lock);
+	ret = pcn->count;
+	for_each_online_cpu(cpu) {
+		if (cpu_to_node(cpu) != node)
+			continue;
+		ret += *per_cpu_ptr(fbc->counters, cpu);
+		(*nr)++;
+	}
+	raw_spin_unlock(&pcn->lock);
+	return ret;
+}
+
+/*
+ * Add up the counts node by node.  Unless @exact, stop as soon as the
+ * cpus of the nodes not added up yet can't hold enough to move the total
+ * to the other side of @rhs, and return an approximation which is on the
+ * same side of @rhs as the exact sum.
+ */
+static s64 percpu_counter_sum_nodes(struct percpu_counter *fbc, s64 rhs,
+				    bool exact)
+{
+	s64 ret, approx, slack;
+	int node, n, nr;
+
+	raw_spin_lock(&fbc->lock);
+	ret = fbc->count;
+	slack = (s64)percpu_counter_batch * num_online_cpus();
+	for_each_node(node) {
+		if (!exact) {
+			approx = ret;
+			for (n = node; n < nr_node_ids; n++)
+				approx += ACCESS_ONCE(fbc->nodes[n].count);
+			if (abs64(approx - rhs) > slack) {
+				ret = approx;
+				break;
+			}
+		}
+		ret += percpu_counter_node_sum(fbc, node, &nr);
+		slack -= (s64)percpu_counter_batch * nr;
+	}
+	raw_spin_unlock(&fbc->lock);
+	return ret;
+}
+
+#else	/* CONFIG_NUMA */
+
+static inline bool percpu_counter_has_nodes(struct percpu_counter *fbc)
+{
+	return false;
+}
+
+static inline int percpu_counter_init_nodes(struct percpu_counter *fbc)
+{
+	return 0;
+}
+
+static inline void percpu_counter_destroy_nodes(struct percpu_counter *fbc)
+{
+}
+
+static inline void percpu_counter_reset_nodes(struct percpu_counter *fbc)
+{
+}
+
+static inline bool percpu_counter_fold_cpu(struct percpu_counter *fbc,
+					   s64 count)
+{
+	return false;
+}
+
+static inline s64 percpu_counter_sum_nodes(struct percpu_counter *fbc,
+					   s64 rhs, bool exact)
+{
+	BUG();
+	return 0;
+}
+
+#endif	/* CONFIG_NUMA */
+
 #ifdef CONFIG_DEBUG_OBJECTS_PERCPU_COUNTER
 
 static struct debug_obj_descr percpu_counter_debug_descr;
@@ -66,6 +259,7 @@ void percpu_counter_set(struct percpu_counter *fbc, s64 amount)
 		s32 *pcount = per_cpu_ptr(fbc->counters, cpu);
 		*pcount = 0;
 	}
+	percpu_counter_reset_nodes(fbc);
 	fbc->count = amount;
 	raw_spin_unlock(&fbc->lock);
 }
@@ -78,10 +272,13 @@ void __percpu_counter_add(struct percpu_counter *fbc, s64 amount, s32 batch)
 	preempt_disable();
 	count = __this_cpu_read(*fbc->counters) + amount;
 	if (count >= batch || count <= -batch) {
-		raw_spin_lock(&fbc->lock);
-		fbc->count += count;
-		__this_cpu_write(*fbc->counters, 0);
-		raw_spin_unlock(&fbc->lock);
+		if (batch != percpu_counter_batch ||
+		    !percpu_counter_fold_cpu(fbc, count)) {
+			raw_spin_lock(&fbc->lock);
+			fbc->count += count;
+			__this_cpu_write(*fbc->counters, 0);
+			raw_spin_unlock(&fbc->lock);
+		}
 	} else {
 		__this_cpu_write(*fbc->counters, count);
 	}
@@ -98,6 +295,9 @@ s64 __percpu_counter_sum(struct percpu_counter *fbc)
 	s64 ret;
 	int cpu;
 
+	if (percpu_counter_has_nodes(fbc))
+		return percpu_counter_sum_nodes(fbc, 0, true);
+
 	raw_spin_lock(&fbc->lock);
 	ret = fbc->count;
 	for_each_online_cpu(cpu) {
@@ -118,6 +318,11 @@ int __percpu_counter_init(struct percpu_counter *fbc, s64 amount,
 	fbc->counters = alloc_percpu(s32);
 	if (!fbc->counters)
 		return -ENOMEM;
+	if (percpu_counter_init_nodes(fbc)) {
+		free_percpu(fbc->counters);
+		fbc->counters = NULL;
+		return -ENOMEM;
+	}
 
 	debug_percpu_counter_activate(fbc);
 
@@ -143,6 +348,7 @@ void percpu_counter_destroy(struct percpu_counter *fbc)
 	list_del(&fbc->list);
 	spin_unlock(&percpu_counters_lock);
 #endif
+	percpu_counter_destroy_nodes(fbc);
 	free_percpu(fbc->counters);
 	fbc->counters = NULL;
 }
@@ -154,6 +360,26 @@ EXPORT_SYMBOL(percpu_counter_batch);
 static void compute_batch_value(void)
 {
 	int nr = num_online_cpus();
+#ifdef CONFIG_NUMA
+	int cpu, node;
+
+	for_each_node(node)
+		nr_node_cpus[node] = 0;
+	for_each_online_cpu(cpu)
+		nr_node_cpus[cpu_to_node(cpu)]++;
+
+	/*
+	 * With node counts, a cpu's batch only goes to its node's lock, so
+	 * size it for the contention on the biggest node's lock rather than
+	 * on fbc->lock.  That also keeps the error of percpu_counter_read()
+	 * from growing with the number of nodes.
+	 */
+	if (nr_node_ids > 1) {
+		nr = 0;
+		for_each_node(node)
+			nr = max(nr, nr_node_cpus[node]);
+	}
+#endif
 
 	percpu_counter_batch = max(32, nr*2);
 }
@@ -192,18 +418,26 @@ static int __cpuinit percpu_counter_hotcpu_callback(struct notifier_block *nb,
  */
 int percpu_counter_compare(struct percpu_counter *fbc, s64 rhs)
 {
-	s64	count;
+	s64	count, error;
+
+	/* cpus hold less than a batch each, and nodes as much again */
+	error = (s64)percpu_counter_batch * num_online_cpus();
+	if (percpu_counter_has_nodes(fbc))
+		error *= 2;
 
 	count = percpu_counter_read(fbc);
 	/* Check to see if rough count will be sufficient for comparison */
-	if (abs(count - rhs) > (percpu_counter_batch*num_online_cpus())) {
+	if (abs64(count - rhs) > error) {
 		if (count > rhs)
 			return 1;
 		else
 			return -1;
 	}
-	/* Need to use precise count */
-	count = percpu_counter_sum(fbc);
+	/* Need to use precise count, or at least the nodes' counts */
+	if (percpu_counter_has_nodes(fbc))
+		count = percpu_counter_sum_nodes(fbc, rhs, false);
+	else
+		count = percpu_counter_sum(fbc);
 	if (count > rhs)
 		return 1;
 	else if (count < rhs)
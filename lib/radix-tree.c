@@ -104,6 +104,46 @@ static inline void *indirect_to_ptr(void *ptr)
 	return (void *)((unsigned long)ptr & ~RADIX_TREE_INDIRECT_PTR);
 }
 
+static inline void *sibling_entry(unsigned int offset)
+{
+	return (void *)(((unsigned long)offset << RADIX_TREE_EXCEPTIONAL_SHIFT) |
+			RADIX_TREE_INDIRECT_PTR);
+}
+
+static inline unsigned int sibling_offset(void *entry)
+{
+	return (unsigned long)entry >> RADIX_TREE_EXCEPTIONAL_SHIFT;
+}
+
+/*
+ * Above the leaves, a slot holds a child node, a multi-order item or a
+ * sibling entry of one; the leaves never hold nodes.
+ */
+static inline int radix_tree_is_node(void *ptr)
+{
+	return radix_tree_is_indirect_ptr(ptr) &&
+		!radix_tree_is_sibling_entry(ptr);
+}
+
+/*
+ * Read the slot of @parent at @offset into *@entryp, following a sibling
+ * entry to the slot holding its multi-order item.  Returns the offset of the
+ * slot that was read last, which is the one carrying the item's tags.
+ */
+static inline unsigned int radix_tree_descend(struct radix_tree_node *parent,
+					      void **entryp, unsigned int offset)
+{
+	void *entry = rcu_dereference_raw(parent->slots[offset]);
+
+	if (radix_tree_is_sibling_entry(entry)) {
+		offset = sibling_offset(entry);
+		entry = rcu_dereference_raw(parent->slots[offset]);
+	}
+
+	*entryp = entry;
+	return offset;
+}
+
 static inline gfp_t root_gfp_mask(struct radix_tree_root *root)
 {
 	return root->gfp_mask & __GFP_BITS_MASK;
@@ -337,8 +377,9 @@ static int radix_tree_extend(struct radix_tree_root *root, unsigned long index)
 		node->parent = NULL;
 		slot = root->rnode;
 		if (newheight > 1) {
-			slot = indirect_to_ptr(slot);
-			slot->parent = node;
+			struct radix_tree_node *child = indirect_to_ptr(slot);
+
+			child->parent = node;
 		}
 		node->slots[0] = slot;
 		node = ptr_to_indirect(node);
@@ -350,67 +391,101 @@ out:
 }
 
 /**
- *	radix_tree_insert    -    insert into a radix tree
+ *	radix_tree_insert_order    -    insert a multi-order item into a radix tree
  *	@root:		radix tree root
- *	@index:		index key
+ *	@index:		first index covered by the item
+ *	@order:		the item covers 2^@order indices
  *	@item:		item to insert
  *
- *	Insert an item into the radix tree at position @index.
+ *	Insert an item into the radix tree, covering the indices from @index,
+ *	which must be a multiple of 2^@order, to @index + 2^@order - 1.  A
+ *	lookup of any of them finds the item, gang lookups return it once, and
+ *	it carries one set of tags.  Returns -EEXIST if any of the indices is
+ *	already in use.
+ *
+ *	The item takes a single slot, plus a sibling entry for each further
+ *	slot it spans when @order is not a multiple of the node size, so for
+ *	instance a huge page can be put in the page cache without a slot for
+ *	each of its subpages.
  */
-int radix_tree_insert(struct radix_tree_root *root,
-			unsigned long index, void *item)
+int radix_tree_insert_order(struct radix_tree_root *root, unsigned long index,
+			    unsigned int order, void *item)
 {
 	struct radix_tree_node *node = NULL, *slot;
-	unsigned int height, shift;
-	int offset;
+	unsigned int height, shift, item_height;
+	unsigned long max_index;
+	int offset, i, nr;
 	int error;
 
 	BUG_ON(radix_tree_is_indirect_ptr(item));
+	BUG_ON(order >= RADIX_TREE_INDEX_BITS - RADIX_TREE_MAP_SHIFT);
+	BUG_ON(index & ((1UL << order) - 1));
+
+	/*
+	 * The item goes in a node of height item_height, whose slots each
+	 * cover 2^((item_height - 1) * RADIX_TREE_MAP_SHIFT) indices, and
+	 * takes nr of them.  Only an order 0 item can be the root.
+	 */
+	item_height = order / RADIX_TREE_MAP_SHIFT + 1;
+	nr = 1 << (order % RADIX_TREE_MAP_SHIFT);
+	max_index = index + (1UL << order) - 1;
+	if (order)
+		max_index = max(max_index,
+				radix_tree_maxindex(item_height - 1) + 1);
 
 	/* Make sure the tree is high enough.  */
-	if (index > radix_tree_maxindex(root->height)) {
-		error = radix_tree_extend(root, index);
+	if (max_index > radix_tree_maxindex(root->height)) {
+		error = radix_tree_extend(root, max_index);
 		if (error)
 			return error;
 	}
 
-	slot = indirect_to_ptr(root->rnode);
+	slot = root->rnode;
 
 	height = root->height;
 	shift = (height-1) * RADIX_TREE_MAP_SHIFT;
 
 	offset = 0;			/* uninitialised var warning */
-	while (height > 0) {
+	while (height >= item_height) {
 		if (slot == NULL) {
 			/* Have to add a child node.  */
 			if (!(slot = radix_tree_node_alloc(root)))
 				return -ENOMEM;
 			slot->height = height;
 			slot->parent = node;
+			slot = ptr_to_indirect(slot);
 			if (node) {
 				rcu_assign_pointer(node->slots[offset], slot);
 				node->count++;
 			} else
-				rcu_assign_pointer(root->rnode, ptr_to_indirect(slot));
+				rcu_assign_pointer(root->rnode, slot);
+		} else if (!radix_tree_is_node(slot)) {
+			/* Covered by a multi-order item */
+			return -EEXIST;
 		}
 
 		/* Go a level down */
 		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
-		node = slot;
+		node = indirect_to_ptr(slot);
 		slot = node->slots[offset];
 		shift -= RADIX_TREE_MAP_SHIFT;
 		height--;
 	}
 
-	if (slot != NULL)
-		return -EEXIST;
-
 	if (node) {
-		node->count++;
+		for (i = 0; i < nr; i++)
+			if (node->slots[offset + i] != NULL)
+				return -EEXIST;
+
+		for (i = 1; i < nr; i++)
+			node->slots[offset + i] = sibling_entry(offset);
+		node->count += nr;
 		rcu_assign_pointer(node->slots[offset], item);
 		BUG_ON(tag_get(node, 0, offset));
 		BUG_ON(tag_get(node, 1, offset));
 	} else {
+		if (slot != NULL)
+			return -EEXIST;
 		rcu_assign_pointer(root->rnode, item);
 		BUG_ON(root_tag_get(root, 0));
 		BUG_ON(root_tag_get(root, 1));
@@ -418,6 +493,21 @@ int radix_tree_insert(struct radix_tree_root *root,
 
 	return 0;
 }
+EXPORT_SYMBOL(radix_tree_insert_order);
+
+/**
+ *	radix_tree_insert    -    insert into a radix tree
+ *	@root:		radix tree root
+ *	@index:		index key
+ *	@item:		item to insert
+ *
+ *	Insert an item into the radix tree at position @index.
+ */
+int radix_tree_insert(struct radix_tree_root *root,
+			unsigned long index, void *item)
+{
+	return radix_tree_insert_order(root, index, 0, item);
+}
 EXPORT_SYMBOL(radix_tree_insert);
 
 /*
@@ -427,8 +517,8 @@ EXPORT_SYMBOL(radix_tree_insert);
 static void *radix_tree_lookup_element(struct radix_tree_root *root,
 				unsigned long index, int is_slot)
 {
-	unsigned int height, shift;
-	struct radix_tree_node *node, **slot;
+	unsigned int height, shift, offset;
+	struct radix_tree_node *node, *parent, **slot;
 
 	node = rcu_dereference_raw(root->rnode);
 	if (node == NULL)
@@ -448,11 +538,16 @@ static void *radix_tree_lookup_element(struct radix_tree_root *root,
 	shift = (height-1) * RADIX_TREE_MAP_SHIFT;
 
 	do {
-		slot = (struct radix_tree_node **)
-			(node->slots + ((index>>shift) & RADIX_TREE_MAP_MASK));
-		node = rcu_dereference_raw(*slot);
+		parent = indirect_to_ptr(node);
+		offset = radix_tree_descend(parent, (void **)&node,
+				(index >> shift) & RADIX_TREE_MAP_MASK);
 		if (node == NULL)
 			return NULL;
+		slot = (struct radix_tree_node **)(parent->slots + offset);
+
+		/* A multi-order item above the leaves */
+		if (height > 1 && !radix_tree_is_indirect_ptr(node))
+			break;
 
 		shift -= RADIX_TREE_MAP_SHIFT;
 		height--;
@@ -515,7 +610,7 @@ void *radix_tree_tag_set(struct radix_tree_root *root,
 			unsigned long index, unsigned int tag)
 {
 	unsigned int height, shift;
-	struct radix_tree_node *slot;
+	struct radix_tree_node *node, *slot;
 
 	height = root->height;
 	BUG_ON(index > radix_tree_maxindex(height));
@@ -526,11 +621,15 @@ void *radix_tree_tag_set(struct radix_tree_root *root,
 	while (height > 0) {
 		int offset;
 
-		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
-		if (!tag_get(slot, tag, offset))
-			tag_set(slot, tag, offset);
-		slot = slot->slots[offset];
+		node = slot;
+		offset = radix_tree_descend(node, (void **)&slot,
+				(index >> shift) & RADIX_TREE_MAP_MASK);
 		BUG_ON(slot == NULL);
+		if (!tag_get(node, tag, offset))
+			tag_set(node, tag, offset);
+		if (!radix_tree_is_indirect_ptr(slot))
+			break;
+		slot = indirect_to_ptr(slot);
 		shift -= RADIX_TREE_MAP_SHIFT;
 		height--;
 	}
@@ -577,14 +676,19 @@ void *radix_tree_tag_clear(struct radix_tree_root *root,
 			goto out;
 
 		shift -= RADIX_TREE_MAP_SHIFT;
-		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
 		node = slot;
-		slot = slot->slots[offset];
+		offset = radix_tree_descend(node, (void **)&slot,
+				(index >> shift) & RADIX_TREE_MAP_MASK);
+		if (!radix_tree_is_indirect_ptr(slot))
+			break;
+		slot = indirect_to_ptr(slot);
 	}
 
 	if (slot == NULL)
 		goto out;
 
+	/* Walk back up from the node holding the item */
+	index >>= shift;
 	while (node) {
 		if (!tag_get(node, tag, offset))
 			goto out;
@@ -646,17 +750,20 @@ int radix_tree_tag_get(struct radix_tree_root *root,
 	shift = (height - 1) * RADIX_TREE_MAP_SHIFT;
 
 	for ( ; ; ) {
+		struct radix_tree_node *parent;
 		int offset;
 
 		if (node == NULL)
 			return 0;
 
-		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
-		if (!tag_get(node, tag, offset))
+		parent = node;
+		offset = radix_tree_descend(parent, (void **)&node,
+				(index >> shift) & RADIX_TREE_MAP_MASK);
+		if (!tag_get(parent, tag, offset))
 			return 0;
-		if (height == 1)
+		if (height == 1 || !radix_tree_is_indirect_ptr(node))
 			return 1;
-		node = rcu_dereference_raw(node->slots[offset]);
+		node = indirect_to_ptr(node);
 		shift -= RADIX_TREE_MAP_SHIFT;
 		height--;
 	}
@@ -675,7 +782,7 @@ void **radix_tree_next_chunk(struct radix_tree_root *root,
 			     struct radix_tree_iter *iter, unsigned flags)
 {
 	unsigned shift, tag = flags & RADIX_TREE_ITER_TAG_MASK;
-	struct radix_tree_node *rnode, *node;
+	struct radix_tree_node *rnode, *node, *child;
 	unsigned long index, offset;
 
 	if ((flags & RADIX_TREE_ITER_TAGGED) && !root_tag_get(root, tag))
@@ -702,6 +809,7 @@ void **radix_tree_next_chunk(struct radix_tree_root *root,
 		iter->index = 0;
 		iter->next_index = 1;
 		iter->tags = 1;
+		iter->shift = 0;
 		return (void **)&root->rnode;
 	} else
 		return NULL;
@@ -716,9 +824,15 @@ restart:
 
 	node = rnode;
 	while (1) {
+		/*
+		 * Starting in the middle of a multi-order item: go back to
+		 * its first index, to return it whole.
+		 */
+		offset = radix_tree_descend(node, (void **)&child, offset);
+
 		if ((flags & RADIX_TREE_ITER_TAGGED) ?
 				!test_bit(offset, node->tags[tag]) :
-				!node->slots[offset]) {
+				!child) {
 			/* Hole detected */
 			if (flags & RADIX_TREE_ITER_CONTIG)
 				return NULL;
@@ -730,7 +844,9 @@ restart:
 						offset + 1);
 			else
 				while (++offset	< RADIX_TREE_MAP_SIZE) {
-					if (node->slots[offset])
+					child = node->slots[offset];
+					if (child &&
+					    !radix_tree_is_sibling_entry(child))
 						break;
 				}
 			index &= ~((RADIX_TREE_MAP_SIZE << shift) - 1);
@@ -740,22 +856,30 @@ restart:
 				return NULL;
 			if (offset == RADIX_TREE_MAP_SIZE)
 				goto restart;
+			child = rcu_dereference_raw(node->slots[offset]);
 		}
 
 		/* This is leaf-node */
 		if (!shift)
 			break;
 
-		node = rcu_dereference_raw(node->slots[offset]);
-		if (node == NULL)
+		if (child == NULL || radix_tree_is_sibling_entry(child))
 			goto restart;
+		/* A multi-order item above the leaves */
+		if (!radix_tree_is_indirect_ptr(child))
+			break;
+
+		node = indirect_to_ptr(child);
 		shift -= RADIX_TREE_MAP_SHIFT;
 		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
 	}
 
 	/* Update the iterator state */
+	index &= ~((RADIX_TREE_MAP_SIZE << shift) - 1);
+	index += offset << shift;
 	iter->index = index;
-	iter->next_index = (index | RADIX_TREE_MAP_MASK) + 1;
+	iter->next_index = (index | ((RADIX_TREE_MAP_SIZE << shift) - 1)) + 1;
+	iter->shift = shift;
 
 	/* Construct iter->tags bit-mask from node->tags[tag] array */
 	if (flags & RADIX_TREE_ITER_TAGGED) {
@@ -771,7 +895,8 @@ restart:
 				iter->tags |= node->tags[tag][tag_long + 1] <<
 						(BITS_PER_LONG - tag_bit);
 			/* Clip chunk size, here only BITS_PER_LONG tags */
-			iter->next_index = index + BITS_PER_LONG;
+			iter->next_index = index +
+				((unsigned long)BITS_PER_LONG << shift);
 		}
 	}
 
@@ -814,6 +939,7 @@ unsigned long radix_tree_range_tag_if_tagged(struct radix_tree_root *root,
 	unsigned int height = root->height;
 	struct radix_tree_node *node = NULL;
 	struct radix_tree_node *slot;
+	void *child;
 	unsigned int shift;
 	unsigned long tagged = 0;
 	unsigned long index = *first_indexp;
@@ -840,25 +966,30 @@ unsigned long radix_tree_range_tag_if_tagged(struct radix_tree_root *root,
 		unsigned long upindex;
 		int offset;
 
-		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
-		if (!slot->slots[offset])
+		/*
+		 * Starting in the middle of a multi-order item: its tags are
+		 * on its first slot.
+		 */
+		offset = radix_tree_descend(slot, &child,
+					    (index >> shift) & RADIX_TREE_MAP_MASK);
+		if (!child)
 			goto next;
 		if (!tag_get(slot, iftag, offset))
 			goto next;
-		if (shift) {
+		if (shift && radix_tree_is_node(child)) {
 			/* Go down one level */
 			shift -= RADIX_TREE_MAP_SHIFT;
 			node = slot;
-			slot = slot->slots[offset];
+			slot = indirect_to_ptr(child);
 			continue;
 		}
 
-		/* tag the leaf */
+		/* tag the leaf, or the multi-order item */
 		tagged++;
 		tag_set(slot, settag, offset);
 
 		/* walk back up the path tagging interior nodes */
-		upindex = index;
+		upindex = index >> shift;
 		while (node) {
 			upindex >>= RADIX_TREE_MAP_SHIFT;
 			offset = upindex & RADIX_TREE_MAP_MASK;
@@ -882,6 +1013,11 @@ unsigned long radix_tree_range_tag_if_tagged(struct radix_tree_root *root,
 next:
 		/* Go to next item at level determined by 'shift' */
 		index = ((index >> shift) + 1) << shift;
+		/* ...skipping the rest of a multi-order item */
+		while (index && ((index >> shift) & RADIX_TREE_MAP_MASK) &&
+		       radix_tree_is_sibling_entry(slot->slots[
+				(index >> shift) & RADIX_TREE_MAP_MASK]))
+			index += 1UL << shift;
 		/* Overflow can happen when last_index is ~0UL... */
 		if (index > last_index || !index)
 			break;
@@ -1151,6 +1287,7 @@ static unsigned long __locate(struct radix_tree_node *slot, void *item,
 {
 	unsigned int shift, height;
 	unsigned long i;
+	void *entry;
 
 	height = slot->height;
 	shift = (height-1) * RADIX_TREE_MAP_SHIFT;
@@ -1158,8 +1295,15 @@ static unsigned long __locate(struct radix_tree_node *slot, void *item,
 	for ( ; height > 1; height--) {
 		i = (index >> shift) & RADIX_TREE_MAP_MASK;
 		for (;;) {
-			if (slot->slots[i] != NULL)
+			entry = rcu_dereference_raw(slot->slots[i]);
+			if (radix_tree_is_node(entry))
 				break;
+			if (entry && entry == item) {
+				/* A multi-order item */
+				*found_index = index & ~((1UL << shift) - 1);
+				index = 0;
+				goto out;
+			}
 			index &= ~((1UL << shift) - 1);
 			index += 1UL << shift;
 			if (index == 0)
@@ -1170,9 +1314,7 @@ static unsigned long __locate(struct radix_tree_node *slot, void *item,
 		}
 
 		shift -= RADIX_TREE_MAP_SHIFT;
-		slot = rcu_dereference_raw(slot->slots[i]);
-		if (slot == NULL)
-			goto out;
+		slot = indirect_to_ptr(entry);
 	}
 
 	/* Bottom level: check items */
@@ -1255,6 +1397,10 @@ static inline void radix_tree_shrink(struct radix_tree_root *root)
 			break;
 		if (!to_free->slots[0])
 			break;
+		/* A multi-order item can't be the root */
+		if (root->height > 1 &&
+		    !radix_tree_is_indirect_ptr(to_free->slots[0]))
+			break;
 
 		/*
 		 * We don't need rcu_assign_pointer(), since we are simply
@@ -1265,8 +1411,9 @@ static inline void radix_tree_shrink(struct radix_tree_root *root)
 		 */
 		slot = to_free->slots[0];
 		if (root->height > 1) {
-			slot->parent = NULL;
-			slot = ptr_to_indirect(slot);
+			struct radix_tree_node *child = indirect_to_ptr(slot);
+
+			child->parent = NULL;
 		}
 		root->rnode = slot;
 		root->height--;
@@ -1312,7 +1459,7 @@ void *radix_tree_delete(struct radix_tree_root *root, unsigned long index)
 	struct radix_tree_node *slot = NULL;
 	struct radix_tree_node *to_free;
 	unsigned int height, shift;
-	int tag;
+	int tag, nr;
 	int uninitialized_var(offset);
 
 	height = root->height;
@@ -1333,9 +1480,12 @@ void *radix_tree_delete(struct radix_tree_root *root, unsigned long index)
 			goto out;
 
 		shift -= RADIX_TREE_MAP_SHIFT;
-		offset = (index >> shift) & RADIX_TREE_MAP_MASK;
 		node = slot;
-		slot = slot->slots[offset];
+		offset = radix_tree_descend(node, (void **)&slot,
+				(index >> shift) & RADIX_TREE_MAP_MASK);
+		if (!radix_tree_is_indirect_ptr(slot))
+			break;
+		slot = indirect_to_ptr(slot);
 	} while (shift);
 
 	if (slot == NULL)
@@ -1350,7 +1500,16 @@ void *radix_tree_delete(struct radix_tree_root *root, unsigned long index)
 			radix_tree_tag_clear(root, index, tag);
 	}
 
+	/* A multi-order item also takes the sibling entries after it */
+	for (nr = 1; offset + nr < RADIX_TREE_MAP_SIZE; nr++) {
+		if (node->slots[offset + nr] != sibling_entry(offset))
+			break;
+		node->slots[offset + nr] = NULL;
+	}
+	node->count -= nr - 1;
+
 	to_free = NULL;
+	index >>= shift;
 	/* Now free the nodes we do not need anymore */
 	while (node) {
 		node->slots[offset] = NULL;
@@ -1446,6 +1605,8 @@ static int radix_tree_callback(struct notifier_block *nfb,
 
 void __init radix_tree_init(void)
 {
+	BUILD_BUG_ON(RADIX_TREE_MAP_SIZE << RADIX_TREE_EXCEPTIONAL_SHIFT >
+		     RADIX_TREE_SIBLING_LIMIT);
 	radix_tree_node_cachep = kmem_cache_create("radix_tree_node",
 			sizeof(struct radix_tree_node), 0,
 			SLAB_PANIC | SLAB_RECLAIM_ACCOUNT,
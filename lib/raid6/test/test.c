@@ -22,17 +22,18 @@
 #define NDISKS		16	/* Including P and Q */
 
 const char raid6_empty_zero_page[PAGE_SIZE] __attribute__((aligned(256)));
-struct raid6_calls raid6_call;
 
 char *dataptrs[NDISKS];
-char data[NDISKS][PAGE_SIZE];
-char recovi[PAGE_SIZE], recovj[PAGE_SIZE];
+char data[NDISKS][PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+char recovi[PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+char recovj[PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+char refsyn[2][PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
 
-static void makedata(void)
+static void makedata(int start, int stop)
 {
 	int i, j;
 
-	for (i = 0; i < NDISKS; i++) {
+	for (i = start; i <= stop; i++) {
 		for (j = 0; j < PAGE_SIZE; j++)
 			data[i][j] = rand();
 
@@ -87,6 +88,35 @@ static int test_disks(int i, int j)
 	return erra || errb;
 }
 
+/*
+ * Simulate a read-modify-write of data disks start..stop: XOR out the
+ * old contents, replace them, XOR in the new contents, and check the
+ * result against a freshly generated syndrome.
+ */
+static int test_rmw(int start, int stop)
+{
+	int err;
+
+	raid6_call.xor_syndrome(NDISKS, start, stop, PAGE_SIZE,
+				(void **)&dataptrs);
+	makedata(start, stop);
+	raid6_call.xor_syndrome(NDISKS, start, stop, PAGE_SIZE,
+				(void **)&dataptrs);
+
+	dataptrs[NDISKS-2] = refsyn[0];
+	dataptrs[NDISKS-1] = refsyn[1];
+	raid6_call.gen_syndrome(NDISKS, PAGE_SIZE, (void **)&dataptrs);
+	dataptrs[NDISKS-2] = data[NDISKS-2];
+	dataptrs[NDISKS-1] = data[NDISKS-1];
+
+	err = memcmp(refsyn, data[NDISKS-2], 2*PAGE_SIZE) != 0;
+	if (err)
+		printf("algo=%-8s  rmw start=%3d stop=%3d  ERR\n",
+		       raid6_call.name, start, stop);
+
+	return err;
+}
+
 int main(int argc, char *argv[])
 {
 	const struct raid6_calls *const *algo;
@@ -94,7 +124,7 @@ int main(int argc, char *argv[])
 	int i, j;
 	int err = 0;
 
-	makedata();
+	makedata(0, NDISKS-1);
 
 	for (ra = raid6_recov_algos; *ra; ra++) {
 		if ((*ra)->valid  && !(*ra)->valid())
@@ -118,6 +148,15 @@ int main(int argc, char *argv[])
 				for (i = 0; i < NDISKS-1; i++)
 					for (j = i+1; j < NDISKS; j++)
 						err += test_disks(i, j);
+
+				if (!raid6_call.xor_syndrome)
+					continue;
+
+				for (i = 0; i < NDISKS-2; i++)
+					for (j = i; j < NDISKS-2; j++)
+						err += test_rmw(i, j);
+				printf("algo=%-8s  rmw %s\n", raid6_call.name,
+				       err ? "ERRORS" : "OK");
 			}
 		}
 		printf("\n");
@@ -0,0 +1,480 @@
+/*
+ * Resizable hash table with RCU protected lookups
+ *
+ * A resize allocates the new table and hangs it off the old one as
+ * future_tbl.  Once a grace period has passed every insertion goes to
+ * the new table, so the old buckets only have to be emptied once: each
+ * is locked in turn and its entries are moved over, always taking the
+ * last one of the chain.  A lookup walking the chain at that moment
+ * either is past the entry and ends early, or follows it into the chain
+ * of the new table, which does no harm; in both cases it goes on to look
+ * in the new table.  When the old table is empty ht->tbl is switched
+ * over and the old table is freed after another grace period.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/kernel.h>
+#include <linux/export.h>
+#include <linux/jhash.h>
+#include <linux/log2.h>
+#include <linux/mm.h>
+#include <linux/random.h>
+#include <linux/rhashtable.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/vmalloc.h>
+
+#define HASH_DEFAULT_SIZE	64UL
+#define HASH_MIN_SIZE		4UL
+#define BUCKET_LOCKS_PER_CPU	128UL
+
+static u32 rht_bucket_index(const struct bucket_table *tbl, u32 hash)
+{
+	return hash & (tbl->size - 1);
+}
+
+static void *rht_obj(const struct rhashtable *ht, const struct rhash_head *he)
+{
+	return (void *)he - ht->p.head_offset;
+}
+
+static u32 key_hashfn(const struct rhashtable *ht, const void *key)
+{
+	return ht->p.hashfn(key, ht->p.key_len, ht->p.hash_rnd);
+}
+
+static u32 head_hashfn(const struct rhashtable *ht,
+		       const struct rhash_head *he)
+{
+	return key_hashfn(ht, rht_obj(ht, he) + ht->p.key_offset);
+}
+
+static spinlock_t *bucket_lock(const struct bucket_table *tbl, u32 hash)
+{
+	return &tbl->locks[hash & tbl->locks_mask];
+}
+
+#ifdef CONFIG_PROVE_LOCKING
+int lockdep_rht_mutex_is_held(struct rhashtable *ht)
+{
+	return debug_locks ? lockdep_is_held(&ht->mutex) : 1;
+}
+EXPORT_SYMBOL_GPL(lockdep_rht_mutex_is_held);
+
+int lockdep_rht_bucket_is_held(const struct bucket_table *tbl, u32 hash)
+{
+	return debug_locks ? lockdep_is_held(bucket_lock(tbl, hash)) : 1;
+}
+EXPORT_SYMBOL_GPL(lockdep_rht_bucket_is_held);
+#endif
+
+static void *rht_zalloc(size_t size)
+{
+	void *p = NULL;
+
+	if (size <= (PAGE_SIZE << PAGE_ALLOC_COSTLY_ORDER))
+		p = kzalloc(size, GFP_KERNEL | __GFP_NOWARN);
+	if (!p)
+		p = vzalloc(size);
+
+	return p;
+}
+
+static void rht_free(const void *p)
+{
+	if (is_vmalloc_addr(p))
+		vfree(p);
+	else
+		kfree(p);
+}
+
+static struct bucket_table *bucket_table_alloc(struct rhashtable *ht,
+					       size_t nbuckets)
+{
+	struct bucket_table *tbl;
+	unsigned int nlocks, i;
+
+	tbl = rht_zalloc(sizeof(*tbl) + nbuckets * sizeof(tbl->buckets[0]));
+	if (!tbl)
+		return NULL;
+
+	tbl->size = nbuckets;
+
+	nlocks = roundup_pow_of_two(num_possible_cpus() * ht->p.locks_mul);
+	nlocks = min_t(size_t, nlocks, nbuckets);
+
+	tbl->locks = rht_zalloc(nlocks * sizeof(spinlock_t));
+	if (!tbl->locks) {
+		rht_free(tbl);
+		return NULL;
+	}
+	for (i = 0; i < nlocks; i++)
+		spin_lock_init(&tbl->locks[i]);
+	tbl->locks_mask = nlocks - 1;
+
+	return tbl;
+}
+
+static void bucket_table_free(const struct bucket_table *tbl)
+{
+	rht_free(tbl->locks);
+	rht_free(tbl);
+}
+
+static bool rht_grow_above_75(const struct rhashtable *ht,
+			      const struct bucket_table *tbl)
+{
+	return atomic_read(&ht->nelems) > tbl->size / 4 * 3 &&
+	       (!ht->p.max_size || tbl->size < ht->p.max_size);
+}
+
+static bool rht_shrink_below_30(const struct rhashtable *ht,
+				const struct bucket_table *tbl)
+{
+	return atomic_read(&ht->nelems) < tbl->size * 3 / 10 &&
+	       tbl->size > ht->p.min_size;
+}
+
+/* Move all entries of one old bucket to the new table */
+static void rhashtable_rehash_chain(struct rhashtable *ht,
+				    struct bucket_table *old_tbl,
+				    struct bucket_table *new_tbl,
+				    u32 old_hash)
+{
+	spinlock_t *old_lock = bucket_lock(old_tbl, old_hash);
+	struct rhash_head __rcu **pprev;
+	struct rhash_head *he, *next;
+	spinlock_t *new_lock;
+	u32 new_hash;
+
+	spin_lock_bh(old_lock);
+
+	for (;;) {
+		pprev = &old_tbl->buckets[old_hash];
+		he = rht_dereference_bucket(*pprev, old_tbl, old_hash);
+		if (!he)
+			break;
+
+		while ((next = rht_dereference_bucket(he->next, old_tbl,
+						      old_hash))) {
+			pprev = &he->next;
+			he = next;
+		}
+
+		new_hash = rht_bucket_index(new_tbl, head_hashfn(ht, he));
+		new_lock = bucket_lock(new_tbl, new_hash);
+
+		spin_lock_nested(new_lock, SINGLE_DEPTH_NESTING);
+		RCU_INIT_POINTER(he->next,
+				 rht_dereference_bucket(new_tbl->buckets[new_hash],
+							new_tbl, new_hash));
+		rcu_assign_pointer(new_tbl->buckets[new_hash], he);
+		spin_unlock(new_lock);
+
+		/* only unlink once it can be found in the new table */
+		rcu_assign_pointer(*pprev, NULL);
+	}
+
+	spin_unlock_bh(old_lock);
+}
+
+static int rhashtable_rehash(struct rhashtable *ht, size_t new_size)
+{
+	struct bucket_table *old_tbl = rht_dereference(ht->tbl, ht);
+	struct bucket_table *new_tbl;
+	u32 old_hash;
+
+	new_tbl = bucket_table_alloc(ht, new_size);
+	if (!new_tbl)
+		return -ENOMEM;
+
+	rcu_assign_pointer(old_tbl->future_tbl, new_tbl);
+
+	/*
+	 * Insertions that have not seen the new table are finished after
+	 * a grace period.  All later ones go to the new table, so nothing
+	 * lands in an old bucket that has already been emptied.
+	 */
+	synchronize_rcu();
+
+	for (old_hash = 0; old_hash < old_tbl->size; old_hash++) {
+		rhashtable_rehash_chain(ht, old_tbl, new_tbl, old_hash);
+		cond_resched();
+	}
+
+	rcu_assign_pointer(ht->tbl, new_tbl);
+
+	/* Wait for lookups and removals still looking at the old table */
+	synchronize_rcu();
+
+	bucket_table_free(old_tbl);
+	return 0;
+}
+
+static void rht_deferred_worker(struct work_struct *work)
+{
+	struct rhashtable *ht = container_of(work, struct rhashtable,
+					     run_work);
+	struct bucket_table *tbl;
+	int err = 0;
+
+	mutex_lock(&ht->mutex);
+
+	while (!ht->being_destroyed && !err) {
+		tbl = rht_dereference(ht->tbl, ht);
+
+		if (rht_grow_above_75(ht, tbl))
+			err = rhashtable_rehash(ht, tbl->size * 2);
+		else if (rht_shrink_below_30(ht, tbl))
+			err = rhashtable_rehash(ht, tbl->size / 2);
+		else
+			break;
+	}
+
+	mutex_unlock(&ht->mutex);
+}
+
+static void rht_schedule_resize(struct rhashtable *ht)
+{
+	queue_work(system_long_wq, &ht->run_work);
+}
+
+/**
+ * rhashtable_insert - insert object into hash table
+ * @ht:		hash table
+ * @obj:	pointer to hash head inside object
+ *
+ * Takes the bucket lock with bottom halves disabled, may be called from
+ * any context but hard interrupts.  Does not check for duplicates.
+ * Schedules a resize of the table if it is more than 75% full.
+ */
+void rhashtable_insert(struct rhashtable *ht, struct rhash_head *obj)
+{
+	struct bucket_table *tbl, *new_tbl;
+	spinlock_t *lock;
+	u32 hash;
+
+	rcu_read_lock();
+
+	tbl = rht_dereference_rcu(ht->tbl, ht);
+	new_tbl = rht_dereference_rcu(tbl->future_tbl, ht);
+	if (new_tbl)
+		tbl = new_tbl;
+
+	hash = rht_bucket_index(tbl, head_hashfn(ht, obj));
+	lock = bucket_lock(tbl, hash);
+
+	spin_lock_bh(lock);
+	RCU_INIT_POINTER(obj->next,
+			 rht_dereference_bucket(tbl->buckets[hash], tbl, hash));
+	rcu_assign_pointer(tbl->buckets[hash], obj);
+	spin_unlock_bh(lock);
+
+	atomic_inc(&ht->nelems);
+	if (rht_grow_above_75(ht, tbl))
+		rht_schedule_resize(ht);
+
+	rcu_read_unlock();
+}
+EXPORT_SYMBOL_GPL(rhashtable_insert);
+
+static bool __rhashtable_remove(struct rhashtable *ht,
+				struct bucket_table *tbl,
+				struct rhash_head *obj)
+{
+	struct rhash_head __rcu **pprev;
+	struct rhash_head *he;
+	spinlock_t *lock;
+	bool found = false;
+	u32 hash;
+
+	hash = rht_bucket_index(tbl, head_hashfn(ht, obj));
+	lock = bucket_lock(tbl, hash);
+
+	spin_lock_bh(lock);
+
+	pprev = &tbl->buckets[hash];
+	rht_for_each(he, tbl, hash) {
+		if (he != obj) {
+			pprev = &he->next;
+			continue;
+		}
+
+		rcu_assign_pointer(*pprev,
+				   rht_dereference_bucket(he->next, tbl, hash));
+		found = true;
+		break;
+	}
+
+	spin_unlock_bh(lock);
+
+	return found;
+}
+
+/**
+ * rhashtable_remove - remove object from hash table
+ * @ht:		hash table
+ * @obj:	pointer to hash head inside object
+ *
+ * Returns true if the object was found and removed.  The object may
+ * still be seen by RCU readers; the caller has to wait for a grace
+ * period before freeing or reusing it.  Schedules a resize of the table
+ * if it is less than 30% full.
+ */
+bool rhashtable_remove(struct rhashtable *ht, struct rhash_head *obj)
+{
+	struct bucket_table *tbl;
+	bool found = false;
+
+	rcu_read_lock();
+
+	tbl = rht_dereference_rcu(ht->tbl, ht);
+	do {
+		found = __rhashtable_remove(ht, tbl, obj);
+		if (found)
+			break;
+		tbl = rht_dereference_rcu(tbl->future_tbl, ht);
+	} while (tbl);
+
+	if (found) {
+		atomic_dec(&ht->nelems);
+		if (rht_shrink_below_30(ht, tbl))
+			rht_schedule_resize(ht);
+	}
+
+	rcu_read_unlock();
+
+	return found;
+}
+EXPORT_SYMBOL_GPL(rhashtable_remove);
+
+/**
+ * rhashtable_lookup - look up an object by key
+ * @ht:		hash table
+ * @key:	pointer to the key, of the length given at init
+ *
+ * Must be called under rcu_read_lock(); the object returned is only
+ * guaranteed to exist until rcu_read_unlock().  Returns NULL if not
+ * found.
+ */
+void *rhashtable_lookup(struct rhashtable *ht, const void *key)
+{
+	struct bucket_table *tbl;
+	struct rhash_head *he;
+	u32 hash;
+
+	tbl = rht_dereference_rcu(ht->tbl, ht);
+	hash = key_hashfn(ht, key);
+restart:
+	rht_for_each_rcu(he, tbl, rht_bucket_index(tbl, hash)) {
+		if (!memcmp(rht_obj(ht, he) + ht->p.key_offset, key,
+			    ht->p.key_len))
+			return rht_obj(ht, he);
+	}
+
+	/* Pairs with the barrier in rcu_assign_pointer(*pprev, NULL) */
+	smp_rmb();
+
+	tbl = rht_dereference_rcu(tbl->future_tbl, ht);
+	if (unlikely(tbl))
+		goto restart;
+
+	return NULL;
+}
+EXPORT_SYMBOL_GPL(rhashtable_lookup);
+
+static size_t rounded_hashtable_size(const struct rhashtable_params *params)
+{
+	size_t size = HASH_DEFAULT_SIZE;
+
+	if (params->nelem_hint)
+		size = roundup_pow_of_two(params->nelem_hint * 4 / 3);
+	size = max(size, params->min_size);
+	if (params->max_size)
+		size = min(size, params->max_size);
+
+	return size;
+}
+
+/**
+ * rhashtable_init - initialize a new hash table
+ * @ht:		hash table to be initialized
+ * @params:	configuration parameters
+ *
+ * The key is @params->key_len bytes at @params->key_offset in the
+ * object, the struct rhash_head at @params->head_offset:
+ *
+ *	struct test_obj {
+ *		int			key;
+ *		void *			my_member;
+ *		struct rhash_head	node;
+ *	};
+ *
+ *	struct rhashtable_params params = {
+ *		.head_offset = offsetof(struct test_obj, node),
+ *		.key_offset = offsetof(struct test_obj, key),
+ *		.key_len = sizeof(int),
+ *	};
+ *
+ * @params->max_size and @params->min_size are rounded to powers of two.
+ * Returns 0 or a negative error code.
+ */
+int rhashtable_init(struct rhashtable *ht, struct rhashtable_params *params)
+{
+	struct bucket_table *tbl;
+
+	if (!params->key_len)
+		return -EINVAL;
+
+	memset(ht, 0, sizeof(*ht));
+	mutex_init(&ht->mutex);
+	memcpy(&ht->p, params, sizeof(*params));
+
+	ht->p.min_size = roundup_pow_of_two(max_t(size_t, ht->p.min_size,
+						  HASH_MIN_SIZE));
+	if (ht->p.max_size)
+		ht->p.max_size = rounddown_pow_of_two(max(ht->p.max_size,
+							  ht->p.min_size));
+	if (!ht->p.locks_mul)
+		ht->p.locks_mul = BUCKET_LOCKS_PER_CPU;
+	if (!ht->p.hashfn)
+		ht->p.hashfn = jhash;
+	if (!ht->p.hash_rnd)
+		get_random_bytes(&ht->p.hash_rnd, sizeof(ht->p.hash_rnd));
+
+	tbl = bucket_table_alloc(ht, rounded_hashtable_size(&ht->p));
+	if (!tbl)
+		return -ENOMEM;
+
+	atomic_set(&ht->nelems, 0);
+	RCU_INIT_POINTER(ht->tbl, tbl);
+	INIT_WORK(&ht->run_work, rht_deferred_worker);
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(rhashtable_init);
+
+/**
+ * rhashtable_destroy - destroy hash table
+ * @ht:		the hash table to destroy
+ *
+ * Stops any resize and frees the bucket table.  The objects are left
+ * alone: the caller has to remove or free them, and make sure nobody
+ * inserts or removes concurrently.
+ */
+void rhashtable_destroy(struct rhashtable *ht)
+{
+	mutex_lock(&ht->mutex);
+	ht->being_destroyed = true;
+	mutex_unlock(&ht->mutex);
+
+	cancel_work_sync(&ht->run_work);
+
+	mutex_lock(&ht->mutex);
+	bucket_table_free(rht_dereference(ht->tbl, ht));
+	mutex_unlock(&ht->mutex);
+}
+EXPORT_SYMBOL_GPL(rhashtable_destroy);
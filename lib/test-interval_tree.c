@@ -0,0 +1,173 @@
+/*
+ * Interval tree self-test and benchmark
+ *
+ * Inserts random intervals, checks every overlap query against a linear
+ * scan of the same intervals, then times insertion and removal, and the
+ * queries for random points.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/init.h>
+#include <linux/interval_tree.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/random.h>
+#include <linux/sched.h>
+#include <linux/vmalloc.h>
+
+static int nodes = 100;
+module_param(nodes, int, 0);
+MODULE_PARM_DESC(nodes, "Number of intervals in the tree (default: 100)");
+
+static int perf_loops = 100000;
+module_param(perf_loops, int, 0);
+MODULE_PARM_DESC(perf_loops, "Insert/remove rounds to time (default: 100000)");
+
+static int search_loops = 100;
+module_param(search_loops, int, 0);
+MODULE_PARM_DESC(search_loops, "Query rounds per query point (default: 100)");
+
+static int max_endpoint = 1000;
+module_param(max_endpoint, int, 0);
+MODULE_PARM_DESC(max_endpoint, "Largest interval endpoint (default: 1000)");
+
+#define NR_QUERIES 1000
+
+static struct rb_root root = RB_ROOT;
+static struct interval_tree_node *intervals;
+static unsigned long *queries;
+
+static void __init init_intervals(void)
+{
+	int i;
+
+	for (i = 0; i < nodes; i++) {
+		unsigned long a = random32() % max_endpoint;
+		unsigned long b = random32() % max_endpoint;
+
+		intervals[i].start = min(a, b);
+		intervals[i].last = max(a, b);
+	}
+	for (i = 0; i < NR_QUERIES; i++)
+		queries[i] = random32() % max_endpoint;
+}
+
+static unsigned long __init search(unsigned long start, unsigned long last)
+{
+	struct interval_tree_node *node;
+	unsigned long results = 0;
+
+	for (node = interval_tree_iter_first(&root, start, last); node;
+	     node = interval_tree_iter_next(node, start, last))
+		results++;
+	return results;
+}
+
+/* Check the queries against intervals[0..nr), the ones in the tree */
+static int __init check(int nr)
+{
+	unsigned long start, last, expected;
+	int i, j;
+
+	for (i = 0; i < NR_QUERIES; i++) {
+		start = queries[i];
+		last = queries[(i + 1) % NR_QUERIES];
+		if (start > last)
+			swap(start, last);
+
+		expected = 0;
+		for (j = 0; j < nr; j++)
+			if (intervals[j].start <= last &&
+			    start <= intervals[j].last)
+				expected++;
+
+		if (search(start, last) != expected) {
+			pr_warn("query [%lu, %lu]: found %lu intervals, expected %lu\n",
+				start, last, search(start, last), expected);
+			return -EINVAL;
+		}
+	}
+	return 0;
+}
+
+static int __init test_interval_tree_init(void)
+{
+	unsigned long results;
+	ktime_t start;
+	int i, j, err = -ENOMEM;
+
+	intervals = vmalloc(nodes * sizeof(*intervals));
+	queries = vmalloc(NR_QUERIES * sizeof(*queries));
+	if (!intervals || !queries)
+		goto out;
+
+	init_intervals();
+
+	for (i = 0; i < nodes; i++) {
+		interval_tree_insert(&intervals[i], &root);
+		if (i % 16 == 0 || i == nodes - 1) {
+			err = check(i + 1);
+			if (err)
+				goto out;
+		}
+	}
+	while (i--) {
+		interval_tree_remove(&intervals[i], &root);
+		if (i % 16 == 0) {
+			err = check(i);
+			if (err)
+				goto out;
+		}
+	}
+
+	start = ktime_get();
+	for (i = 0; i < perf_loops; i++) {
+		for (j = 0; j < nodes; j++)
+			interval_tree_insert(&intervals[j], &root);
+		for (j = 0; j < nodes; j++)
+			interval_tree_remove(&intervals[j], &root);
+		cond_resched();
+	}
+	pr_info("%d nodes: %lld ns per insert + remove\n", nodes,
+		div64_s64(ktime_to_ns(ktime_sub(ktime_get(), start)),
+			  (s64)perf_loops * nodes));
+
+	for (j = 0; j < nodes; j++)
+		interval_tree_insert(&intervals[j], &root);
+
+	results = 0;
+	start = ktime_get();
+	for (i = 0; i < search_loops; i++) {
+		for (j = 0; j < NR_QUERIES; j++)
+			results += search(queries[j], queries[j]);
+		cond_resched();
+	}
+	pr_info("%d nodes: %lld ns per point query, %lu results per query\n",
+		nodes,
+		div64_s64(ktime_to_ns(ktime_sub(ktime_get(), start)),
+			  (s64)search_loops * NR_QUERIES),
+		results / search_loops / NR_QUERIES);
+
+	for (j = 0; j < nodes; j++)
+		interval_tree_remove(&intervals[j], &root);
+	err = 0;
+out:
+	vfree(queries);
+	vfree(intervals);
+	return err;
+}
+
+static void __exit test_interval_tree_exit(void)
+{
+}
+
+module_init(test_interval_tree_init);
+module_exit(test_interval_tree_exit);
+
+MODULE_LICENSE("GPL v2");
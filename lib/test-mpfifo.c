@@ -0,0 +1,220 @@
+/*
+ * Multi-producer fifo self-test and contention benchmark
+ *
+ * Starts a number of producer threads which each put a run of numbered
+ * elements into one fifo, while a consumer thread drains it in batches
+ * and checks that every producer's elements come out complete and in
+ * order.  This is done first with an mpfifo and then, for comparison,
+ * with a kfifo whose producers serialize on a spinlock.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/cpumask.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/kfifo.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/mpfifo.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/spinlock.h>
+#include <linux/vmalloc.h>
+
+#include "test-threads.h"
+
+static int size = 1024;
+module_param(size, int, 0);
+MODULE_PARM_DESC(size, "Number of elements in the fifo (default: 1024)");
+
+static int threads;
+module_param(threads, int, 0);
+MODULE_PARM_DESC(threads, "Number of producer threads (default: number of online cpus)");
+
+static int loops = 1000000;
+module_param(loops, int, 0);
+MODULE_PARM_DESC(loops, "Elements put by each producer (default: 1000000)");
+
+static int batch = 32;
+module_param(batch, int, 0);
+MODULE_PARM_DESC(batch, "Elements taken out at once by the consumer (default: 32)");
+
+static DECLARE_MPFIFO_PTR(mpfifo, u64);
+static DECLARE_KFIFO_PTR(kfifo, u64);
+static DEFINE_SPINLOCK(kfifo_lock);
+
+/* consumer state: batch buffer, next sequence number per producer */
+static u64 *buf;
+static u32 *next;
+static s64 consume_time;
+static bool consumer_failed;
+
+static unsigned int mpfifo_put_one(u64 *val)
+{
+	return mpfifo_put(&mpfifo, val);
+}
+
+static unsigned int mpfifo_get_batch(u64 *buf, unsigned int n)
+{
+	return mpfifo_out(&mpfifo, buf, n);
+}
+
+static unsigned int kfifo_put_one(u64 *val)
+{
+	return kfifo_in_spinlocked(&kfifo, val, 1, &kfifo_lock);
+}
+
+static unsigned int kfifo_get_batch(u64 *buf, unsigned int n)
+{
+	/* a single reader needs no lock against the writers */
+	return kfifo_out(&kfifo, buf, n);
+}
+
+static unsigned int (*put_one)(u64 *val);
+static unsigned int (*get_batch)(u64 *buf, unsigned int n);
+
+static void produce(u64 id)
+{
+	u64 val;
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		val = (id << 32) | i;
+		while (!put_one(&val)) {
+			if (ACCESS_ONCE(consumer_failed))
+				return;
+			cond_resched();
+		}
+		if (!(i & 1023))
+			cond_resched();
+	}
+}
+
+static int consume(void)
+{
+	u64 total = (u64)threads * loops, done = 0;
+	unsigned int n, i;
+
+	while (done < total) {
+		n = get_batch(buf, batch);
+		if (!n) {
+			cond_resched();
+			continue;
+		}
+		for (i = 0; i < n; i++) {
+			u32 id = buf[i] >> 32, seq = (u32)buf[i];
+
+			if (id >= threads || seq != next[id]) {
+				pr_warn("got element %u of thread %u, expected %u\n",
+					seq, id, id < threads ? next[id] : 0);
+				ACCESS_ONCE(consumer_failed) = true;
+				return -EINVAL;
+			}
+			next[id]++;
+		}
+		done += n;
+	}
+	return 0;
+}
+
+/* ids 0 .. threads - 1 are producers, the last one is the consumer */
+static int threadfunc(void *data)
+{
+	int id = *(int *)data;
+	ktime_t start;
+	int err;
+
+	if (id < threads) {
+		produce(id);
+		return 0;
+	}
+
+	start = ktime_get();
+	err = consume();
+	consume_time = ktime_to_ns(ktime_sub(ktime_get(), start));
+	return err;
+}
+
+static int __init run_test(const char *name, int *ids)
+{
+	int err;
+
+	memset(next, 0, threads * sizeof(*next));
+	consumer_failed = false;
+
+	err = test_run_threads("mpfifo", threads + 1, threadfunc, ids,
+			       sizeof(*ids));
+	if (err < 0) {
+		pr_warn("%s: test failed: %d\n", name, err);
+		return err;
+	}
+	if (loops > 0)
+		pr_info("%s: %d producers, %lld ns per element\n",
+			name, threads,
+			div64_s64(consume_time, (s64)threads * loops));
+	return 0;
+}
+
+static int __init test_mpfifo_init(void)
+{
+	int *ids;
+	int i, err;
+
+	if (threads <= 0)
+		threads = num_online_cpus();
+	batch = clamp(batch, 1, size);
+
+	ids = vzalloc((threads + 1) * sizeof(*ids));
+	next = vzalloc(threads * sizeof(*next));
+	buf = kcalloc(batch, sizeof(*buf), GFP_KERNEL);
+	if (!ids || !next || !buf) {
+		err = -ENOMEM;
+		goto out_free;
+	}
+	for (i = 0; i <= threads; i++)
+		ids[i] = i;
+
+	err = mpfifo_alloc(&mpfifo, size, GFP_KERNEL);
+	if (err)
+		goto out_free;
+	err = kfifo_alloc(&kfifo, size, GFP_KERNEL);
+	if (err)
+		goto out_mpfifo;
+
+	pr_info("%u elements, %d producers putting %d each, batches of %d\n",
+		mpfifo_size(&mpfifo), threads, loops, batch);
+
+	put_one = mpfifo_put_one;
+	get_batch = mpfifo_get_batch;
+	err = run_test("mpfifo", ids);
+	if (err)
+		goto out_kfifo;
+
+	put_one = kfifo_put_one;
+	get_batch = kfifo_get_batch;
+	err = run_test("kfifo + spinlock", ids);
+
+out_kfifo:
+	kfifo_free(&kfifo);
+out_mpfifo:
+	mpfifo_free(&mpfifo);
+out_free:
+	kfree(buf);
+	vfree(next);
+	vfree(ids);
+	return err;
+}
+
+static void __exit test_mpfifo_exit(void)
+{
+}
+
+module_init(test_mpfifo_init);
+module_exit(test_mpfifo_exit);
+
+MODULE_LICENSE("GPL v2");
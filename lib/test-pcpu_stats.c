@@ -0,0 +1,200 @@
+/*
+ * Per-cpu statistics self-test and benchmark
+ *
+ * Starts a thread on every online cpu which counts packets and bytes,
+ * first in a per-cpu statistics group and then, for comparison, in
+ * shared atomic64_t counters.  While the threads run, the loading
+ * thread keeps folding the group and checks that the sums never go
+ * backwards; at the end they must be exact.  The time per update is
+ * reported for both, and the time per fold.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/atomic.h>
+#include <linux/cpumask.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/kthread.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/pcpu_stats.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+
+static int loops = 1000000;
+module_param(loops, int, 0);
+MODULE_PARM_DESC(loops, "Updates done by each thread (default: 1000000)");
+
+#define TEST_LEN	1500
+
+struct test_stats {
+	u64			packets;
+	u64			bytes;
+	struct u64_stats_sync	syncp;
+};
+
+static struct test_stats __percpu *stats;
+static atomic64_t shared_packets, shared_bytes;
+static bool use_atomic;
+
+static atomic_t running;
+
+static int threadfunc(void *data)
+{
+	struct test_stats *s;
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		if (use_atomic) {
+			atomic64_inc(&shared_packets);
+			atomic64_add(TEST_LEN, &shared_bytes);
+		} else {
+			preempt_disable();
+			s = pcpu_stats_update_begin(stats);
+			s->packets++;
+			s->bytes += TEST_LEN;
+			pcpu_stats_update_end(s);
+			preempt_enable();
+		}
+		if (!(i & 1023))
+			cond_resched();
+	}
+
+	atomic_dec(&running);
+	return 0;
+}
+
+static int __init check_folds(u64 *nfolds)
+{
+	struct test_stats sum, last = { 0 };
+
+	*nfolds = 0;
+	do {
+		pcpu_stats_fold(stats, &sum);
+		(*nfolds)++;
+		if (sum.packets < last.packets || sum.bytes < last.bytes) {
+			pr_warn("sums went backwards: %llu/%llu after %llu/%llu\n",
+				sum.packets, sum.bytes,
+				last.packets, last.bytes);
+			return -EINVAL;
+		}
+		last = sum;
+		cond_resched();
+	} while (atomic_read(&running));
+	return 0;
+}
+
+static int __init run_test(const char *name, struct task_struct **tasks)
+{
+	u64 total, packets, bytes, nfolds = 0;
+	struct test_stats sum;
+	ktime_t start;
+	s64 time;
+	int cpu, err = 0, started = 0;
+
+	/*
+	 * A new kthread sleeps until it is first woken up, so create and
+	 * bind them all before letting any of them go.  The threads exit
+	 * when done; hold on to them for kthread_stop().
+	 */
+	for_each_online_cpu(cpu) {
+		tasks[cpu] = kthread_create(threadfunc, NULL,
+					    "pcpu_stats/%d", cpu);
+		if (IS_ERR(tasks[cpu])) {
+			pr_err("kthread_create failed for cpu %d\n", cpu);
+			continue;
+		}
+		get_task_struct(tasks[cpu]);
+		kthread_bind(tasks[cpu], cpu);
+		started++;
+	}
+
+	atomic_set(&running, started);
+	start = ktime_get();
+	for_each_online_cpu(cpu)
+		if (!IS_ERR(tasks[cpu]))
+			wake_up_process(tasks[cpu]);
+
+	if (!use_atomic)
+		err = check_folds(&nfolds);
+	while (atomic_read(&running))
+		schedule_timeout_uninterruptible(1);
+	time = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+	for_each_online_cpu(cpu) {
+		if (IS_ERR(tasks[cpu]))
+			continue;
+		kthread_stop(tasks[cpu]);
+		put_task_struct(tasks[cpu]);
+	}
+
+	if (err)
+		return err;
+
+	total = (u64)started * loops;
+	if (use_atomic) {
+		packets = atomic64_read(&shared_packets);
+		bytes = atomic64_read(&shared_bytes);
+	} else {
+		pcpu_stats_fold(stats, &sum);
+		packets = sum.packets;
+		bytes = sum.bytes;
+	}
+	if (packets != total || bytes != total * TEST_LEN) {
+		pr_warn("%s: counted %llu/%llu, expected %llu/%llu\n", name,
+			packets, bytes, total, total * TEST_LEN);
+		return -EINVAL;
+	}
+
+	if (started)
+		pr_info("%s: %d threads, %lld ns per update\n", name, started,
+			div_s64(time, (s64)loops));
+	if (nfolds)
+		pr_info("%s: %llu folds, %lld ns per fold\n", name, nfolds,
+			div64_s64(time, nfolds));
+	return 0;
+}
+
+static int __init test_pcpu_stats_init(void)
+{
+	struct task_struct **tasks;
+	int err;
+
+	tasks = kcalloc(nr_cpu_ids, sizeof(*tasks), GFP_KERNEL);
+	stats = pcpu_stats_alloc(struct test_stats);
+	if (!tasks || !stats) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	pr_info("%d updates by each of %d threads\n", loops,
+		num_online_cpus());
+
+	get_online_cpus();
+	use_atomic = false;
+	err = run_test("pcpu_stats", tasks);
+	if (!err) {
+		use_atomic = true;
+		err = run_test("atomic64", tasks);
+	}
+	put_online_cpus();
+
+out:
+	pcpu_stats_free(stats);
+	kfree(tasks);
+	return err;
+}
+
+static void __exit test_pcpu_stats_exit(void)
+{
+}
+
+module_init(test_pcpu_stats_init);
+module_exit(test_pcpu_stats_exit);
+
+MODULE_LICENSE("GPL v2");
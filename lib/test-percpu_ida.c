@@ -0,0 +1,213 @@
+/*
+ * Percpu IDA self-test and contention benchmark
+ *
+ * Starts a number of threads that each repeatedly allocate a handful of
+ * tags and free them again, first with percpu_ida and then, for
+ * comparison, with an ida under a spinlock, which is what a tag
+ * allocator built on lib/idr.c has to do.  Every tag handed out is
+ * marked in a shared bitmap, so that a tag given to two threads at once
+ * is caught.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/bitops.h>
+#include <linux/cpumask.h>
+#include <linux/idr.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/percpu_ida.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/spinlock.h>
+#include <linux/vmalloc.h>
+
+#include "test-threads.h"
+
+static int nr_tags = 1024;
+module_param(nr_tags, int, 0);
+MODULE_PARM_DESC(nr_tags, "Number of tags in the pool (default: 1024)");
+
+static int threads;
+module_param(threads, int, 0);
+MODULE_PARM_DESC(threads, "Number of threads (default: number of online cpus)");
+
+static int loops = 100000;
+module_param(loops, int, 0);
+MODULE_PARM_DESC(loops, "Allocate/free rounds per thread (default: 100000)");
+
+static int depth = 8;
+module_param(depth, int, 0);
+MODULE_PARM_DESC(depth, "Tags held by a thread at once (default: 8)");
+
+struct thread_data {
+	int			*tags;
+	s64			time;
+};
+
+static struct percpu_ida pool;
+static DEFINE_SPINLOCK(ida_lock);
+static DEFINE_IDA(ida);
+static unsigned long *in_use;
+
+static int mark_tag(int tag)
+{
+	if (tag < 0 || tag >= nr_tags) {
+		pr_warn("bad tag %d\n", tag);
+		return -ERANGE;
+	}
+	if (test_and_set_bit(tag, in_use)) {
+		pr_warn("tag %d handed out twice\n", tag);
+		return -EEXIST;
+	}
+	return 0;
+}
+
+static int pcpu_ida_get(void)
+{
+	return percpu_ida_alloc(&pool, GFP_KERNEL);
+}
+
+static void pcpu_ida_put(int tag)
+{
+	percpu_ida_free(&pool, tag);
+}
+
+static int locked_ida_get(void)
+{
+	int tag, err;
+
+	do {
+		if (!ida_pre_get(&ida, GFP_KERNEL))
+			return -ENOMEM;
+		spin_lock(&ida_lock);
+		err = ida_get_new(&ida, &tag);
+		spin_unlock(&ida_lock);
+	} while (err == -EAGAIN);
+
+	return err ? err : tag;
+}
+
+static void locked_ida_put(int tag)
+{
+	spin_lock(&ida_lock);
+	ida_remove(&ida, tag);
+	spin_unlock(&ida_lock);
+}
+
+static int (*get_tag)(void);
+static void (*put_tag)(int tag);
+
+static int threadfunc(void *data)
+{
+	struct thread_data *tdata = data;
+	ktime_t start;
+	int i, j, err = 0;
+
+	start = ktime_get();
+	for (i = 0; i < loops && !err; i++) {
+		for (j = 0; j < depth; j++) {
+			tdata->tags[j] = get_tag();
+			err = mark_tag(tdata->tags[j]);
+			if (err)
+				break;
+		}
+		while (j--) {
+			clear_bit(tdata->tags[j], in_use);
+			put_tag(tdata->tags[j]);
+		}
+		cond_resched();
+	}
+	tdata->time = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+	return err;
+}
+
+static int __init run_test(const char *name, struct thread_data *tdata)
+{
+	s64 total = 0;
+	int i, started;
+
+	started = test_run_threads("percpu_ida", threads, threadfunc, tdata,
+				   sizeof(*tdata));
+	if (started < 0) {
+		pr_warn("%s: test failed: %d\n", name, started);
+		return started;
+	}
+
+	for (i = 0; i < started; i++)
+		total += tdata[i].time;
+	if (started && loops > 0)
+		pr_info("%s: %d threads, %lld ns per allocate + free\n",
+			name, started,
+			div64_s64(total, (s64)started * loops * depth));
+	return 0;
+}
+
+static int __init test_percpu_ida_init(void)
+{
+	struct thread_data *tdata;
+	int i, err;
+
+	if (threads <= 0)
+		threads = num_online_cpus();
+	depth = clamp(depth, 1, 1024);
+	/* leave room for the tags cached on cpus that don't steal */
+	nr_tags = max(nr_tags, 2 * threads * depth);
+
+	tdata = vzalloc(threads * sizeof(*tdata));
+	in_use = vzalloc(BITS_TO_LONGS(nr_tags) * sizeof(long));
+	if (!tdata || !in_use) {
+		err = -ENOMEM;
+		goto out_free;
+	}
+	for (i = 0; i < threads; i++) {
+		tdata[i].tags = kcalloc(depth, sizeof(int), GFP_KERNEL);
+		if (!tdata[i].tags) {
+			err = -ENOMEM;
+			goto out_free;
+		}
+	}
+
+	err = percpu_ida_init(&pool, nr_tags);
+	if (err)
+		goto out_free;
+
+	pr_info("%d tags, %d threads holding %d tags each, %d rounds\n",
+		nr_tags, threads, depth, loops);
+
+	get_tag = pcpu_ida_get;
+	put_tag = pcpu_ida_put;
+	err = run_test("percpu_ida", tdata);
+	percpu_ida_destroy(&pool);
+	if (err)
+		goto out_free;
+
+	get_tag = locked_ida_get;
+	put_tag = locked_ida_put;
+	err = run_test("ida + spinlock", tdata);
+	ida_destroy(&ida);
+
+out_free:
+	if (tdata)
+		for (i = 0; i < threads; i++)
+			kfree(tdata[i].tags);
+	vfree(in_use);
+	vfree(tdata);
+	return err;
+}
+
+static void __exit test_percpu_ida_exit(void)
+{
+}
+
+module_init(test_percpu_ida_init);
+module_exit(test_percpu_ida_exit);
+
+MODULE_LICENSE("GPL v2");
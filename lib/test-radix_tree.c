@@ -0,0 +1,290 @@
+/*
+ * Radix tree self-test
+ *
+ * Runs random inserts of multi-order items, deletes, lookups, tag
+ * operations, gang lookups and range tagging on a tree, and checks every
+ * result against a flat array that records which item covers each index.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/radix-tree.h>
+#include <linux/random.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/vmalloc.h>
+
+static int steps = 100000;
+module_param(steps, int, 0);
+MODULE_PARM_DESC(steps, "Random operations to run (default: 100000)");
+
+#define NR_INDICES	4096
+#define GANG_MAX	32
+
+struct test_item {
+	unsigned long index;
+	unsigned int order;
+	unsigned long tags;
+};
+
+static RADIX_TREE(tree, GFP_KERNEL);
+/* the item covering each index, or NULL */
+static struct test_item **owner;
+static void *results[GANG_MAX];
+
+static const unsigned int orders[] = { 0, 0, 0, 1, 2, 3, 5, 6, 7, 9 };
+
+static inline unsigned long item_last(struct test_item *item)
+{
+	return item->index + (1UL << item->order) - 1;
+}
+
+static void __init model_set(struct test_item *item, struct test_item *val)
+{
+	unsigned long i;
+
+	for (i = item->index; i <= item_last(item); i++)
+		owner[i] = val;
+}
+
+static int __init test_insert(void)
+{
+	unsigned int order = orders[random32() % ARRAY_SIZE(orders)];
+	unsigned long index = (random32() % NR_INDICES) & ~((1UL << order) - 1);
+	struct test_item *item;
+	bool busy = false;
+	unsigned long i;
+	int err;
+
+	if (index + (1UL << order) > NR_INDICES)
+		return 0;
+	for (i = index; i < index + (1UL << order); i++)
+		if (owner[i])
+			busy = true;
+
+	item = kzalloc(sizeof(*item), GFP_KERNEL);
+	if (!item)
+		return -ENOMEM;
+	item->index = index;
+	item->order = order;
+
+	err = radix_tree_insert_order(&tree, index, order, item);
+	if (err == -ENOMEM) {
+		kfree(item);
+		return err;
+	}
+	if (busy ? err != -EEXIST : err) {
+		pr_err("insert at %lu order %u returned %d\n", index, order, err);
+		kfree(item);
+		return -EINVAL;
+	}
+	if (err)
+		kfree(item);
+	else
+		model_set(item, item);
+	return 0;
+}
+
+static int __init test_delete(unsigned long index)
+{
+	struct test_item *item = owner[index];
+	void *ret = radix_tree_delete(&tree, index);
+
+	if (ret != item) {
+		pr_err("delete at %lu returned %p, expected %p\n", index, ret,
+		       item);
+		return -EINVAL;
+	}
+	if (item) {
+		model_set(item, NULL);
+		kfree(item);
+	}
+	return 0;
+}
+
+static int __init test_lookup(unsigned long index)
+{
+	void **slot = radix_tree_lookup_slot(&tree, index);
+
+	if (radix_tree_lookup(&tree, index) != owner[index] ||
+	    (slot ? *slot : NULL) != owner[index]) {
+		pr_err("lookup at %lu went wrong\n", index);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+static int __init test_tag(unsigned long index, unsigned int tag)
+{
+	struct test_item *item = owner[index];
+	void *ret;
+
+	if (!item)
+		return 0;
+
+	if (random32() & 1) {
+		ret = radix_tree_tag_set(&tree, index, tag);
+		item->tags |= 1UL << tag;
+	} else {
+		ret = radix_tree_tag_clear(&tree, index, tag);
+		item->tags &= ~(1UL << tag);
+	}
+	if (ret != item) {
+		pr_err("tagging %lu returned %p, expected %p\n", index, ret,
+		       item);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+static int __init test_tag_get(unsigned long index, unsigned int tag)
+{
+	struct test_item *item = owner[index];
+	int expected = item ? !!(item->tags & (1UL << tag)) : 0;
+
+	if (radix_tree_tag_get(&tree, index, tag) != expected) {
+		pr_err("tag %u at %lu is not %d\n", tag, index, expected);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+/* An item is found once, even when @start is in the middle of it. */
+static int __init test_gang(unsigned long start, int tag)
+{
+	unsigned int max = 1 + random32() % GANG_MAX;
+	unsigned int nr, expected = 0;
+	unsigned long index = start;
+	struct test_item *item;
+
+	if (tag < 0)
+		nr = radix_tree_gang_lookup(&tree, results, start, max);
+	else
+		nr = radix_tree_gang_lookup_tag(&tree, results, start, max,
+						tag);
+
+	while (index < NR_INDICES && expected < max) {
+		item = owner[index];
+		if (!item) {
+			index++;
+			continue;
+		}
+		index = item_last(item) + 1;
+		if (tag >= 0 && !(item->tags & (1UL << tag)))
+			continue;
+		if (expected >= nr || results[expected] != item)
+			goto fail;
+		expected++;
+	}
+	if (nr == expected)
+		return 0;
+fail:
+	pr_err("gang lookup from %lu, tag %d: item %u of %u is wrong\n",
+	       start, tag, expected, nr);
+	return -EINVAL;
+}
+
+/*
+ * Tag 0 is copied to tag 2 for every item that overlaps the range, even
+ * if it starts before @first.
+ */
+static int __init test_range_tag(unsigned long first)
+{
+	unsigned long last = min(first + random32() % 600, NR_INDICES - 1UL);
+	unsigned long index = first, expected = 0, tagged;
+	struct test_item *item;
+
+	tagged = radix_tree_range_tag_if_tagged(&tree, &index, last, ULONG_MAX,
+						0, 2);
+	for (index = first; index <= last; index++) {
+		item = owner[index];
+		if (!item)
+			continue;
+		index = item_last(item);
+		if (!(item->tags & 1))
+			continue;
+		item->tags |= 1UL << 2;
+		expected++;
+		if (!radix_tree_tag_get(&tree, item->index, 2))
+			goto fail;
+	}
+	if (tagged == expected)
+		return 0;
+fail:
+	pr_err("tagging range %lu-%lu went wrong\n", first, last);
+	return -EINVAL;
+}
+
+static int __init run_step(void)
+{
+	unsigned long index = random32() % NR_INDICES;
+	unsigned int tag = random32() % RADIX_TREE_MAX_TAGS;
+
+	switch (random32() % 10) {
+	case 0: case 1: case 2:
+		return test_insert();
+	case 3:
+		return test_delete(index);
+	case 4:
+		return test_lookup(index);
+	case 5:
+		return test_tag(index, tag);
+	case 6:
+		return test_tag_get(index, tag);
+	case 7:
+		return test_gang(index, -1);
+	case 8:
+		return test_gang(index, tag);
+	default:
+		return test_range_tag(index);
+	}
+}
+
+static int __init test_radix_tree_init(void)
+{
+	unsigned long index;
+	int i, err = 0;
+
+	owner = vzalloc(NR_INDICES * sizeof(*owner));
+	if (!owner)
+		return -ENOMEM;
+
+	for (i = 0; i < steps && !err; i++) {
+		err = run_step();
+		if (!(i & 1023))
+			cond_resched();
+	}
+
+	/* Deleting every index must leave an empty tree behind. */
+	for (index = 0; index < NR_INDICES; index++) {
+		int ret = test_delete(index);
+
+		if (!err)
+			err = ret;
+	}
+	if (!err && tree.rnode) {
+		pr_err("tree not empty after deleting everything\n");
+		err = -EINVAL;
+	}
+
+	if (!err)
+		pr_info("%d operations passed\n", steps);
+	vfree(owner);
+	return err;
+}
+
+static void __exit test_radix_tree_exit(void)
+{
+}
+
+module_init(test_radix_tree_init);
+module_exit(test_radix_tree_exit);
+
+MODULE_LICENSE("GPL v2");
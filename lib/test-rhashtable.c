@@ -0,0 +1,290 @@
+/*
+ * Resizable, RCU protected hash table self-test and benchmark
+ *
+ * Inserts, looks up and removes the entries on a table that starts
+ * small, timing each pass and checking that the table grew and shrank
+ * back; then does the same from several threads at once, on separate
+ * key ranges, so that the resizes run concurrently with all three.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/init.h>
+#include <linux/jhash.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/rcupdate.h>
+#include <linux/rhashtable.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/vmalloc.h>
+
+#include "test-threads.h"
+
+static int entries = 50000;
+module_param(entries, int, 0);
+MODULE_PARM_DESC(entries, "Number of entries to add (default: 50000)");
+
+static int runs = 4;
+module_param(runs, int, 0);
+MODULE_PARM_DESC(runs, "Number of test runs (default: 4)");
+
+static int tcount = 8;
+module_param(tcount, int, 0);
+MODULE_PARM_DESC(tcount, "Number of threads in the concurrent test (default: 8)");
+
+struct test_obj {
+	int			value;
+	struct rhash_head	node;
+};
+
+struct thread_data {
+	int			id;
+	struct test_obj		*objs;
+};
+
+static struct rhashtable ht;
+
+static struct rhashtable_params test_params = {
+	.nelem_hint	= 8,
+	.head_offset	= offsetof(struct test_obj, node),
+	.key_offset	= offsetof(struct test_obj, value),
+	.key_len	= sizeof(int),
+	.hashfn		= jhash,
+};
+
+static int test_lookup_range(struct rhashtable *ht, int first, int count,
+			     bool present)
+{
+	struct test_obj *obj;
+	int key;
+
+	for (key = first; key < first + count; key++) {
+		rcu_read_lock();
+		obj = rhashtable_lookup(ht, &key);
+		if (present && (!obj || obj->value != key)) {
+			rcu_read_unlock();
+			pr_warn("key %d not found\n", key);
+			return -ENOENT;
+		}
+		if (!present && obj) {
+			rcu_read_unlock();
+			pr_warn("removed key %d found\n", key);
+			return -EEXIST;
+		}
+		rcu_read_unlock();
+	}
+
+	return 0;
+}
+
+static size_t __init test_count_entries(struct rhashtable *ht, size_t *size)
+{
+	struct bucket_table *tbl;
+	struct test_obj *obj;
+	struct rhash_head *pos;
+	size_t count = 0;
+	unsigned int i;
+
+	rcu_read_lock();
+	tbl = rht_dereference_rcu(ht->tbl, ht);
+	for (i = 0; i < tbl->size; i++)
+		rht_for_each_entry_rcu(obj, pos, tbl, i, node)
+			count++;
+	*size = tbl->size;
+	rcu_read_unlock();
+
+	return count;
+}
+
+static s64 __init test_rhashtable(struct rhashtable *ht,
+				  struct test_obj *objs)
+{
+	ktime_t start, end;
+	size_t count, size;
+	s64 ins, look, rem;
+	int i, err;
+
+	start = ktime_get();
+	for (i = 0; i < entries; i++) {
+		objs[i].value = i;
+		rhashtable_insert(ht, &objs[i].node);
+	}
+	end = ktime_get();
+	ins = ktime_to_ns(ktime_sub(end, start));
+
+	/* let the resizes finish */
+	flush_work(&ht->run_work);
+
+	start = ktime_get();
+	err = test_lookup_range(ht, 0, entries, true);
+	end = ktime_get();
+	if (err)
+		return err;
+	look = ktime_to_ns(ktime_sub(end, start));
+
+	err = test_lookup_range(ht, entries, entries, false);
+	if (err)
+		return err;
+
+	count = test_count_entries(ht, &size);
+	if (count != entries || count > size / 4 * 3) {
+		pr_warn("%zu entries, %zu buckets after inserting %d\n",
+			count, size, entries);
+		return -EINVAL;
+	}
+
+	start = ktime_get();
+	for (i = 0; i < entries; i++) {
+		if (!rhashtable_remove(ht, &objs[i].node)) {
+			pr_warn("key %d not removed\n", i);
+			return -ENOENT;
+		}
+	}
+	end = ktime_get();
+	rem = ktime_to_ns(ktime_sub(end, start));
+
+	err = test_lookup_range(ht, 0, entries, false);
+	if (err)
+		return err;
+
+	flush_work(&ht->run_work);
+
+	count = test_count_entries(ht, &size);
+	if (count || size != ht->p.min_size) {
+		pr_warn("%zu entries, %zu buckets after removing all\n",
+			count, size);
+		return -EINVAL;
+	}
+
+	pr_info("  %d entries: insert %lld ns, lookup %lld ns, remove %lld ns per entry\n",
+		entries, div_s64(ins, entries), div_s64(look, entries),
+		div_s64(rem, entries));
+
+	return ins + look + rem;
+}
+
+static int threadfunc(void *data)
+{
+	struct thread_data *tdata = data;
+	int first = tdata->id * entries;
+	int i, step, err = 0;
+
+	for (step = 0; step < runs; step++) {
+		for (i = 0; i < entries; i++) {
+			tdata->objs[i].value = first + i;
+			rhashtable_insert(&ht, &tdata->objs[i].node);
+		}
+
+		err = test_lookup_range(&ht, first, entries, true);
+		if (err)
+			break;
+
+		for (i = 0; i < entries; i++) {
+			if (!rhashtable_remove(&ht, &tdata->objs[i].node)) {
+				pr_warn("thread %d: key %d not removed\n",
+					tdata->id, first + i);
+				return -ENOENT;
+			}
+		}
+
+		err = test_lookup_range(&ht, first, entries, false);
+		if (err)
+			break;
+
+		/* the objects are reused, wait for the lookups to let go */
+		synchronize_rcu();
+	}
+
+	return err;
+}
+
+static int __init test_rht_init(void)
+{
+	struct thread_data *tdata;
+	struct test_obj *objs;
+	s64 total = 0, time;
+	int i, err = 0;
+
+	if (entries <= 0 || runs <= 0)
+		return -EINVAL;
+	entries = min(entries, INT_MAX / max(tcount, 1) - 1);
+
+	objs = vzalloc(entries * sizeof(*objs));
+	if (!objs)
+		return -ENOMEM;
+
+	pr_info("running %d test runs of %d entries\n", runs, entries);
+
+	for (i = 0; i < runs; i++) {
+		err = rhashtable_init(&ht, &test_params);
+		if (err)
+			break;
+
+		time = test_rhashtable(&ht, objs);
+		rhashtable_destroy(&ht);
+		if (time < 0) {
+			err = time;
+			break;
+		}
+		total += time;
+	}
+
+	vfree(objs);
+	if (err) {
+		pr_warn("test failed: %d\n", err);
+		return err;
+	}
+	pr_info("average test time: %lld ns\n", div_s64(total, runs));
+
+	if (tcount <= 0)
+		return 0;
+
+	tdata = vzalloc(tcount * sizeof(*tdata));
+	objs = vzalloc(tcount * entries * sizeof(*objs));
+	if (!tdata || !objs) {
+		err = -ENOMEM;
+		goto out_free;
+	}
+
+	err = rhashtable_init(&ht, &test_params);
+	if (err)
+		goto out_free;
+
+	pr_info("testing %d concurrent threads\n", tcount);
+
+	for (i = 0; i < tcount; i++) {
+		tdata[i].id = i;
+		tdata[i].objs = objs + i * entries;
+	}
+	err = test_run_threads("rhashtable", tcount, threadfunc, tdata,
+			       sizeof(*tdata));
+
+	rhashtable_destroy(&ht);
+
+	if (err < 0) {
+		pr_warn("concurrent test failed: %d\n", err);
+	} else {
+		pr_info("concurrent test passed with %d threads\n", err);
+		err = 0;
+	}
+
+out_free:
+	vfree(objs);
+	vfree(tdata);
+	return err;
+}
+
+static void __exit test_rht_exit(void)
+{
+}
+
+module_init(test_rht_init);
+module_exit(test_rht_exit);
+
+MODULE_LICENSE("GPL v2");
@@ -0,0 +1,212 @@
+/*
+ * Benchmark for the inlined sort, list_sort and bsearch
+ *
+ * Sorts the same random array with sort() and sort_inline(), looks up
+ * every element with bsearch() and bsearch_inline(), and sorts the same
+ * random list with list_sort() and list_sort_inline(), checking the
+ * results and reporting the number of elements handled per second by
+ * each.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#define pr_fmt(fmt) KBUILD_MODNAME ": " fmt
+
+#include <linux/bsearch.h>
+#include <linux/init.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/list.h>
+#include <linux/list_sort.h>
+#include <linux/module.h>
+#include <linux/random.h>
+#include <linux/sort.h>
+#include <linux/string.h>
+#include <linux/vmalloc.h>
+
+static int nelem = 100000;
+module_param(nelem, int, 0);
+MODULE_PARM_DESC(nelem, "Number of elements (default: 100000)");
+
+static int loops = 10;
+module_param(loops, int, 0);
+MODULE_PARM_DESC(loops, "Number of runs of each test (default: 10)");
+
+struct test_node {
+	struct list_head list;
+	u32 key;
+};
+
+static u32 *orig, *array;
+static struct test_node *nodes;
+
+static int cmp_u32(const void *a, const void *b)
+{
+	u32 x = *(const u32 *)a, y = *(const u32 *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static int cmp_node(void *priv, struct list_head *a, struct list_head *b)
+{
+	u32 x = list_entry(a, struct test_node, list)->key;
+	u32 y = list_entry(b, struct test_node, list)->key;
+
+	return x < y ? -1 : x > y;
+}
+
+static void __init report(const char *name, s64 ns)
+{
+	u64 rate = (u64)nelem * loops * NSEC_PER_SEC;
+
+	rate = div64_u64(rate, max_t(u64, ns, 1));
+	pr_info("%-18s %10llu elements/s\n", name, (unsigned long long)rate);
+}
+
+static int __init check_sorted(const char *name)
+{
+	int i;
+
+	for (i = 1; i < nelem; i++)
+		if (array[i - 1] > array[i]) {
+			pr_warn("%s: element %d out of order\n", name, i);
+			return -EINVAL;
+		}
+	return 0;
+}
+
+static int __init test_sort(bool inl)
+{
+	const char *name = inl ? "sort_inline()" : "sort()";
+	s64 ns = 0;
+	ktime_t start;
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		memcpy(array, orig, nelem * sizeof(*array));
+		start = ktime_get();
+		if (inl)
+			sort_inline(array, nelem, sizeof(*array), cmp_u32, NULL);
+		else
+			sort(array, nelem, sizeof(*array), cmp_u32, NULL);
+		ns += ktime_to_ns(ktime_sub(ktime_get(), start));
+		cond_resched();
+	}
+	report(name, ns);
+	return check_sorted(name);
+}
+
+static int __init test_bsearch(bool inl)
+{
+	const char *name = inl ? "bsearch_inline()" : "bsearch()";
+	ktime_t start;
+	u32 *found;
+	s64 ns;
+	int i, j, err = 0;
+
+	/* array is sorted by the sort tests */
+	start = ktime_get();
+	for (j = 0; j < loops; j++) {
+		for (i = 0; i < nelem; i++) {
+			if (inl)
+				found = bsearch_inline(&orig[i], array, nelem,
+						       sizeof(*array), cmp_u32);
+			else
+				found = bsearch(&orig[i], array, nelem,
+						sizeof(*array), cmp_u32);
+			if (!found || *found != orig[i])
+				err = -EINVAL;
+		}
+		cond_resched();
+	}
+	ns = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+	report(name, ns);
+	if (err)
+		pr_warn("%s: element not found\n", name);
+	return err;
+}
+
+static int __init test_list_sort(bool inl)
+{
+	const char *name = inl ? "list_sort_inline()" : "list_sort()";
+	struct test_node *node;
+	LIST_HEAD(head);
+	s64 ns = 0;
+	ktime_t start;
+	int i;
+
+	for (i = 0; i < loops; i++) {
+		int j;
+
+		INIT_LIST_HEAD(&head);
+		for (j = 0; j < nelem; j++)
+			list_add_tail(&nodes[j].list, &head);
+		start = ktime_get();
+		if (inl)
+			list_sort_inline(NULL, &head, cmp_node);
+		else
+			list_sort(NULL, &head, cmp_node);
+		ns += ktime_to_ns(ktime_sub(ktime_get(), start));
+		cond_resched();
+	}
+	report(name, ns);
+
+	i = 0;
+	list_for_each_entry(node, &head, list)
+		array[i++] = node->key;
+	if (i != nelem) {
+		pr_warn("%s: %d elements on the list\n", name, i);
+		return -EINVAL;
+	}
+	return check_sorted(name);
+}
+
+static int __init test_sort_init(void)
+{
+	int i, err = -ENOMEM;
+
+	if (nelem < 1 || loops < 1)
+		return -EINVAL;
+
+	orig = vmalloc(nelem * sizeof(*orig));
+	array = vmalloc(nelem * sizeof(*array));
+	nodes = vmalloc(nelem * sizeof(*nodes));
+	if (!orig || !array || !nodes)
+		goto out;
+
+	for (i = 0; i < nelem; i++) {
+		orig[i] = random32();
+		nodes[i].key = orig[i];
+	}
+
+	pr_info("%d elements, %d runs\n", nelem, loops);
+
+	err = test_sort(false);
+	if (!err)
+		err = test_sort(true);
+	if (!err)
+		err = test_bsearch(false);
+	if (!err)
+		err = test_bsearch(true);
+	if (!err)
+		err = test_list_sort(false);
+	if (!err)
+		err = test_list_sort(true);
+out:
+	vfree(nodes);
+	vfree(array);
+	vfree(orig);
+	return err;
+}
+
+static void __exit test_sort_exit(void)
+{
+}
+
+module_init(test_sort_init);
+module_exit(test_sort_exit);
+
+MODULE_LICENSE("GPL v2");
@@ -0,0 +1,81 @@
+/*
+ * Start-together thread harness shared by the lib/ self-tests
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/err.h>
+#include <linux/kthread.h>
+#include <linux/module.h>
+#include <linux/sched.h>
+#include <linux/vmalloc.h>
+
+#include "test-threads.h"
+
+struct test_thread {
+	struct task_struct	*task;
+	int			(*fn)(void *);
+	void			*arg;
+	int			err;
+};
+
+static int test_thread_fn(void *data)
+{
+	struct test_thread *t = data;
+
+	t->err = t->fn(t->arg);
+
+	/* stay around until kthread_stop(), which still needs the task */
+	set_current_state(TASK_INTERRUPTIBLE);
+	while (!kthread_should_stop()) {
+		schedule();
+		set_current_state(TASK_INTERRUPTIBLE);
+	}
+	__set_current_state(TASK_RUNNING);
+	return 0;
+}
+
+int test_run_threads(const char *name, int nr, int (*fn)(void *),
+		     void *data, size_t size)
+{
+	struct test_thread *threads;
+	int i, err = 0;
+
+	threads = vzalloc(nr * sizeof(*threads));
+	if (!threads)
+		return -ENOMEM;
+
+	/* a new kthread sleeps until it is first woken up */
+	for (i = 0; i < nr; i++) {
+		threads[i].fn = fn;
+		threads[i].arg = data + i * size;
+		threads[i].task = kthread_create(test_thread_fn, &threads[i],
+						 "%s/%d", name, i);
+		if (IS_ERR(threads[i].task)) {
+			pr_err("%s: kthread_create failed for thread %d\n",
+			       name, i);
+			err = PTR_ERR(threads[i].task);
+			break;
+		}
+	}
+	nr = i;
+
+	if (!err)
+		for (i = 0; i < nr; i++)
+			wake_up_process(threads[i].task);
+
+	/* threads that were never woken are stopped without running fn */
+	for (i = 0; i < nr; i++) {
+		kthread_stop(threads[i].task);
+		if (threads[i].err && !err)
+			err = threads[i].err;
+	}
+
+	vfree(threads);
+	return err ? err : nr;
+}
+EXPORT_SYMBOL_GPL(test_run_threads);
+
+MODULE_LICENSE("GPL v2");
@@ -0,0 +1,9 @@
+#include <linux/types.h>
+
+/*
+ * Runs fn(data + i * size) for i in [0, nr) in kernel threads named
+ * "<name>/<i>" that are all created before any of them starts.  Returns
+ * the number of threads that ran, or the first error one of them returned.
+ */
+extern int test_run_threads(const char *name, int nr, int (*fn)(void *),
+			    void *data, size_t size);
@@ -1524,6 +1524,7 @@ static inline void *acquire_slab(struct kmem_cache *s,
 }
 
 static int put_cpu_partial(struct kmem_cache *s, struct page *page, int drain);
+static void flush_remote_frees(struct kmem_cache *s, struct kmem_cache_cpu *c);
 static inline bool pfmemalloc_match(struct page *page, gfp_t gfpflags);
 
 /*
@@ -1999,6 +2000,9 @@ static inline void __flush_cpu_slab(struct kmem_cache *s, int cpu)
 	struct kmem_cache_cpu *c = per_cpu_ptr(s->cpu_slab, cpu);
 
 	if (likely(c)) {
+		c->remote_count = 0;
+		flush_remote_frees(s, c);
+
 		if (c->page)
 			flush_slab(s, c);
 
@@ -2018,7 +2022,7 @@ static bool has_cpu_slab(int cpu, void *info)
 	struct kmem_cache *s = info;
 	struct kmem_cache_cpu *c = per_cpu_ptr(s->cpu_slab, cpu);
 
-	return c->page || c->partial;
+	return c->page || c->partial || !llist_empty(&c->remote_free);
 }
 
 static void flush_all(struct kmem_cache *s)
@@ -2267,6 +2271,12 @@ load_freelist:
 
 new_slab:
 
+	/* Remote frees may give us back a partial slab */
+	if (!llist_empty(&c->remote_free)) {
+		c->remote_count = 0;
+		flush_remote_frees(s, c);
+	}
+
 	if (c->partial) {
 		page = c->page = c->partial;
 		c->partial = page->next;
@@ -2442,12 +2452,15 @@ EXPORT_SYMBOL(kmem_cache_alloc_node_trace);
  * So we still attempt to reduce cache line usage. Just take the slab
  * lock and free the item. If there is no additional partial page
  * handling required then we can return immediately.
+ *
+ * Frees the @cnt objects from @head to @tail, which all belong to @page
+ * and are already linked through their free pointers. Only remote frees
+ * come in chains of more than one object, and never for debug caches.
  */
 static void __slab_free(struct kmem_cache *s, struct page *page,
-			void *x, unsigned long addr)
+			void *head, void *tail, int cnt, unsigned long addr)
 {
 	void *prior;
-	void **object = (void *)x;
 	int was_frozen;
 	int inuse;
 	struct page new;
@@ -2457,16 +2470,16 @@ static void __slab_free(struct kmem_cache *s, struct page *page,
 
 	stat(s, FREE_SLOWPATH);
 
-	if (kmem_cache_debug(s) && !free_debug_processing(s, page, x, addr))
+	if (kmem_cache_debug(s) && !free_debug_processing(s, page, head, addr))
 		return;
 
 	do {
 		prior = page->freelist;
 		counters = page->counters;
-		set_freepointer(s, object, prior);
+		set_freepointer(s, tail, prior);
 		new.counters = counters;
 		was_frozen = new.frozen;
-		new.inuse--;
+		new.inuse -= cnt;
 		if ((!new.inuse || !prior) && !was_frozen && !n) {
 
 			if (!kmem_cache_debug(s) && !prior)
@@ -2496,7 +2509,7 @@ static void __slab_free(struct kmem_cache *s, struct page *page,
 
 	} while (!cmpxchg_double_slab(s, page,
 		prior, counters,
-		object, new.counters,
+		head, new.counters,
 		"__slab_free"));
 
 	if (likely(!n)) {
@@ -2557,6 +2570,79 @@ slab_empty:
 	discard_slab(s, page);
 }
 
+/*
+ * Remote frees.
+ *
+ * An object freed to a slab other than the cpu slab costs a cmpxchg on the
+ * page struct of its slab, which typically sits in the cache of the cpu
+ * that allocated from it, and may need the list_lock. Instead we put such
+ * objects on a per cpu lockless list, linked through their free pointer,
+ * and once remote_batch of them have come together we take the whole list
+ * and give every slab all of its objects back with a single cmpxchg.
+ *
+ * Any cpu may take the list off with llist_del_all(), so it is flushed by
+ * flush_all() and when a cpu goes down like the rest of the per cpu state,
+ * and by the allocation slowpath before it looks for another slab.
+ */
+static void flush_remote_frees(struct kmem_cache *s, struct kmem_cache_cpu *c)
+{
+	struct llist_node *node, *next, *rest;
+	struct page *page;
+	void *head, *tail, *object;
+	int cnt;
+
+	node = llist_del_all(&c->remote_free);
+	if (!node)
+		return;
+	stat(s, FREE_REMOTE_FLUSH);
+
+	while (node) {
+		head = tail = (void *)node - s->offset;
+		page = virt_to_head_page(head);
+		cnt = 1;
+		rest = NULL;
+
+		/*
+		 * Chain up the other objects of this slab and keep the rest
+		 * for the next round. Debug checks are done per object.
+		 */
+		for (node = node->next; node; node = next) {
+			next = node->next;
+			object = (void *)node - s->offset;
+			if (virt_to_head_page(object) == page &&
+			    !kmem_cache_debug(s)) {
+				set_freepointer(s, tail, object);
+				tail = object;
+				cnt++;
+			} else {
+				node->next = rest;
+				rest = node;
+			}
+		}
+
+		stat(s, FREE_REMOTE_SLAB);
+		__slab_free(s, page, head, tail, cnt, _RET_IP_);
+		node = rest;
+	}
+}
+
+static void defer_remote_free(struct kmem_cache *s, void *x)
+{
+	struct kmem_cache_cpu *c;
+
+	/* A cpu going down must not have objects added after its flush */
+	preempt_disable();
+	c = this_cpu_ptr(s->cpu_slab);
+	llist_add(x + s->offset, &c->remote_free);
+	stat(s, FREE_REMOTE);
+
+	if (this_cpu_inc_return(s->cpu_slab->remote_count) >= s->remote_batch) {
+		this_cpu_write(s->cpu_slab->remote_count, 0);
+		flush_remote_frees(s, c);
+	}
+	preempt_enable();
+}
+
 /*
  * Fastpath with forced inlining to produce a kfree and kmem_cache_free that
  * can perform fastpath freeing without additional function calls.
@@ -2565,8 +2651,9 @@ slab_empty:
  * of this processor. This typically the case if we have just allocated
  * the item before.
  *
- * If fastpath is not possible then fall back to __slab_free where we deal
- * with all sorts of special processing.
+ * If fastpath is not possible then the object is collected for a batched
+ * remote free, or we fall back to __slab_free where we deal with all sorts
+ * of special processing.
  */
 static __always_inline void slab_free(struct kmem_cache *s,
 			struct page *page, void *x, unsigned long addr)
@@ -2601,8 +2688,10 @@ redo:
 			goto redo;
 		}
 		stat(s, FREE_FASTPATH);
-	} else
-		__slab_free(s, page, x, addr);
+	} else if (s->remote_batch && !kmem_cache_debug(s))
+		defer_remote_free(s, x);
+	else
+		__slab_free(s, page, x, x, 1, addr);
 
 }
 
@@ -3098,6 +3187,21 @@ static int kmem_cache_open(struct kmem_cache *s,
 	else
 		s->cpu_partial = 30;
 
+	/*
+	 * remote_batch is the number of objects freed to slabs other than the
+	 * cpu slab that a processor collects before it returns them to their
+	 * slabs. Until then they cannot be allocated, so keep fewer of the
+	 * large ones.
+	 */
+	if (kmem_cache_debug(s))
+		s->remote_batch = 0;
+	else if (s->size >= PAGE_SIZE)
+		s->remote_batch = 4;
+	else if (s->size >= 1024)
+		s->remote_batch = 8;
+	else
+		s->remote_batch = 32;
+
 	s->refcount = 1;
 #ifdef CONFIG_NUMA
 	s->remote_node_defrag_ratio = 1000;
@@ -4698,6 +4802,29 @@ static ssize_t cpu_partial_store(struct kmem_cache *s, const char *buf,
 }
 SLAB_ATTR(cpu_partial);
 
+static ssize_t remote_batch_show(struct kmem_cache *s, char *buf)
+{
+	return sprintf(buf, "%u\n", s->remote_batch);
+}
+
+static ssize_t remote_batch_store(struct kmem_cache *s, const char *buf,
+				  size_t length)
+{
+	unsigned long objects;
+	int err;
+
+	err = strict_strtoul(buf, 10, &objects);
+	if (err)
+		return err;
+	if (objects > INT_MAX || (objects && kmem_cache_debug(s)))
+		return -EINVAL;
+
+	s->remote_batch = objects;
+	flush_all(s);
+	return length;
+}
+SLAB_ATTR(remote_batch);
+
 static ssize_t ctor_show(struct kmem_cache *s, char *buf)
 {
 	if (!s->ctor)
@@ -5093,6 +5220,9 @@ STAT_ATTR(CPU_PARTIAL_ALLOC, cpu_partial_alloc);
 STAT_ATTR(CPU_PARTIAL_FREE, cpu_partial_free);
 STAT_ATTR(CPU_PARTIAL_NODE, cpu_partial_node);
 STAT_ATTR(CPU_PARTIAL_DRAIN, cpu_partial_drain);
+STAT_ATTR(FREE_REMOTE, free_remote);
+STAT_ATTR(FREE_REMOTE_FLUSH, free_remote_flush);
+STAT_ATTR(FREE_REMOTE_SLAB, free_remote_slab);
 #endif
 
 static struct attribute *slab_attrs[] = {
@@ -5102,6 +5232,7 @@ static struct attribute *slab_attrs[] = {
 	&order_attr.attr,
 	&min_partial_attr.attr,
 	&cpu_partial_attr.attr,
+	&remote_batch_attr.attr,
 	&objects_attr.attr,
 	&objects_partial_attr.attr,
 	&partial_attr.attr,
@@ -5160,6 +5291,9 @@ static struct attribute *slab_attrs[] = {
 	&cpu_partial_free_attr.attr,
 	&cpu_partial_node_attr.attr,
 	&cpu_partial_drain_attr.attr,
+	&free_remote_attr.attr,
+	&free_remote_flush_attr.attr,
+	&free_remote_slab_attr.attr,
 #endif
 #ifdef CONFIG_FAILSLAB
 	&failslab_attr.attr,
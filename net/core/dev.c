@@ -5899,6 +5899,28 @@ void netdev_stats_to_stats64(struct rtnl_link_stats64 *stats64,
 }
 EXPORT_SYMBOL(netdev_stats_to_stats64);
 
+/**
+ *	dev_fold_tstats	- add up per-cpu software device statistics
+ *	@stats64: statistics to add to
+ *	@tstats: per-cpu statistics, usually dev->tstats
+ *
+ *	Adds the packet and byte counts of all cpus to @stats64, for use in
+ *	ndo_get_stats64() of devices which keep them in a struct pcpu_tstats.
+ */
+void dev_fold_tstats(struct rtnl_link_stats64 *stats64,
+		     const struct pcpu_tstats __percpu *tstats)
+{
+	struct pcpu_tstats sum;
+
+	pcpu_stats_fold(tstats, &sum);
+
+	stats64->rx_packets += sum.rx_packets;
+	stats64->rx_bytes   += sum.rx_bytes;
+	stats64->tx_packets += sum.tx_packets;
+	stats64->tx_bytes   += sum.tx_bytes;
+}
+EXPORT_SYMBOL(dev_fold_tstats);
+
 /**
  *	dev_get_stats	- get network device statistics
  *	@dev: device to get statistics from
@@ -94,32 +94,13 @@ struct ip6_tnl_net {
 	struct ip6_tnl __rcu **tnls[2];
 };
 
-/* often modified stats are per cpu, other are shared (netdev->stats) */
-struct pcpu_tstats {
-	unsigned long	rx_packets;
-	unsigned long	rx_bytes;
-	unsigned long	tx_packets;
-	unsigned long	tx_bytes;
-} __attribute__((aligned(4*sizeof(unsigned long))));
-
-static struct net_device_stats *ip6_get_stats(struct net_device *dev)
+static struct rtnl_link_stats64 *ip6_get_stats64(struct net_device *dev,
+						 struct rtnl_link_stats64 *tot)
 {
-	struct pcpu_tstats sum = { 0 };
-	int i;
-
-	for_each_possible_cpu(i) {
-		const struct pcpu_tstats *tstats = per_cpu_ptr(dev->tstats, i);
-
-		sum.rx_packets += tstats->rx_packets;
-		sum.rx_bytes   += tstats->rx_bytes;
-		sum.tx_packets += tstats->tx_packets;
-		sum.tx_bytes   += tstats->tx_bytes;
-	}
-	dev->stats.rx_packets = sum.rx_packets;
-	dev->stats.rx_bytes   = sum.rx_bytes;
-	dev->stats.tx_packets = sum.tx_packets;
-	dev->stats.tx_bytes   = sum.tx_bytes;
-	return &dev->stats;
+	/* packets and bytes are per cpu, the rest is shared (netdev->stats) */
+	netdev_stats_to_stats64(tot, &dev->stats);
+	dev_fold_tstats(tot, dev->tstats);
+	return tot;
 }
 
 /*
@@ -787,9 +768,10 @@ static int ip6_tnl_rcv(struct sk_buff *skb, __u16 protocol,
 		skb->pkt_type = PACKET_HOST;
 		memset(skb->cb, 0, sizeof(struct inet6_skb_parm));
 
-		tstats = this_cpu_ptr(t->dev->tstats);
+		tstats = pcpu_stats_update_begin(t->dev->tstats);
 		tstats->rx_packets++;
 		tstats->rx_bytes += skb->len;
+		pcpu_stats_update_end(tstats);
 
 		__skb_tunnel_rx(skb, t->dev);
 
@@ -1009,10 +991,12 @@ static int ip6_tnl_xmit2(struct sk_buff *skb,
 	err = ip6_local_out(skb);
 
 	if (net_xmit_eval(err) == 0) {
-		struct pcpu_tstats *tstats = this_cpu_ptr(t->dev->tstats);
+		struct pcpu_tstats *tstats;
 
+		tstats = pcpu_stats_update_begin(t->dev->tstats);
 		tstats->tx_bytes += pkt_len;
 		tstats->tx_packets++;
+		pcpu_stats_update_end(tstats);
 	} else {
 		stats->tx_errors++;
 		stats->tx_aborted_errors++;
@@ -1371,7 +1355,7 @@ static const struct net_device_ops ip6_tnl_netdev_ops = {
 	.ndo_start_xmit = ip6_tnl_xmit,
 	.ndo_do_ioctl	= ip6_tnl_ioctl,
 	.ndo_change_mtu = ip6_tnl_change_mtu,
-	.ndo_get_stats	= ip6_get_stats,
+	.ndo_get_stats64 = ip6_get_stats64,
 };
 
 
@@ -49,6 +49,7 @@
 #include <linux/slab.h>
 #include <linux/sort.h>
 #include <linux/bsearch.h>
+#include <linux/ktime.h>
 
 #include <asm/processor.h>
 #include <asm/io.h>
@@ -64,6 +65,21 @@
 MODULE_AUTHOR("Qumranet");
 MODULE_LICENSE("GPL");
 
+/* Maximum time a halted vcpu polls for a wakeup before it sleeps, in ns. */
+static unsigned int halt_poll_ns = 200000;
+module_param(halt_poll_ns, uint, S_IRUGO | S_IWUSR);
+
+/* Factor by which the poll time of a vcpu grows after a short halt. */
+static unsigned int halt_poll_ns_grow = 2;
+module_param(halt_poll_ns_grow, uint, S_IRUGO | S_IWUSR);
+
+/* Divisor for the poll time after a long halt, 0 stops polling at once. */
+static unsigned int halt_poll_ns_shrink;
+module_param(halt_poll_ns_shrink, uint, S_IRUGO | S_IWUSR);
+
+/* Poll time a vcpu starts with when it grows from zero, in ns. */
+#define HALT_POLL_NS_START	10000
+
 /*
  * Ordering of locks:
  *
@@ -226,6 +242,7 @@ int kvm_vcpu_init(struct kvm_vcpu *vcpu, struct kvm *kvm, unsigned id)
 	vcpu->kvm = kvm;
 	vcpu->vcpu_id = id;
 	vcpu->pid = NULL;
+	vcpu->halt_poll_ns = 0;
 	init_waitqueue_head(&vcpu->wq);
 	kvm_async_pf_vcpu_init(vcpu);
 
@@ -1498,29 +1515,116 @@ void mark_page_dirty(struct kvm *kvm, gfn_t gfn)
 	mark_page_dirty_in_slot(kvm, memslot, gfn);
 }
 
+static void grow_halt_poll_ns(struct kvm_vcpu *vcpu)
+{
+	unsigned int old, val;
+
+	old = val = vcpu->halt_poll_ns;
+	if (!halt_poll_ns_grow)
+		return;
+	if (val == 0)
+		val = HALT_POLL_NS_START;
+	else
+		val *= halt_poll_ns_grow;
+	if (val > halt_poll_ns)
+		val = halt_poll_ns;
+
+	vcpu->halt_poll_ns = val;
+	trace_kvm_halt_poll_ns_grow(vcpu->vcpu_id, val, old);
+}
+
+static void shrink_halt_poll_ns(struct kvm_vcpu *vcpu)
+{
+	unsigned int old, val;
+
+	old = val = vcpu->halt_poll_ns;
+	if (halt_poll_ns_shrink == 0)
+		val = 0;
+	else
+		val /= halt_poll_ns_shrink;
+
+	vcpu->halt_poll_ns = val;
+	trace_kvm_halt_poll_ns_shrink(vcpu->vcpu_id, val, old);
+}
+
+/*
+ * Returns true if the vcpu has something to do, with KVM_REQ_UNHALT
+ * set if it became runnable.
+ */
+static bool kvm_vcpu_check_block(struct kvm_vcpu *vcpu)
+{
+	if (kvm_arch_vcpu_runnable(vcpu)) {
+		kvm_make_request(KVM_REQ_UNHALT, vcpu);
+		return true;
+	}
+	if (kvm_cpu_has_pending_timer(vcpu))
+		return true;
+	if (signal_pending(current))
+		return true;
+
+	return false;
+}
+
 /*
  * The vCPU has executed a HLT instruction with in-kernel mode enabled.
+ *
+ * Wakeups often come within microseconds, e.g. the reply to an RPC the
+ * guest just sent, and then sleeping costs far more than the halt
+ * itself.  So first poll for up to vcpu->halt_poll_ns, which adapts to
+ * the halts this vcpu sees: it grows while halts are shorter than the
+ * halt_poll_ns limit and shrinks after one that is longer.
  */
 void kvm_vcpu_block(struct kvm_vcpu *vcpu)
 {
+	ktime_t start, cur;
 	DEFINE_WAIT(wait);
+	bool waited = false;
+	u64 block_ns;
+
+	start = cur = ktime_get();
+	if (vcpu->halt_poll_ns) {
+		s64 stop = ktime_to_ns(start) + vcpu->halt_poll_ns;
+
+		++vcpu->stat.halt_attempted_poll;
+		do {
+			if (kvm_vcpu_check_block(vcpu)) {
+				++vcpu->stat.halt_successful_poll;
+				goto out;
+			}
+			cpu_relax();
+			cur = ktime_get();
+		} while (!need_resched() && ktime_to_ns(cur) < stop);
+	}
 
 	for (;;) {
 		prepare_to_wait(&vcpu->wq, &wait, TASK_INTERRUPTIBLE);
 
-		if (kvm_arch_vcpu_runnable(vcpu)) {
-			kvm_make_request(KVM_REQ_UNHALT, vcpu);
-			break;
-		}
-		if (kvm_cpu_has_pending_timer(vcpu))
-			break;
-		if (signal_pending(current))
+		if (kvm_vcpu_check_block(vcpu))
 			break;
 
+		waited = true;
 		schedule();
 	}
 
 	finish_wait(&vcpu->wq, &wait);
+	cur = ktime_get();
+
+out:
+	block_ns = ktime_to_ns(cur) - ktime_to_ns(start);
+
+	if (!halt_poll_ns || vcpu->halt_poll_ns > halt_poll_ns) {
+		/* the limit was lowered */
+		vcpu->halt_poll_ns = halt_poll_ns;
+	} else if (block_ns > halt_poll_ns) {
+		/* a long halt, polling only burns cpu */
+		if (vcpu->halt_poll_ns)
+			shrink_halt_poll_ns(vcpu);
+	} else if (block_ns > vcpu->halt_poll_ns) {
+		/* a short halt that polling a little longer would have caught */
+		grow_halt_poll_ns(vcpu);
+	}
+
+	trace_kvm_vcpu_wakeup(block_ns, waited);
 }
 
 #ifndef CONFIG_S390